@@ -0,0 +1,52 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include <silkworm/silkrpc/test/allocation_count.hpp>
+
+// Count the global allocations of each thread, in order to measure the ones saved by frame recycling. Replacing the global
+// operator new affects the whole executable, so the allocation tests are built apart from the unit tests
+static thread_local uint64_t thread_allocation_count{0};
+
+void* operator new(std::size_t size) {
+    ++thread_allocation_count;
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept {
+    std::free(pointer);
+}
+
+namespace silkrpc::test {
+
+uint64_t allocation_count() {
+    return thread_allocation_count;
+}
+
+} // namespace silkrpc::test
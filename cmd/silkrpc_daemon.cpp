@@ -43,6 +43,26 @@ ABSL_FLAG(silkrpc::LogLevel, log_verbosity, silkrpc::LogLevel::Critical, "loggin
 ABSL_FLAG(silkrpc::WaitMode, wait_mode, silkrpc::WaitMode::blocking, "scheduler wait mode");
 ABSL_FLAG(std::string, jwt_secret_file, silkrpc::kDefaultJwtFilename, "Token file to ensure safe connection between CL and EL");
 ABSL_FLAG(std::string, datadir, silkrpc::kDefaultDataDir, "DB Path");
+ABSL_FLAG(uint32_t, logs_parallelism, silkrpc::kDefaultLogsParallelism, "number of concurrent block lanes scanned by one logs request as 32-bit integer");
+ABSL_FLAG(uint64_t, logs_block_budget, silkrpc::kDefaultLogsBlockBudget, "max number of blocks scanned by one logs request as 64-bit integer (0 means unlimited)");
+ABSL_FLAG(uint32_t, light_concurrency, silkrpc::kDefaultLightConcurrency, "max number of concurrent light requests as 32-bit integer (0 means unlimited)");
+ABSL_FLAG(uint32_t, evm_concurrency, silkrpc::kDefaultEvmConcurrency, "max number of concurrent EVM requests (e.g. eth_call) as 32-bit integer (0 means unlimited)");
+ABSL_FLAG(uint32_t, trace_concurrency, silkrpc::kDefaultTraceConcurrency, "max number of concurrent trace/debug requests as 32-bit integer (0 means unlimited)");
+ABSL_FLAG(uint64_t, engine_latency_slo, silkrpc::kDefaultEngineLatencySlo, "target latency of Engine API calls in milliseconds as 64-bit integer");
+ABSL_FLAG(uint32_t, max_connections, silkrpc::kDefaultMaxConnections, "max number of open connections as 32-bit integer (0 means unlimited)");
+ABSL_FLAG(uint32_t, max_connections_per_ip, silkrpc::kDefaultMaxConnectionsPerIp, "max number of open connections from the same address as 32-bit integer (0 means unlimited)");
+ABSL_FLAG(uint32_t, max_in_flight_requests, silkrpc::kDefaultMaxInFlightRequests, "max number of requests in flight per I/O context before shedding heavy requests as 32-bit integer (0 means unlimited)");
+ABSL_FLAG(uint32_t, max_queued_requests, silkrpc::kDefaultMaxQueuedRequests, "max number of requests waiting for execution before shedding heavy requests as 32-bit integer (0 means unlimited)");
+ABSL_FLAG(uint64_t, max_resident_memory, silkrpc::kDefaultMaxResidentMemory, "max resident memory in MiB before shedding heavy requests as 64-bit integer (0 means unlimited)");
+ABSL_FLAG(uint32_t, request_timeout, 0, "deadline of the requests in milliseconds as 32-bit integer (0 means none)");
+ABSL_FLAG(std::string, method_timeouts, "", "deadlines of the requests by method as comma-separated list of <method>:<milliseconds>");
+ABSL_FLAG(bool, dispatch_requests, true, "run each request on the least-loaded I/O context instead of the one of its connection");
+ABSL_FLAG(std::string, context_cpus, "", "CPUs to pin the I/O contexts to in round-robin as comma-separated list of <cpu> or <cpu>-<cpu> (empty means no pinning)");
+ABSL_FLAG(bool, pair_context_cpus, false, "pin each I/O context to two consecutive CPUs of context_cpus, one for its gRPC completion queue");
+ABSL_FLAG(std::string, worker_cpus, "", "CPUs to pin the worker threads to in round-robin as comma-separated list of <cpu> or <cpu>-<cpu> (empty means no pinning)");
+ABSL_FLAG(uint64_t, logs_tip_window, silkrpc::kDefaultLogsTipWindow, "number of most recent blocks whose logs are indexed in memory as 64-bit integer (0 means disabled)");
+ABSL_FLAG(uint64_t, state_checkpoint_cache_size, silkrpc::state::kDefaultStateCheckpointCacheSize, "max size in MiB of the intra-block state checkpoints cached for transaction tracing as 64-bit integer (0 means disabled)");
+ABSL_FLAG(uint64_t, index_chunk_cache_size, silkrpc::ethdb::bitmap::kDefaultChunkCacheCapacity, "max number of decoded index and history bitmap chunks cached for each table kind as 64-bit integer (0 means disabled)");
 
 //! Assemble the application version using the Cable build information
 std::string get_version_from_build_info() {
@@ -109,6 +129,26 @@ silkrpc::DaemonSettings parse_args(int argc, char* argv[]) {
         absl::GetFlag(FLAGS_log_verbosity),
         absl::GetFlag(FLAGS_wait_mode),
         absl::GetFlag(FLAGS_jwt_secret_file),
+        absl::GetFlag(FLAGS_logs_parallelism),
+        absl::GetFlag(FLAGS_logs_block_budget),
+        absl::GetFlag(FLAGS_logs_tip_window),
+        absl::GetFlag(FLAGS_state_checkpoint_cache_size),
+        absl::GetFlag(FLAGS_index_chunk_cache_size),
+        absl::GetFlag(FLAGS_light_concurrency),
+        absl::GetFlag(FLAGS_evm_concurrency),
+        absl::GetFlag(FLAGS_trace_concurrency),
+        absl::GetFlag(FLAGS_engine_latency_slo),
+        absl::GetFlag(FLAGS_max_connections),
+        absl::GetFlag(FLAGS_max_connections_per_ip),
+        absl::GetFlag(FLAGS_max_in_flight_requests),
+        absl::GetFlag(FLAGS_max_queued_requests),
+        absl::GetFlag(FLAGS_max_resident_memory),
+        absl::GetFlag(FLAGS_request_timeout),
+        absl::GetFlag(FLAGS_method_timeouts),
+        absl::GetFlag(FLAGS_dispatch_requests),
+        absl::GetFlag(FLAGS_context_cpus),
+        absl::GetFlag(FLAGS_pair_context_cpus),
+        absl::GetFlag(FLAGS_worker_cpus),
     };
 
     return rpc_daemon_settings;
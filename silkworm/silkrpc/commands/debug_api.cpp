@@ -293,14 +293,14 @@ boost::asio::awaitable<void> DebugRpcApi::handle_debug_trace_transaction(const n
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
-        const auto tx_with_block = co_await core::read_transaction_by_hash(*context_.block_cache(), tx_database, transaction_hash);
+        const auto tx_with_block = co_await core::read_transaction_by_hash(*context_.block_cache(), tx_database, transaction_hash, &workers_);
         if (!tx_with_block) {
             std::ostringstream oss;
             oss << "transaction 0x" << transaction_hash << " not found";
             const Error error{-32000, oss.str()};
             stream.write_field("error", error);
         } else {
-            debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config};
+            debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config, context_.state_checkpoint_cache().get()};
 
             stream.write_field("result");
             stream.open_object();
@@ -358,7 +358,7 @@ boost::asio::awaitable<void> DebugRpcApi::handle_debug_trace_call(const nlohmann
         ethdb::TransactionDatabase tx_database{*tx};
         ethdb::kv::CachedDatabase cached_database{block_number_or_hash, *tx, *context_.state_cache()};
 
-        const auto block_with_hash = co_await core::read_block_by_number_or_hash(*context_.block_cache(), tx_database, block_number_or_hash);
+        const auto block_with_hash = co_await core::read_block_by_number_or_hash(*context_.block_cache(), tx_database, block_number_or_hash, &workers_);
         const bool is_latest_block = co_await core::is_latest_block_number(block_with_hash.block.header.number, tx_database);
         core::rawdb::DatabaseReader& db_reader = is_latest_block ? (core::rawdb::DatabaseReader&)cached_database : (core::rawdb::DatabaseReader&)tx_database;
         debug::DebugExecutor executor{*context_.io_context(), db_reader, workers_, config};
@@ -421,7 +421,7 @@ boost::asio::awaitable<void> DebugRpcApi::handle_debug_trace_block_by_number(con
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
+        const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number, &workers_);
 
         debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config};
 
@@ -483,7 +483,7 @@ boost::asio::awaitable<void> DebugRpcApi::handle_debug_trace_block_by_hash(const
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        const auto block_with_hash = co_await core::read_block_by_hash(*context_.block_cache(), tx_database, block_hash);
+        const auto block_with_hash = co_await core::read_block_by_hash(*context_.block_cache(), tx_database, block_hash, &workers_);
 
         debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config};
 
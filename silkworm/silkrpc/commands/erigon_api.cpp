@@ -39,12 +39,13 @@
 
 namespace silkrpc::commands {
 
-ErigonRpcApi::ErigonRpcApi(Context& context)
+ErigonRpcApi::ErigonRpcApi(Context& context, boost::asio::thread_pool& workers)
     : database_(context.database()),
       backend_(context.backend()),
       context_(context),
       block_cache_(context.block_cache()),
-      state_cache_(context.state_cache()) {}
+      state_cache_(context.state_cache()),
+      workers_{workers} {}
 
 // https://eth.wiki/json-rpc/API#erigon_getBlockByTimestamp
 boost::asio::awaitable<void> ErigonRpcApi::handle_erigon_get_block_by_timestamp(const nlohmann::json& request, nlohmann::json& reply) {
@@ -97,9 +98,12 @@ boost::asio::awaitable<void> ErigonRpcApi::handle_erigon_get_block_by_timestamp(
         }
 
         // Lookup and return the matching block
-        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number);
+        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number, &workers_);
         const auto total_difficulty = co_await core::rawdb::read_total_difficulty(tx_database, block_with_hash.hash, block_number);
-        const Block extended_block{block_with_hash, total_difficulty, full_tx};
+        Block extended_block{block_with_hash, total_difficulty, full_tx};
+        if (!full_tx) {
+            extended_block.transaction_hashes = block_cache_->transaction_hashes(block_with_hash);
+        }
 
         reply = make_json_content(request["id"], extended_block);
     } catch (const std::exception& e) {
@@ -189,43 +193,52 @@ boost::asio::awaitable<void> ErigonRpcApi::handle_erigon_get_header_by_number(co
 }
 
 // https://eth.wiki/json-rpc/API#erigon_getlogsbyhash
-boost::asio::awaitable<void> ErigonRpcApi::handle_erigon_get_logs_by_hash(const nlohmann::json& request, nlohmann::json& reply) {
+boost::asio::awaitable<void> ErigonRpcApi::handle_erigon_get_logs_by_hash(const nlohmann::json& request, json::Stream& stream) {
     auto params = request["params"];
     if (params.size() != 1) {
-        auto error_msg = "invalid erigon_getHeaderByHash params: " + params.dump();
+        auto error_msg = "invalid erigon_getLogsByHash params: " + params.dump();
         SILKRPC_ERROR << error_msg << "\n";
-        reply = make_json_error(request["id"], 100, error_msg);
+        const auto reply = make_json_error(request["id"], 100, error_msg);
+        stream.write_json(reply);
         co_return;
     }
     const auto block_hash = params[0].get<evmc::bytes32>();
     SILKRPC_DEBUG << "block_hash: " << block_hash << "\n";
 
+    stream.open_object();
+    stream.write_field("id", request["id"]);
+    stream.write_field("jsonrpc", "2.0");
+
     auto tx = co_await database_->begin();
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash);
-        const auto receipts{co_await core::get_receipts(tx_database, block_with_hash)};
-
+        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash, &workers_);
+        core::ReceiptsGenerator receipts_generator{*context_.io_context(), workers_};
+        const auto receipts{co_await core::get_receipts(tx_database, block_with_hash, block_cache_.get(), context_.receipts_cache().get(), &receipts_generator)};
         SILKRPC_DEBUG << "receipts.size(): " << receipts.size() << "\n";
-        std::vector<Logs> logs{};
-        logs.reserve(receipts.size());
-        for (const auto receipt : receipts) {
+
+        // Logs are written receipt by receipt instead of being copied into a reply document first
+        stream.write_field("result");
+        stream.open_array();
+        for (const auto& receipt : receipts) {
             SILKRPC_DEBUG << "receipt.logs.size(): " << receipt.logs.size() << "\n";
-            logs.push_back(receipt.logs);
+            stream.write_json(receipt.logs);
         }
-        SILKRPC_DEBUG << "logs.size(): " << logs.size() << "\n";
-
-        reply = make_json_content(request["id"], logs);
+        stream.close_array();
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
-        reply = make_json_error(request["id"], 100, e.what());
+        const Error error{100, e.what()};
+        stream.write_field("error", error);
     } catch (...) {
         SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
-        reply = make_json_error(request["id"], 100, "unexpected exception");
+        const Error error{100, "unexpected exception"};
+        stream.write_field("error", error);
     }
 
+    stream.close_object();
+
     co_await tx->close(); // RAII not (yet) available with coroutines
     co_return;
 }
@@ -303,7 +316,8 @@ boost::asio::awaitable<void> ErigonRpcApi::handle_erigon_watch_the_burn(const nl
             issuance.total_burnt = "0x" + intx::hex(total_burnt);
             intx::uint256 tips = 0;
             if (block_with_hash.block.header.base_fee_per_gas) {
-               const auto receipts{co_await core::get_receipts(tx_database, block_with_hash)};
+               core::ReceiptsGenerator receipts_generator{*context_.io_context(), workers_};
+               const auto receipts{co_await core::get_receipts(tx_database, block_with_hash, block_cache_.get(), context_.receipts_cache().get(), &receipts_generator)};
                const auto block{block_with_hash.block};
                for (size_t i{0}; i < block.transactions.size(); i++) {
                   auto tip = block.transactions[i].effective_gas_price(block.header.base_fee_per_gas.value_or(0));
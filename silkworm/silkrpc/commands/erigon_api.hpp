@@ -21,10 +21,12 @@
 #include <silkworm/silkrpc/config.hpp> // NOLINT(build/include_order)
 
 #include <boost/asio/awaitable.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <nlohmann/json.hpp>
 
 #include <silkworm/silkrpc/concurrency/context_pool.hpp>
 #include <silkworm/silkrpc/core/rawdb/accessors.hpp>
+#include <silkworm/silkrpc/json/stream.hpp>
 #include <silkworm/silkrpc/json/types.hpp>
 #include <silkworm/silkrpc/ethdb/database.hpp>
 #include <silkworm/silkrpc/ethdb/kv/state_cache.hpp>
@@ -35,7 +37,7 @@ namespace silkrpc::commands {
 
 class ErigonRpcApi {
 public:
-    explicit ErigonRpcApi(Context& context);
+    explicit ErigonRpcApi(Context& context, boost::asio::thread_pool& workers);
     virtual ~ErigonRpcApi() {}
 
     ErigonRpcApi(const ErigonRpcApi&) = delete;
@@ -46,7 +48,7 @@ protected:
     boost::asio::awaitable<void> handle_erigon_get_block_by_timestamp(const nlohmann::json& request, nlohmann::json& reply);
     boost::asio::awaitable<void> handle_erigon_get_header_by_hash(const nlohmann::json& request, nlohmann::json& reply);
     boost::asio::awaitable<void> handle_erigon_get_header_by_number(const nlohmann::json& request, nlohmann::json& reply);
-    boost::asio::awaitable<void> handle_erigon_get_logs_by_hash(const nlohmann::json& request, nlohmann::json& reply);
+    boost::asio::awaitable<void> handle_erigon_get_logs_by_hash(const nlohmann::json& request, json::Stream& stream);
     boost::asio::awaitable<void> handle_erigon_forks(const nlohmann::json& request, nlohmann::json& reply);
     boost::asio::awaitable<void> handle_erigon_watch_the_burn(const nlohmann::json& request, nlohmann::json& reply);
     boost::asio::awaitable<void> handle_erigon_cumulative_chain_traffic(const nlohmann::json& request, nlohmann::json& reply);
@@ -58,6 +60,7 @@ private:
     std::shared_ptr<BlockCache>& block_cache_;
     std::shared_ptr<ethdb::kv::StateCache>& state_cache_;
     std::unique_ptr<ethdb::Database>& database_;
+    boost::asio::thread_pool& workers_;
 
     friend class silkrpc::http::RequestHandler;
 };
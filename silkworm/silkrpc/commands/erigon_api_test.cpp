@@ -19,6 +19,7 @@
 #include <catch2/catch.hpp>
 #include <nlohmann/json.hpp>
 #include <silkworm/silkrpc/test/api_test_base.hpp>
+#include <silkworm/silkrpc/types/writer.hpp>
 
 namespace silkrpc::commands {
 
@@ -27,8 +28,12 @@ using Catch::Matchers::Message;
 //! Utility class to expose handle hooks publicly just for tests
 class ErigonRpcApi_ForTest : public ErigonRpcApi {
   public:
-    explicit ErigonRpcApi_ForTest(Context& context) : ErigonRpcApi{context} {}
+    explicit ErigonRpcApi_ForTest(Context& context) : ErigonRpcApi{context, workers()} {}
 
+    static boost::asio::thread_pool& workers() {
+        static boost::asio::thread_pool workers{1};
+        return workers;
+    }
 
     // MSVC doesn't support using access declarations properly, so explicitly forward these public accessors
     boost::asio::awaitable<void> handle_erigon_get_block_by_timestamp(const nlohmann::json& request,
@@ -43,8 +48,8 @@ class ErigonRpcApi_ForTest : public ErigonRpcApi {
                                                                     nlohmann::json& reply) {
         co_return co_await ErigonRpcApi::handle_erigon_get_header_by_number(request, reply);
     }
-    boost::asio::awaitable<void> handle_erigon_get_logs_by_hash(const nlohmann::json& request, nlohmann::json& reply) {
-        co_return co_await ErigonRpcApi::handle_erigon_get_logs_by_hash(request, reply);
+    boost::asio::awaitable<void> handle_erigon_get_logs_by_hash(const nlohmann::json& request, json::Stream& stream) {
+        co_return co_await ErigonRpcApi::handle_erigon_get_logs_by_hash(request, stream);
     }
     boost::asio::awaitable<void> handle_erigon_forks(const nlohmann::json& request, nlohmann::json& reply) {
         co_return co_await ErigonRpcApi::handle_erigon_forks(request, reply);
@@ -141,6 +146,26 @@ TEST_CASE_METHOD(ErigonRpcApiTest, "ErigonRpcApi::handle_erigon_get_header_by_ha
     }
 }
 
+TEST_CASE_METHOD(ErigonRpcApiTest, "ErigonRpcApi::handle_erigon_get_logs_by_hash", "[silkrpc][erigon_api]") {
+    StringWriter writer;
+    json::Stream stream{writer};
+
+    SECTION("request params is empty: return error") {
+        CHECK_NOTHROW(run<&ErigonRpcApi_ForTest::handle_erigon_get_logs_by_hash>(R"({
+            "jsonrpc":"2.0",
+            "id":1,
+            "method":"erigon_getLogsByHash",
+            "params":[]
+        })"_json, stream));
+        stream.close();
+        CHECK(nlohmann::json::parse(writer.get_content()) == R"({
+            "jsonrpc":"2.0",
+            "id":1,
+            "error":{"code":100,"message":"invalid erigon_getLogsByHash params: []"}
+        })"_json);
+    }
+}
+
 TEST_CASE_METHOD(ErigonRpcApiTest, "ErigonRpcApi::handle_erigon_watch_the_burn", "[silkrpc][erigon_api]") {
     nlohmann::json reply;
 
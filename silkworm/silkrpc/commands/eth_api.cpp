@@ -20,6 +20,7 @@
 #include <cstring>
 #include <exception>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <string>
@@ -40,11 +41,15 @@
 #include <silkworm/silkrpc/common/log.hpp>
 #include <silkworm/silkrpc/common/util.hpp>
 #include <silkworm/silkrpc/core/cached_chain.hpp>
+#include <silkworm/silkrpc/core/cached_state.hpp>
 #include <silkworm/silkrpc/core/blocks.hpp>
 #include <silkworm/silkrpc/core/evm_executor.hpp>
 #include <silkworm/silkrpc/core/evm_access_list_tracer.hpp>
 #include <silkworm/silkrpc/core/estimate_gas_oracle.hpp>
+#include <silkworm/silkrpc/core/fee_history_oracle.hpp>
+#include <silkworm/silkrpc/core/filter_registry.hpp>
 #include <silkworm/silkrpc/core/gas_price_oracle.hpp>
+#include <silkworm/silkrpc/core/logs_extractor.hpp>
 #include <silkworm/silkrpc/core/rawdb/chain.hpp>
 #include <silkworm/silkrpc/core/receipts.hpp>
 #include <silkworm/silkrpc/core/remote_state.hpp>
@@ -165,10 +170,10 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_gas_price(const nlohmann
         SILKRPC_INFO << "block_number " << block_number << "\n";
 
         BlockProvider block_provider = [this, &tx_database](uint64_t block_number) {
-            return core::read_block_by_number(*block_cache_, tx_database, block_number);
+            return core::read_block_by_number(*block_cache_, tx_database, block_number, &workers_);
         };
 
-        GasPriceOracle gas_price_oracle{ block_provider};
+        GasPriceOracle gas_price_oracle{block_provider, context_.gas_price_window().get()};
         auto gas_price = co_await gas_price_oracle.suggested_price(block_number);
 
         const auto block_with_hash = co_await block_provider(block_number);
@@ -187,6 +192,97 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_gas_price(const nlohmann
     co_return;
 }
 
+// https://geth.ethereum.org/docs/rpc/ns-eth#eth_maxpriorityfeepergas
+boost::asio::awaitable<void> EthereumRpcApi::handle_eth_max_priority_fee_per_gas(const nlohmann::json& request, nlohmann::json& reply) {
+    auto tx = co_await database_->begin();
+
+    try {
+        ethdb::TransactionDatabase tx_database{*tx};
+        const auto block_number = co_await core::get_block_number(core::kLatestBlockId, tx_database);
+        SILKRPC_INFO << "block_number " << block_number << "\n";
+
+        BlockProvider block_provider = [this, &tx_database](uint64_t block_number) {
+            return core::read_block_by_number(*block_cache_, tx_database, block_number, &workers_);
+        };
+
+        GasPriceOracle gas_price_oracle{block_provider, context_.gas_price_window().get()};
+        const auto priority_fee = co_await gas_price_oracle.suggested_price(block_number);
+        reply = make_json_content(request["id"], to_quantity(priority_fee));
+    } catch (const std::exception& e) {
+        SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
+        reply = make_json_error(request["id"], 100, e.what());
+    } catch (...) {
+        SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
+        reply = make_json_error(request["id"], 100, "unexpected exception");
+    }
+
+    co_await tx->close(); // RAII not (yet) available with coroutines
+    co_return;
+}
+
+// https://geth.ethereum.org/docs/rpc/ns-eth#eth_feehistory
+boost::asio::awaitable<void> EthereumRpcApi::handle_eth_fee_history(const nlohmann::json& request, nlohmann::json& reply) {
+    auto params = request["params"];
+    if (params.size() < 2 || params.size() > 3) {
+        auto error_msg = "invalid eth_feeHistory params: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        reply = make_json_error(request["id"], 100, error_msg);
+        co_return;
+    }
+    const auto block_count = params[0].is_string() ? std::stoull(params[0].get<std::string>(), 0, 16) : params[0].get<uint64_t>();
+    const auto newest_block_id = params[1].get<std::string>();
+    const auto reward_percentiles = params.size() == 3 ? params[2].get<std::vector<double>>() : std::vector<double>{};
+    SILKRPC_DEBUG << "block_count: " << block_count << " newest_block_id: " << newest_block_id << " #percentiles: " << reward_percentiles.size() << "\n";
+
+    auto tx = co_await database_->begin();
+
+    try {
+        ethdb::TransactionDatabase tx_database{*tx};
+        const auto newest_block = co_await core::get_block_number(newest_block_id, tx_database);
+
+        BlockProvider block_provider = [this, &tx_database](uint64_t block_number) {
+            return core::read_block_by_number(*block_cache_, tx_database, block_number, &workers_);
+        };
+
+        // Each lane of cold blocks uses its own transaction because one transaction cannot serve concurrent reads
+        BlockFeesLoader fees_loader = [this](std::vector<uint64_t> block_numbers) -> boost::asio::awaitable<std::vector<BlockFees>> {
+            core::ReceiptsGenerator receipts_generator{*context_.io_context(), workers_};
+            std::vector<BlockFees> block_fees;
+            block_fees.reserve(block_numbers.size());
+            auto lane_tx = co_await database_->begin();
+            std::exception_ptr eptr;
+            try {
+                ethdb::TransactionDatabase lane_database{*lane_tx};
+                for (const auto block_number : block_numbers) {
+                    const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, lane_database, block_number, &workers_);
+                    const auto receipts = co_await core::get_receipts(lane_database, block_with_hash, block_cache_.get(), nullptr, &receipts_generator);
+                    block_fees.push_back(make_block_fees(block_with_hash, receipts));
+                }
+            } catch (...) {
+                eptr = std::current_exception();
+            }
+            co_await lane_tx->close(); // RAII not (yet) available with coroutines
+            if (eptr) {
+                std::rethrow_exception(eptr);
+            }
+            co_return block_fees;
+        };
+
+        FeeHistoryOracle fee_history_oracle{block_provider, fees_loader, context_.fee_history_cache().get()};
+        const auto fee_history = co_await fee_history_oracle.fee_history(newest_block, block_count, reward_percentiles);
+        reply = make_json_content(request["id"], fee_history);
+    } catch (const std::exception& e) {
+        SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
+        reply = make_json_error(request["id"], 100, e.what());
+    } catch (...) {
+        SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
+        reply = make_json_error(request["id"], 100, "unexpected exception");
+    }
+
+    co_await tx->close(); // RAII not (yet) available with coroutines
+    co_return;
+}
+
 // https://eth.wiki/json-rpc/API#eth_getblockbyhash
 boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_block_by_hash(const nlohmann::json& request, nlohmann::json& reply) {
     auto params = request["params"];
@@ -205,10 +301,13 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_block_by_hash(const
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash);
+        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash, &workers_);
         const auto block_number = block_with_hash.block.header.number;
         const auto total_difficulty = co_await core::rawdb::read_total_difficulty(tx_database, block_hash, block_number);
-        const Block extended_block{block_with_hash, total_difficulty, full_tx};
+        Block extended_block{block_with_hash, total_difficulty, full_tx};
+        if (!full_tx) {
+            extended_block.transaction_hashes = block_cache_->transaction_hashes(block_with_hash);
+        }
 
         reply = make_json_content(request["id"], extended_block);
     } catch (const std::invalid_argument& iv) {
@@ -245,9 +344,12 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_block_by_number(cons
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
-        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number);
+        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number, &workers_);
         const auto total_difficulty = co_await core::rawdb::read_total_difficulty(tx_database, block_with_hash.hash, block_number);
-        const Block extended_block{block_with_hash, total_difficulty, full_tx};
+        Block extended_block{block_with_hash, total_difficulty, full_tx};
+        if (!full_tx) {
+            extended_block.transaction_hashes = block_cache_->transaction_hashes(block_with_hash);
+        }
 
         reply = make_json_content(request["id"], extended_block);
     } catch (const std::invalid_argument& iv) {
@@ -282,7 +384,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_block_transaction_co
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash);
+        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash, &workers_);
         const auto tx_count = block_with_hash.block.transactions.size();
 
         reply = make_json_content(request["id"], to_quantity(tx_count));
@@ -316,7 +418,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_block_transaction_co
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
-        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number);
+        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number, &workers_);
 
         reply = make_json_content(request["id"], to_quantity(block_with_hash.block.transactions.size()));
     } catch (const std::exception& e) {
@@ -349,7 +451,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_uncle_by_block_hash_
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash);
+        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash, &workers_);
         const auto ommers = block_with_hash.block.ommers;
 
         const auto idx = std::stoul(index, 0, 16);
@@ -397,7 +499,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_uncle_by_block_numbe
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
-        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number);
+        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number, &workers_);
         const auto ommers = block_with_hash.block.ommers;
 
         const auto idx = std::stoul(index, 0, 16);
@@ -442,7 +544,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_uncle_count_by_block
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash);
+        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash, &workers_);
         const auto ommers = block_with_hash.block.ommers;
 
         reply = make_json_content(request["id"], to_quantity(ommers.size()));
@@ -476,7 +578,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_uncle_count_by_block
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
-        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number);
+        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number, &workers_);
         const auto ommers = block_with_hash.block.ommers;
 
         reply = make_json_content(request["id"], to_quantity(ommers.size()));
@@ -508,7 +610,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_transaction_by_hash(
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
-        const auto tx_with_block = co_await core::read_transaction_by_hash(*block_cache_, tx_database, transaction_hash);
+        const auto tx_with_block = co_await core::read_transaction_by_hash(*block_cache_, tx_database, transaction_hash, &workers_);
         if (!tx_with_block) {
             const auto tx_rlp_buffer = co_await tx_pool_->get_transaction(transaction_hash);
             if (tx_rlp_buffer) {
@@ -562,7 +664,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_raw_transaction_by_h
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
-        const auto tx_with_block = co_await core::read_transaction_by_hash(*block_cache_, tx_database, transaction_hash);
+        const auto tx_with_block = co_await core::read_transaction_by_hash(*block_cache_, tx_database, transaction_hash, &workers_);
         if (!tx_with_block) {
             const auto tx_rlp_buffer = co_await tx_pool_->get_transaction(transaction_hash);
             if (tx_rlp_buffer) {
@@ -611,7 +713,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_transaction_by_block
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash);
+        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash, &workers_);
         const auto transactions = block_with_hash.block.transactions;
 
         const auto idx = std::stoul(index, 0, 16);
@@ -653,7 +755,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_raw_transaction_by_b
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash);
+        const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash, &workers_);
         const auto transactions = block_with_hash.block.transactions;
 
         const auto idx = std::stoul(index, 0, 16);
@@ -700,7 +802,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_transaction_by_block
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
-        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number);
+        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number, &workers_);
         const auto transactions = block_with_hash.block.transactions;
 
         const auto idx = std::stoul(index, 0, 16);
@@ -743,7 +845,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_raw_transaction_by_b
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
-        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number);
+        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number, &workers_);
         const auto transactions = block_with_hash.block.transactions;
 
         const auto idx = std::stoul(index, 0, 16);
@@ -787,19 +889,18 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_transaction_receipt(
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        const auto block_with_hash = co_await core::read_block_by_transaction_hash(*block_cache_, tx_database, transaction_hash);
-        auto receipts = co_await core::get_receipts(tx_database, block_with_hash);
-        auto transactions = block_with_hash.block.transactions;
+        const auto block_with_hash = co_await core::read_block_by_transaction_hash(*block_cache_, tx_database, transaction_hash, &workers_);
+        core::ReceiptsGenerator receipts_generator{*context_.io_context(), workers_};
+        auto receipts = co_await core::get_receipts(tx_database, block_with_hash, block_cache_.get(), context_.receipts_cache().get(), &receipts_generator);
+        const auto& transactions = block_with_hash.block.transactions;
         if (receipts.size() != transactions.size()) {
             throw std::invalid_argument{"Unexpected size for receipts in handle_eth_get_transaction_receipt"};
         }
 
         size_t tx_index = -1;
         for (size_t idx{0}; idx < transactions.size(); idx++) {
-            auto ethash_hash{hash_of_transaction(transactions[idx])};
-
-            SILKRPC_TRACE << "tx " << idx << ") hash: " << silkworm::to_bytes32({ethash_hash.bytes, silkworm::kHashLength}) << "\n";
-            if (std::memcmp(transaction_hash.bytes, ethash_hash.bytes, silkworm::kHashLength) == 0) {
+            SILKRPC_TRACE << "tx " << idx << ") hash: " << receipts[idx].tx_hash << "\n";
+            if (receipts[idx].tx_hash == transaction_hash) {
                 tx_index = idx;
                 const intx::uint256 base_fee_per_gas{block_with_hash.block.header.base_fee_per_gas.value_or(0)};
                 const intx::uint256 effective_gas_price{transactions[idx].max_fee_per_gas >= base_fee_per_gas ? transactions[idx].effective_gas_price(base_fee_per_gas)
@@ -851,16 +952,16 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_estimate_gas(const nlohm
         const auto latest_block_number = co_await core::get_block_number(core::kLatestBlockId, tx_database);
         SILKRPC_DEBUG << "chain_id: " << chain_id << ", latest_block_number: " << latest_block_number << "\n";
 
-        const auto latest_block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, latest_block_number);
+        const auto latest_block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, latest_block_number, &workers_);
         const auto latest_block = latest_block_with_hash.block;
         StateReader state_reader(cached_database);
         state::RemoteState remote_state{*context_.io_context(), cached_database, latest_block.header.number};
+        state::CachedState shared_state{remote_state};
 
-        Tracers tracers;
-        EVMExecutor evm_executor{*context_.io_context(), cached_database, *chain_config_ptr, workers_, latest_block.header.number, remote_state};
-
-        ego::Executor executor = [&latest_block, &evm_executor, &tracers](const silkworm::Transaction &transaction) {
-            return evm_executor.call(latest_block, transaction, tracers);
+        // Each probe gets its own executor so that the oracle can run them concurrently on the shared warmed state
+        ego::Executor executor = [&](const silkworm::Transaction &transaction) -> boost::asio::awaitable<ExecutionResult> {
+            EVMExecutor evm_executor{*context_.io_context(), cached_database, *chain_config_ptr, workers_, latest_block.header.number, shared_state};
+            co_return co_await evm_executor.call(latest_block, transaction);
         };
 
         ego::BlockHeaderProvider block_header_provider = [&cached_database](uint64_t block_number) {
@@ -1083,7 +1184,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_call(const nlohmann::jso
                                         is_latest_block ? (core::rawdb::DatabaseReader&)cached_database : (core::rawdb::DatabaseReader&)tx_database,
                                         block_number};
         EVMExecutor executor{*context_.io_context(), tx_database, *chain_config_ptr, workers_, block_number, remote_state};
-        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number);
+        const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number, &workers_);
         silkworm::Transaction txn{call.to_transaction()};
         const auto execution_result = co_await executor.call(block_with_hash.block, txn);
 
@@ -1131,7 +1232,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_create_access_list(const
         ethdb::TransactionDatabase tx_database{*tx};
         ethdb::kv::CachedDatabase cached_database{block_number_or_hash, *tx, *state_cache_};
 
-        const auto block_with_hash = co_await core::read_block_by_number_or_hash(*block_cache_, tx_database, block_number_or_hash);
+        const auto block_with_hash = co_await core::read_block_by_number_or_hash(*block_cache_, tx_database, block_number_or_hash, &workers_);
         const auto chain_id = co_await core::rawdb::read_chain_id(tx_database);
         const auto chain_config_ptr = lookup_chain_config(chain_id);
 
@@ -1232,7 +1333,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_call_bundle(const nlohma
         ethdb::kv::CachedDatabase tx_database{block_number_or_hash, *tx, *state_cache_};
         ethdb::kv::CachedDatabase cached_database{block_number_or_hash, *tx, *state_cache_};
 
-        const auto block_with_hash = co_await core::read_block_by_number_or_hash(*block_cache_, tx_database, block_number_or_hash);
+        const auto block_with_hash = co_await core::read_block_by_number_or_hash(*block_cache_, tx_database, block_number_or_hash, &workers_);
         const auto chain_id = co_await core::rawdb::read_chain_id(tx_database);
         const auto chain_config_ptr = lookup_chain_config(chain_id);
 
@@ -1250,7 +1351,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_call_bundle(const nlohma
 
         for (int i = 0; i < tx_hash_list.size(); i++) {
             struct CallBundleTxInfo tx_info{};
-            const auto tx_with_block = co_await core::read_transaction_by_hash(*block_cache_, tx_database, tx_hash_list[i]);
+            const auto tx_with_block = co_await core::read_transaction_by_hash(*block_cache_, tx_database, tx_hash_list[i], &workers_);
             if (!tx_with_block) {
                 const auto error_msg = "invalid transaction hash";
                 SILKRPC_ERROR << error_msg << "\n";
@@ -1274,7 +1375,7 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_call_bundle(const nlohma
                 break;
             }
             tx_info.gas_used = tx_with_block->transaction.gas_limit - execution_result.gas_left;
-            tx_info.hash = hash_of_transaction(tx_with_block->transaction);
+            std::memcpy(tx_info.hash.bytes, tx_hash_list[i].bytes, silkworm::kHashLength);
 
             if (execution_result.error_code != evmc_status_code::EVMC_SUCCESS) {
                 const auto error_message = EVMExecutor<>::get_error_message(execution_result.error_code, execution_result.data, false /* full_error */);
@@ -1302,14 +1403,40 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_call_bundle(const nlohma
     co_return;
 }
 
+FilterRegistry& EthereumRpcApi::filter_registry() {
+    auto& filter_registry = context_.filter_registry();
+    if (!filter_registry) {
+        throw std::runtime_error{"filters not available"};
+    }
+    return *filter_registry;
+}
+
 // https://eth.wiki/json-rpc/API#eth_newfilter
 boost::asio::awaitable<void> EthereumRpcApi::handle_eth_new_filter(const nlohmann::json& request, nlohmann::json& reply) {
+    auto params = request["params"];
+    if (params.size() != 1) {
+        auto error_msg = "invalid eth_newFilter params: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        reply = make_json_error(request["id"], 100, error_msg);
+        co_return;
+    }
+    auto filter = params[0].get<Filter>();
+    SILKRPC_DEBUG << "filter: " << filter << "\n";
+
     auto tx = co_await database_->begin();
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        reply = make_json_content(request["id"], to_quantity(0));
+        // Changes start from the next block unless a later start is requested, history is served by eth_getLogs
+        uint64_t next_block = co_await core::get_latest_executed_block_number(tx_database) + 1;
+        if (filter.from_block.has_value()) {
+            next_block = std::max(next_block, co_await core::get_block_number(filter.from_block.value(), tx_database));
+        }
+        const auto filter_id = filter_registry().add_logs_filter(filter, next_block);
+        SILKRPC_DEBUG << "filter_id: " << filter_id << " next_block: " << next_block << "\n";
+
+        reply = make_json_content(request["id"], filter_id);
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, e.what());
@@ -1324,12 +1451,8 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_new_filter(const nlohman
 
 // https://eth.wiki/json-rpc/API#eth_newblockfilter
 boost::asio::awaitable<void> EthereumRpcApi::handle_eth_new_block_filter(const nlohmann::json& request, nlohmann::json& reply) {
-    auto tx = co_await database_->begin();
-
     try {
-        ethdb::TransactionDatabase tx_database{*tx};
-
-        reply = make_json_content(request["id"], to_quantity(0));
+        reply = make_json_content(request["id"], filter_registry().add_block_filter());
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, e.what());
@@ -1337,19 +1460,13 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_new_block_filter(const n
         SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, "unexpected exception");
     }
-
-    co_await tx->close(); // RAII not (yet) available with coroutines
     co_return;
 }
 
 // https://eth.wiki/json-rpc/API#eth_newpendingtransactionfilter
 boost::asio::awaitable<void> EthereumRpcApi::handle_eth_new_pending_transaction_filter(const nlohmann::json& request, nlohmann::json& reply) {
-    auto tx = co_await database_->begin();
-
     try {
-        ethdb::TransactionDatabase tx_database{*tx};
-
-        reply = make_json_content(request["id"], to_quantity(0));
+        reply = make_json_content(request["id"], filter_registry().add_pending_transaction_filter());
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, e.what());
@@ -1357,19 +1474,73 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_new_pending_transaction_
         SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, "unexpected exception");
     }
-
-    co_await tx->close(); // RAII not (yet) available with coroutines
     co_return;
 }
 
 // https://eth.wiki/json-rpc/API#eth_getfilterchanges
 boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_filter_changes(const nlohmann::json& request, nlohmann::json& reply) {
+    auto params = request["params"];
+    if (params.size() != 1) {
+        auto error_msg = "invalid eth_getFilterChanges params: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        reply = make_json_error(request["id"], 100, error_msg);
+        co_return;
+    }
+    const auto filter_id = params[0].get<std::string>();
+    SILKRPC_DEBUG << "filter_id: " << filter_id << "\n";
+
     auto tx = co_await database_->begin();
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        reply = make_json_content(request["id"], to_quantity(0));
+        const auto filter_type = filter_registry().type(filter_id);
+        if (!filter_type) {
+            reply = make_json_error(request["id"], 100, "filter not found");
+        } else if (*filter_type == FilterType::block) {
+            const auto block_hashes = filter_registry().take_block_hashes(filter_id);
+            reply = make_json_content(request["id"], block_hashes.value_or(std::vector<evmc::bytes32>{}));
+        } else if (*filter_type == FilterType::pending_transaction) {
+            reply = make_json_content(request["id"], nlohmann::json::array());
+        } else {
+            const auto cursor = filter_registry().logs_cursor(filter_id);
+            if (!cursor) {
+                throw std::runtime_error{"filter not found"};
+            }
+
+            uint64_t last_block = co_await core::get_latest_executed_block_number(tx_database);
+            if (cursor->filter.to_block.has_value()) {
+                last_block = std::min(last_block, co_await core::get_block_number(cursor->filter.to_block.value(), tx_database));
+            }
+            SILKRPC_DEBUG << "next_block: " << cursor->next_block << " last_block: " << last_block << "\n";
+
+            // New blocks are taken from the tip log index or decoded once into the shared receipts cache, then just matched
+            const LogsFilter logs_filter{cursor->filter};
+            const auto& tip_log_index = context_.tip_log_index();
+            auto tip_logs = tip_log_index ? tip_log_index->find(cursor->next_block, last_block, logs_filter) : std::nullopt;
+            Logs logs;
+            if (tip_logs) {
+                logs = std::move(*tip_logs);
+            } else {
+                core::ReceiptsGenerator receipts_generator{*context_.io_context(), workers_};
+                for (auto block_number = cursor->next_block; block_number <= last_block; ++block_number) {
+                    const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_number, &workers_);
+                    const auto receipts = co_await core::get_receipts(tx_database, block_with_hash, block_cache_.get(),
+                                                                      context_.receipts_cache().get(), &receipts_generator);
+                    for (const auto& receipt : receipts) {
+                        std::copy_if(receipt.logs.begin(), receipt.logs.end(), std::back_inserter(logs),
+                                     [&](const auto& log) { return logs_filter.matches(log); });
+                    }
+                }
+            }
+            if (cursor->next_block <= last_block && !filter_registry().advance_logs_cursor(filter_id, *cursor, last_block + 1)) {
+                // Unwound or polled concurrently meanwhile: the next poll will deliver from the updated cursor
+                logs.clear();
+            }
+            SILKRPC_INFO << "filter_id: " << filter_id << " logs.size(): " << logs.size() << "\n";
+
+            reply = make_json_content(request["id"], logs);
+        }
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, e.what());
@@ -1384,12 +1555,18 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_filter_changes(const
 
 // https://eth.wiki/json-rpc/API#eth_uninstallfilter
 boost::asio::awaitable<void> EthereumRpcApi::handle_eth_uninstall_filter(const nlohmann::json& request, nlohmann::json& reply) {
-    auto tx = co_await database_->begin();
+    auto params = request["params"];
+    if (params.size() != 1) {
+        auto error_msg = "invalid eth_uninstallFilter params: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        reply = make_json_error(request["id"], 100, error_msg);
+        co_return;
+    }
+    const auto filter_id = params[0].get<std::string>();
+    SILKRPC_DEBUG << "filter_id: " << filter_id << "\n";
 
     try {
-        ethdb::TransactionDatabase tx_database{*tx};
-
-        reply = make_json_content(request["id"], to_quantity(0));
+        reply = make_json_content(request["id"], filter_registry().remove(filter_id));
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, e.what());
@@ -1397,24 +1574,35 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_uninstall_filter(const n
         SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, "unexpected exception");
     }
-
-    co_await tx->close(); // RAII not (yet) available with coroutines
     co_return;
 }
 
 // https://eth.wiki/json-rpc/API#eth_getlogs
-boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_logs(const nlohmann::json& request, nlohmann::json& reply) {
+boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_logs(const nlohmann::json& request, json::Stream& stream) {
     auto params = request["params"];
     if (params.size() != 1) {
         auto error_msg = "invalid eth_getLogs params: " + params.dump();
         SILKRPC_ERROR << error_msg << "\n";
-        reply = make_json_error(request["id"], 100, error_msg);
+        const auto reply = make_json_error(request["id"], 100, error_msg);
+        stream.write_json(reply);
         co_return;
     }
     auto filter = params[0].get<Filter>();
     SILKRPC_DEBUG << "filter: " << filter << "\n";
 
-    std::vector<Log> logs;
+    stream.open_object();
+    stream.write_field("id", request["id"]);
+    stream.write_field("jsonrpc", "2.0");
+
+    // The result array is opened lazily, so that errors detected before any log is found produce a plain error reply
+    bool result_open{false};
+    const auto open_result = [&]() {
+        if (!result_open) {
+            stream.write_field("result");
+            stream.open_array();
+            result_open = true;
+        }
+    };
 
     auto tx = co_await database_->begin();
 
@@ -1427,7 +1615,9 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_logs(const nlohmann:
             if (!block_hash_bytes.has_value()) {
                 auto error_msg = "invalid eth_getLogs filter block_hash: " + filter.block_hash.value();
                 SILKRPC_ERROR << error_msg << "\n";
-                reply = make_json_error(request["id"], 100, error_msg);
+                const Error error{100, error_msg};
+                stream.write_field("error", error);
+                stream.close_object();
                 co_await tx->close(); // RAII not (yet) available with coroutines
                 co_return;
             }
@@ -1453,6 +1643,21 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_logs(const nlohmann:
         }
         SILKRPC_INFO << "start block: " << start << " end block: " << end << "\n";
 
+        // Queries at the chain tip are answered by the in-memory index, without any bitmap walk or logs table scan
+        const auto& tip_log_index = context_.tip_log_index();
+        const auto tip_logs = tip_log_index ? tip_log_index->find(start, end, LogsFilter{filter}) : std::nullopt;
+        if (tip_logs) {
+            open_result();
+            for (const auto& log : *tip_logs) {
+                stream.write_json(log);
+            }
+            SILKRPC_INFO << "logs.size(): " << tip_logs->size() << " from tip log index\n";
+            stream.close_array();
+            stream.close_object();
+            co_await tx->close(); // RAII not (yet) available with coroutines
+            co_return;
+        }
+
         roaring::Roaring block_numbers;
         block_numbers.addRange(start, end + 1); // [min, max)
 
@@ -1481,68 +1686,93 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_logs(const nlohmann:
         SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
         SILKRPC_TRACE << "block_numbers: " << block_numbers.toString() << "\n";
 
-        if (block_numbers.cardinality() == 0) {
-            reply = make_json_content(request["id"], logs);
-            co_await tx->close(); // RAII not (yet) available with coroutines
-            co_return;
-        }
-
-        for (auto block_to_match : block_numbers) {
-            uint64_t log_index{0};
-
-            Logs filtered_block_logs{};
-            const auto block_key = silkworm::db::block_key(block_to_match);
-            SILKRPC_TRACE << "block_to_match: " << block_to_match << " block_key: " << silkworm::to_hex(block_key) << "\n";
-            co_await tx_database.for_prefix(db::table::kLogs, block_key, [&](const silkworm::Bytes& k, const silkworm::Bytes& v) {
-                Logs chunck_logs{};
-                const bool decoding_ok{cbor_decode(v, chunck_logs)};
-                if (!decoding_ok) {
-                    return false;
+        const LogsFilter logs_filter{filter};
+
+        // Each lane of blocks uses its own transaction because one transaction cannot serve concurrent reads
+        LogsLaneLoader lane_loader = [&](std::vector<uint64_t> lane_block_numbers) -> boost::asio::awaitable<Logs> {
+            Logs lane_logs;
+            auto lane_tx = co_await database_->begin();
+            std::exception_ptr eptr;
+            try {
+                ethdb::TransactionDatabase lane_database{*lane_tx};
+
+                std::vector<BlockLogChunks> blocks_chunks;
+                blocks_chunks.reserve(lane_block_numbers.size());
+                for (const auto block_number : lane_block_numbers) {
+                    BlockLogChunks block_chunks{block_number, {}};
+                    const auto block_key = silkworm::db::block_key(block_number);
+                    SILKRPC_TRACE << "block_to_match: " << block_number << " block_key: " << silkworm::to_hex(block_key) << "\n";
+                    co_await lane_database.for_prefix(db::table::kLogs, block_key, [&](const silkworm::Bytes& k, const silkworm::Bytes& v) {
+                        block_chunks.chunks.push_back({boost::endian::load_big_u32(&k[sizeof(uint64_t)]), v});
+                        return true;
+                    });
+                    blocks_chunks.push_back(std::move(block_chunks));
                 }
-                for (auto& log : chunck_logs) {
-                    log.index = log_index++;
-                }
-                SILKRPC_DEBUG << "chunck_logs.size(): " << chunck_logs.size() << "\n";
-                auto filtered_chunck_logs = filter_logs(chunck_logs, filter);
-                SILKRPC_DEBUG << "filtered_chunck_logs.size(): " << filtered_chunck_logs.size() << "\n";
-                if (filtered_chunck_logs.size() > 0) {
-                    const auto tx_id = boost::endian::load_big_u32(&k[sizeof(uint64_t)]);
-                    SILKRPC_DEBUG << "tx_id: " << tx_id << "\n";
-                    for (auto& log : filtered_chunck_logs) {
-                        log.tx_index = tx_id;
+
+                // CBOR decoding and filtering are CPU-bound, so keep them off the I/O context
+                auto blocks_logs = co_await async_decode_block_logs(*context_.io_context(), workers_, blocks_chunks, logs_filter);
+
+                for (std::size_t i{0}; i < blocks_logs.size(); ++i) {
+                    auto& filtered_block_logs = blocks_logs[i];
+                    SILKRPC_DEBUG << "filtered_block_logs.size(): " << filtered_block_logs.size() << "\n";
+                    if (filtered_block_logs.empty()) {
+                        continue;
                     }
-                    filtered_block_logs.insert(filtered_block_logs.end(), filtered_chunck_logs.begin(), filtered_chunck_logs.end());
-                }
-                return true;
-            });
-            SILKRPC_DEBUG << "filtered_block_logs.size(): " << filtered_block_logs.size() << "\n";
-
-            if (filtered_block_logs.size() > 0) {
-                const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_to_match);
-                SILKRPC_DEBUG << "block_hash: " << silkworm::to_hex(block_with_hash.hash) << "\n";
-                for (auto& log : filtered_block_logs) {
-                    const auto tx_hash{hash_of_transaction(block_with_hash.block.transactions[log.tx_index])};
-                    log.block_number = block_to_match;
-                    log.block_hash = block_with_hash.hash;
-                    log.tx_hash = silkworm::to_bytes32({tx_hash.bytes, silkworm::kHashLength});
+                    const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, lane_database, lane_block_numbers[i], &workers_);
+                    SILKRPC_DEBUG << "block_hash: " << silkworm::to_hex(block_with_hash.hash) << "\n";
+                    const auto transaction_hashes = block_cache_->transaction_hashes(block_with_hash);
+                    for (auto& log : filtered_block_logs) {
+                        log.block_hash = block_with_hash.hash;
+                        log.tx_hash = (*transaction_hashes)[log.tx_index];
+                    }
+                    lane_logs.insert(lane_logs.end(), filtered_block_logs.begin(), filtered_block_logs.end());
                 }
-                logs.insert(logs.end(), filtered_block_logs.begin(), filtered_block_logs.end());
+            } catch (...) {
+                eptr = std::current_exception();
             }
-        }
-        SILKRPC_INFO << "logs.size(): " << logs.size() << "\n";
+            co_await lane_tx->close(); // RAII not (yet) available with coroutines
+            if (eptr) {
+                std::rethrow_exception(eptr);
+            }
+            co_return lane_logs;
+        };
+
+        // Each window of blocks is written as soon as it is filtered, so memory does not grow with the response
+        uint64_t log_count{0};
+        LogsExtractor logs_extractor{lane_loader, context_.logs_settings()};
+        co_await logs_extractor.extract(block_numbers, [&](const Logs& window_logs) {
+            open_result();
+            for (const auto& log : window_logs) {
+                stream.write_json(log);
+            }
+            log_count += window_logs.size();
+        });
+        SILKRPC_INFO << "logs.size(): " << log_count << "\n";
 
-        reply = make_json_content(request["id"], logs);
+        open_result();
+        stream.close_array();
     } catch (const std::invalid_argument& iv) {
         SILKRPC_WARN << "invalid_argument: " << iv.what() << " processing request: " << request.dump() << "\n";
-        reply = make_json_content(request["id"], logs);
+        open_result();
+        stream.close_array();
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
-        reply = make_json_error(request["id"], 100, e.what());
+        if (result_open) {
+            stream.close_array();
+        }
+        const Error error{100, e.what()};
+        stream.write_field("error", error);
     } catch (...) {
         SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
-        reply = make_json_error(request["id"], 100, "unexpected exception");
+        if (result_open) {
+            stream.close_array();
+        }
+        const Error error{100, "unexpected exception"};
+        stream.write_field("error", error);
     }
 
+    stream.close_object();
+
     co_await tx->close(); // RAII not (yet) available with coroutines
     co_return;
 }
@@ -1908,50 +2138,4 @@ boost::asio::awaitable<roaring::Roaring> EthereumRpcApi::get_addresses_bitmap(co
     co_return result_bitmap;
 }
 
-std::vector<Log> EthereumRpcApi::filter_logs(std::vector<Log>& logs, const Filter& filter) {
-    std::vector<Log> filtered_logs;
-
-    auto addresses = filter.addresses;
-    auto topics = filter.topics;
-    SILKRPC_DEBUG << "filter.addresses: " << filter.addresses << "\n";
-    for (auto log : logs) {
-        SILKRPC_DEBUG << "log: " << log << "\n";
-        if (addresses.has_value() && std::find(addresses.value().begin(), addresses.value().end(), log.address) == addresses.value().end()) {
-            SILKRPC_DEBUG << "skipped log for address: 0x" << silkworm::to_hex(log.address) << "\n";
-            continue;
-        }
-        auto matches = true;
-        if (topics.has_value()) {
-            if (topics.value().size() > log.topics.size()) {
-                SILKRPC_DEBUG << "#topics: " << topics.value().size() << " #log.topics: " << log.topics.size() << "\n";
-                continue;
-            }
-            for (size_t i{0}; i < topics.value().size(); i++) {
-                SILKRPC_DEBUG << "log.topics[i]: " << log.topics[i] << "\n";
-                auto subtopics = topics.value()[i];
-                auto matches_subtopics = subtopics.empty(); // empty rule set == wildcard
-                SILKRPC_TRACE << "matches_subtopics: " << std::boolalpha << matches_subtopics << "\n";
-                for (auto topic : subtopics) {
-                    SILKRPC_DEBUG << "topic: " << topic << "\n";
-                    if (log.topics[i] == topic) {
-                        matches_subtopics = true;
-                        SILKRPC_TRACE << "matches_subtopics: " << matches_subtopics << "\n";
-                        break;
-                    }
-                }
-                if (!matches_subtopics) {
-                    SILKRPC_TRACE << "No subtopic matches\n";
-                    matches = false;
-                    break;
-                }
-            }
-        }
-        SILKRPC_DEBUG << "matches: " << matches << "\n";
-        if (matches) {
-            filtered_logs.push_back(log);
-        }
-    }
-    return filtered_logs;
-}
-
 } // namespace silkrpc::commands
@@ -0,0 +1,204 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "eth_api.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <boost/asio/thread_pool.hpp>
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+#include <nlohmann/json.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/rlp/encode.hpp>
+#include <silkworm/core/types/block.hpp>
+#include <silkworm/node/db/util.hpp>
+
+#include <silkworm/silkrpc/ethdb/cursor.hpp>
+#include <silkworm/silkrpc/ethdb/database.hpp>
+#include <silkworm/silkrpc/ethdb/tables.hpp>
+#include <silkworm/silkrpc/ethdb/transaction.hpp>
+#include <silkworm/silkrpc/test/allocation_count.hpp>
+#include <silkworm/silkrpc/test/context_test_base.hpp>
+
+namespace silkrpc::commands {
+
+using evmc::literals::operator""_bytes32;
+
+using Table = std::map<silkworm::Bytes, silkworm::Bytes>;
+using Tables = std::map<std::string, Table>;
+
+//! Cursor over one in-memory table, completing every operation without suspending like a database cache hit
+class InMemoryCursor : public ethdb::CursorDupSort {
+public:
+    explicit InMemoryCursor(const Table& table) : table_(table), current_{table_.end()} {}
+
+    uint32_t cursor_id() const override { return 0; }
+
+    boost::asio::awaitable<void> open_cursor(const std::string& /*table_name*/, bool /*is_dup_sorted*/) override { co_return; }
+
+    boost::asio::awaitable<KeyValue> seek(silkworm::ByteView key) override {
+        current_ = table_.lower_bound(silkworm::Bytes{key});
+        co_return current_key_value();
+    }
+
+    boost::asio::awaitable<KeyValue> seek_exact(silkworm::ByteView key) override {
+        current_ = table_.find(silkworm::Bytes{key});
+        co_return current_key_value();
+    }
+
+    boost::asio::awaitable<KeyValue> next() override {
+        if (current_ != table_.end()) {
+            ++current_;
+        }
+        co_return current_key_value();
+    }
+
+    boost::asio::awaitable<void> close_cursor() override { co_return; }
+
+    boost::asio::awaitable<silkworm::Bytes> seek_both(silkworm::ByteView /*key*/, silkworm::ByteView /*value*/) override {
+        co_return silkworm::Bytes{};
+    }
+
+    boost::asio::awaitable<KeyValue> seek_both_exact(silkworm::ByteView /*key*/, silkworm::ByteView /*value*/) override {
+        co_return KeyValue{};
+    }
+
+    boost::asio::awaitable<KeyValue> next_dup() override { co_return KeyValue{}; }
+
+private:
+    KeyValue current_key_value() const { return current_ != table_.end() ? KeyValue{current_->first, current_->second} : KeyValue{}; }
+
+    const Table& table_;
+    Table::const_iterator current_;
+};
+
+class InMemoryTransaction : public ethdb::Transaction {
+public:
+    explicit InMemoryTransaction(const Tables& tables) : tables_(tables) {}
+
+    uint64_t tx_id() const override { return 0; }
+
+    boost::asio::awaitable<void> open() override { co_return; }
+
+    boost::asio::awaitable<std::shared_ptr<ethdb::Cursor>> cursor(const std::string& table) override {
+        co_return std::make_shared<InMemoryCursor>(lookup(table));
+    }
+
+    boost::asio::awaitable<std::shared_ptr<ethdb::CursorDupSort>> cursor_dup_sort(const std::string& table) override {
+        co_return std::make_shared<InMemoryCursor>(lookup(table));
+    }
+
+    boost::asio::awaitable<void> close() override { co_return; }
+
+private:
+    const Table& lookup(const std::string& table) const {
+        static const Table kEmptyTable;
+        const auto it = tables_.find(table);
+        return it != tables_.end() ? it->second : kEmptyTable;
+    }
+
+    const Tables& tables_;
+};
+
+class InMemoryDatabase : public ethdb::Database {
+public:
+    explicit InMemoryDatabase(Tables tables) : tables_(std::move(tables)) {}
+
+    boost::asio::awaitable<std::unique_ptr<ethdb::Transaction>> begin() override {
+        co_return std::make_unique<InMemoryTransaction>(tables_);
+    }
+
+private:
+    Tables tables_;
+};
+
+//! Mainnet database holding just the empty genesis block: the latest block is the genesis and all accounts are empty
+static Tables make_genesis_tables() {
+    const auto kGenesisHash{0xd4e56740f876aef8c010b86a40d5f56745a118d0906a34e69aec8c0db1cb8fa3_bytes32};
+    const silkworm::Bytes genesis_hash{kGenesisHash.bytes, silkworm::kHashLength};
+    const auto genesis_key{silkworm::db::block_key(0, kGenesisHash.bytes)};
+
+    silkworm::BlockHeader header;
+    header.gas_limit = 30'000'000;
+    silkworm::Bytes header_rlp;
+    silkworm::rlp::encode(header_rlp, header);
+
+    // The stored transactions include the system ones at the beginning and at the end of the block
+    silkworm::db::detail::BlockBodyForStorage body;
+    body.txn_count = 2;
+
+    return Tables{
+        {db::table::kCanonicalHashes, Table{{silkworm::db::block_key(0), genesis_hash}}},
+        {db::table::kConfig, Table{{genesis_hash, silkworm::bytes_of_string(R"({"chainId":1,"ethash":{}})")}}},
+        {db::table::kHeaders, Table{{genesis_key, header_rlp}}},
+        {db::table::kBlockBodies, Table{{genesis_key, body.encode()}}},
+    };
+}
+
+class EthereumRpcApiForTest : public EthereumRpcApi {
+public:
+    explicit EthereumRpcApiForTest(Context& context, boost::asio::thread_pool& workers) : EthereumRpcApi{context, workers} {}
+
+    using EthereumRpcApi::handle_eth_get_balance;
+    using EthereumRpcApi::handle_eth_call;
+};
+
+using HandleTestMethod = boost::asio::awaitable<void> (EthereumRpcApiForTest::*)(const nlohmann::json&, nlohmann::json&);
+
+//! Count the global allocations made on the I/O context thread by the given handler, once warmed up
+boost::asio::awaitable<uint64_t> count_allocations(EthereumRpcApiForTest& eth_api, HandleTestMethod handle_method, const nlohmann::json& request,
+                                                   nlohmann::json& reply, std::size_t num_requests) {
+    co_await (eth_api.*handle_method)(request, reply);
+    const auto start_count = test::allocation_count();
+    for (std::size_t i{0}; i < num_requests; ++i) {
+        co_await (eth_api.*handle_method)(request, reply);
+    }
+    co_return test::allocation_count() - start_count;
+}
+
+TEST_CASE_METHOD(test::ContextTestBase, "count allocations of real handlers", "[silkrpc][eth_api]") {
+    const std::size_t kNumRequests{100};
+    boost::asio::thread_pool workers{1};
+    context_.database() = std::make_unique<InMemoryDatabase>(make_genesis_tables());
+    EthereumRpcApiForTest eth_api{context_, workers};
+
+    // The awaitable frames are only part of the global allocations of a request, the rest being JSON, bytes and containers:
+    // the comparison with the default recycling cache size is reported by the shape-based tests in config_alloc_test.cpp
+    const std::pair<HandleTestMethod, nlohmann::json> requests[]{
+        {&EthereumRpcApiForTest::handle_eth_get_balance, R"({
+            "jsonrpc":"2.0","id":1,"method":"eth_getBalance",
+            "params":["0x0715a7794a1dc8e42615f059dd6e406a6594651a","latest"]
+        })"_json},
+        {&EthereumRpcApiForTest::handle_eth_call, R"({
+            "jsonrpc":"2.0","id":2,"method":"eth_call",
+            "params":[{"from":"0xa872626373628737383927236382161739290870","to":"0x0715a7794a1dc8e42615f059dd6e406a6594651a","gas":"0x5208"},"latest"]
+        })"_json},
+    };
+    for (const auto& [handle_method, request] : requests) {
+        nlohmann::json reply;
+        const auto allocations = spawn_and_wait(count_allocations(eth_api, handle_method, request, reply, kNumRequests));
+        WARN(request["method"].get<std::string>() << " request: " << allocations / kNumRequests << " global allocations");
+        CHECK(reply.contains("result"));
+    }
+}
+
+} // namespace silkrpc::commands
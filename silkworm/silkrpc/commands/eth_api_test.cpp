@@ -16,10 +16,15 @@
 
 #include "eth_api.hpp"
 
+#include <exception>
+#include <future>
 #include <memory>
 #include <thread>
 
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
 #include <boost/asio/co_spawn.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/thread_pool.hpp>
 #include <boost/asio/use_future.hpp>
 #include <catch2/catch.hpp>
@@ -30,7 +35,10 @@
 #include <silkworm/silkrpc/concurrency/context_pool.hpp>
 #include <silkworm/silkrpc/ethdb/cursor.hpp>
 #include <silkworm/silkrpc/ethdb/database.hpp>
+#include <silkworm/silkrpc/ethdb/kv/remote_database.hpp>
 #include <silkworm/silkrpc/ethdb/transaction.hpp>
+#include <silkworm/silkrpc/test/grpc_actions.hpp>
+#include <silkworm/silkrpc/test/kv_test_base.hpp>
 
 namespace silkrpc::commands {
 
@@ -84,6 +92,41 @@ TEST_CASE("handle_eth_block_number succeeds if request well-formed", "[silkrpc][
    */
 }
 
+TEST_CASE_METHOD(test::KVTestBase, "handle_eth_block_number closes transaction if cancelled", "[silkrpc][eth_api]") {
+    boost::asio::thread_pool workers{1};
+    boost::asio::cancellation_signal cancellation_signal;
+
+    // Set the call expectations:
+    // 1. remote::KV::StubInterface::PrepareAsyncTxRaw call succeeds
+    auto* kv_stub = stub_.get();
+    expect_request_async_tx(*kv_stub, /*ok=*/true);
+    // 2. AsyncReaderWriter<remote::Cursor, remote::Pair>::Read call succeeds after the request has been cancelled, so that
+    // the handler fails at the next remote operation (i.e. no Write call)
+    EXPECT_CALL(reader_writer_, Read).WillOnce([&](remote::Pair* pair, void* tag) {
+        boost::asio::post(io_context_, [&]() { cancellation_signal.emit(boost::asio::cancellation_type::terminal); });
+        pair->set_txid(4);
+        agrpc::process_grpc_tag(grpc_context_, tag, /*ok=*/true);
+    });
+    // 3. AsyncReaderWriter<remote::Cursor, remote::Pair>::WritesDone call succeeds
+    EXPECT_CALL(reader_writer_, WritesDone).WillOnce(test::writes_done_success(grpc_context_));
+    // 4. AsyncReaderWriter<remote::Cursor, remote::Pair>::Finish call succeeds w/ status OK
+    EXPECT_CALL(reader_writer_, Finish).WillOnce(test::finish_streaming_ok(grpc_context_));
+
+    context_.database() = std::make_unique<ethdb::kv::RemoteDatabase>(grpc_context_, std::move(stub_));
+    EthereumRpcApiTest eth_api{context_, workers};
+    const auto request = R"({"jsonrpc":"2.0","id":1,"method":"eth_blockNumber","params":[]})"_json;
+    nlohmann::json reply;
+
+    // Execute the test: the handler should reply with an error and close the transaction in spite of the cancellation
+    std::promise<std::exception_ptr> handler_outcome;
+    boost::asio::co_spawn(io_context_, eth_api.handle_eth_block_number(request, reply),
+        boost::asio::bind_cancellation_slot(cancellation_signal.slot(), [&](std::exception_ptr eptr) {
+            handler_outcome.set_value(eptr);
+        }));
+    CHECK(handler_outcome.get_future().get() == nullptr);
+    CHECK(reply.contains("error"));
+}
+
 TEST_CASE("handle_eth_block_number fails if request empty", "[silkrpc][eth_api]") {
     nlohmann::json reply;
     //test_eth_api(&EthereumRpcApiTest::handle_eth_block_number, R"({})"_json, reply);
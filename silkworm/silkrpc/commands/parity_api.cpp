@@ -56,8 +56,9 @@ boost::asio::awaitable<void> ParityRpcApi::handle_parity_get_block_receipts(cons
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
-        const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
-        auto receipts{co_await core::get_receipts(tx_database, block_with_hash)};
+        const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number, &workers_);
+        core::ReceiptsGenerator receipts_generator{*context_.io_context(), workers_};
+        auto receipts{co_await core::get_receipts(tx_database, block_with_hash, context_.block_cache().get(), context_.receipts_cache().get(), &receipts_generator)};
         SILKRPC_INFO << "#receipts: " << receipts.size() << "\n";
 
         const auto block{block_with_hash.block};
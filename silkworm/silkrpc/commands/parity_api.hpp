@@ -21,6 +21,7 @@
 #include <silkworm/silkrpc/config.hpp> // NOLINT(build/include_order)
 
 #include <boost/asio/awaitable.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <nlohmann/json.hpp>
 
 #include <silkworm/silkrpc/concurrency/context_pool.hpp>
@@ -34,7 +35,7 @@ namespace silkrpc::commands {
 
 class ParityRpcApi {
 public:
-    explicit ParityRpcApi(Context& context) : database_(context.database()), context_(context) {}
+    explicit ParityRpcApi(Context& context, boost::asio::thread_pool& workers) : database_(context.database()), context_(context), workers_{workers} {}
     virtual ~ParityRpcApi() {}
 
     ParityRpcApi(const ParityRpcApi&) = delete;
@@ -47,6 +48,7 @@ protected:
 private:
     std::unique_ptr<ethdb::Database>& database_;
     Context& context_;
+    boost::asio::thread_pool& workers_;
 
     friend class silkrpc::http::RequestHandler;
 };
@@ -27,7 +27,8 @@ TEST_CASE("ParityRpcApi::ParityRpcApi", "[silkrpc][erigon_api]") {
     ContextPool context_pool{1, []() {
         return grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials());
     }};
-    CHECK_NOTHROW(ParityRpcApi{context_pool.next_context()});
+    boost::asio::thread_pool workers{1};
+    CHECK_NOTHROW(ParityRpcApi{context_pool.next_context(), workers});
 }
 
 } // namespace silkrpc::commands
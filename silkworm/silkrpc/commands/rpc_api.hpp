@@ -41,7 +41,7 @@ class RpcApi : protected EthereumRpcApi, NetRpcApi, Web3RpcApi, DebugRpcApi, Par
 public:
     explicit RpcApi(Context& context, boost::asio::thread_pool& workers) :
         EthereumRpcApi{context, workers}, NetRpcApi{context.backend()}, Web3RpcApi{context}, DebugRpcApi{context, workers},
-        ParityRpcApi{context}, ErigonRpcApi{context}, TraceRpcApi{context, workers}, OtsRpcApi{context},
+        ParityRpcApi{context, workers}, ErigonRpcApi{context, workers}, TraceRpcApi{context, workers}, OtsRpcApi{context},
         EngineRpcApi(context.database(), context.backend()),
         TxPoolRpcApi(context) {}
 
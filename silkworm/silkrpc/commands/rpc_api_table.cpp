@@ -44,6 +44,18 @@ std::optional<RpcApiTable::HandleStream> RpcApiTable::find_stream_handler(const
     return handle_method_pair->second;
 }
 
+CostClass RpcApiTable::find_cost_class(const std::string& method) {
+    const auto api_namespace = method.substr(0, method.find('_'));
+    if (api_namespace == kDebugApiNamespace || api_namespace == kTraceApiNamespace) {
+        return CostClass::trace;
+    }
+    if (method == http::method::k_eth_call || method == http::method::k_eth_estimateGas ||
+        method == http::method::k_eth_callBundle || method == http::method::k_eth_createAccessList) {
+        return CostClass::evm;
+    }
+    return CostClass::light;
+}
+
 void RpcApiTable::build_handlers(const std::string& api_spec) {
     auto start = 0u;
     auto end = api_spec.find(kApiSpecSeparator);
@@ -99,6 +111,8 @@ void RpcApiTable::add_eth_handlers() {
     method_handlers_[http::method::k_eth_protocolVersion] = &commands::RpcApi::handle_eth_protocol_version;
     method_handlers_[http::method::k_eth_syncing] = &commands::RpcApi::handle_eth_syncing;
     method_handlers_[http::method::k_eth_gasPrice] = &commands::RpcApi::handle_eth_gas_price;
+    method_handlers_[http::method::k_eth_maxPriorityFeePerGas] = &commands::RpcApi::handle_eth_max_priority_fee_per_gas;
+    method_handlers_[http::method::k_eth_feeHistory] = &commands::RpcApi::handle_eth_fee_history;
     method_handlers_[http::method::k_eth_getBlockByHash] = &commands::RpcApi::handle_eth_get_block_by_hash;
     method_handlers_[http::method::k_eth_getBlockByNumber] = &commands::RpcApi::handle_eth_get_block_by_number;
     method_handlers_[http::method::k_eth_getBlockTransactionCountByHash] = &commands::RpcApi::handle_eth_get_block_transaction_count_by_hash;
@@ -127,7 +141,7 @@ void RpcApiTable::add_eth_handlers() {
     method_handlers_[http::method::k_eth_newPendingTransactionFilter] = &commands::RpcApi::handle_eth_new_pending_transaction_filter;
     method_handlers_[http::method::k_eth_getFilterChanges] = &commands::RpcApi::handle_eth_get_filter_changes;
     method_handlers_[http::method::k_eth_uninstallFilter] = &commands::RpcApi::handle_eth_uninstall_filter;
-    method_handlers_[http::method::k_eth_getLogs] = &commands::RpcApi::handle_eth_get_logs;
+    stream_handlers_[http::method::k_eth_getLogs] = &commands::RpcApi::handle_eth_get_logs;
     method_handlers_[http::method::k_eth_sendRawTransaction] = &commands::RpcApi::handle_eth_send_raw_transaction;
     method_handlers_[http::method::k_eth_sendTransaction] = &commands::RpcApi::handle_eth_send_transaction;
     method_handlers_[http::method::k_eth_signTransaction] = &commands::RpcApi::handle_eth_sign_transaction;
@@ -158,7 +172,7 @@ void RpcApiTable::add_erigon_handlers() {
     method_handlers_[http::method::k_erigon_getBlockByTimestamp] = &commands::RpcApi::handle_erigon_get_block_by_timestamp;
     method_handlers_[http::method::k_erigon_getHeaderByHash] = &commands::RpcApi::handle_erigon_get_header_by_hash;
     method_handlers_[http::method::k_erigon_getHeaderByNumber] = &commands::RpcApi::handle_erigon_get_header_by_number;
-    method_handlers_[http::method::k_erigon_getLogsByHash] = &commands::RpcApi::handle_erigon_get_logs_by_hash;
+    stream_handlers_[http::method::k_erigon_getLogsByHash] = &commands::RpcApi::handle_erigon_get_logs_by_hash;
     method_handlers_[http::method::k_erigon_forks] = &commands::RpcApi::handle_erigon_forks;
     method_handlers_[http::method::k_erigon_watchTheBurn] = &commands::RpcApi::handle_erigon_watch_the_burn;
     method_handlers_[http::method::k_erigon_cumulative_chain_traffic] = &commands::RpcApi::handle_erigon_cumulative_chain_traffic;
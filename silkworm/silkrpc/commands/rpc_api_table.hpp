@@ -26,6 +26,7 @@
 #include <nlohmann/json.hpp>
 
 #include <silkworm/silkrpc/commands/rpc_api.hpp>
+#include <silkworm/silkrpc/concurrency/cost_class_limiter.hpp>
 #include <silkworm/silkrpc/json/stream.hpp>
 
 namespace silkrpc::commands {
@@ -43,6 +44,9 @@ public:
     std::optional<HandleMethod> find_json_handler(const std::string& method) const;
     std::optional<HandleStream> find_stream_handler(const std::string& method) const;
 
+    //! Classify the method by the execution cost of its requests
+    static CostClass find_cost_class(const std::string& method);
+
 private:
     void build_handlers(const std::string& api_spec);
     void add_handlers(const std::string& api_namespace);
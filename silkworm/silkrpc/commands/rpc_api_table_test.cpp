@@ -0,0 +1,35 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "rpc_api_table.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc::commands {
+
+TEST_CASE("method cost class", "[silkrpc][commands][rpc_api_table]") {
+    CHECK(RpcApiTable::find_cost_class("eth_blockNumber") == CostClass::light);
+    CHECK(RpcApiTable::find_cost_class("eth_getLogs") == CostClass::light);
+    CHECK(RpcApiTable::find_cost_class("engine_newPayloadV1") == CostClass::light);
+    CHECK(RpcApiTable::find_cost_class("eth_call") == CostClass::evm);
+    CHECK(RpcApiTable::find_cost_class("eth_estimateGas") == CostClass::evm);
+    CHECK(RpcApiTable::find_cost_class("eth_createAccessList") == CostClass::evm);
+    CHECK(RpcApiTable::find_cost_class("debug_traceBlockByNumber") == CostClass::trace);
+    CHECK(RpcApiTable::find_cost_class("trace_filter") == CostClass::trace);
+    CHECK(RpcApiTable::find_cost_class("unknown") == CostClass::light);
+}
+
+} // namespace silkrpc::commands
@@ -17,7 +17,9 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include <evmc/evmc.hpp>
 #include <silkworm/core/chain/config.hpp>
@@ -30,12 +32,16 @@
 
 #include <boost/compute/detail/lru_cache.hpp>
 
+#include <silkworm/silkrpc/common/util.hpp>
+
 namespace silkrpc {
 
+using TransactionHashes = std::vector<evmc::bytes32>;
+
 class BlockCache {
 public:
     explicit BlockCache(std::size_t capacity = 1024, bool shared_cache = true)
-        : block_cache_(capacity), shared_cache_(shared_cache) {}
+        : block_cache_(capacity), transaction_hashes_cache_(capacity), shared_cache_(shared_cache) {}
 
     boost::optional <silkworm::BlockWithHash> get(const evmc::bytes32& key) {
         if (shared_cache_) {
@@ -53,9 +59,46 @@ public:
         block_cache_.insert(key, block);
     }
 
+    //! Return the hashes of the block transactions, computed just once for each block with transactions
+    std::shared_ptr<const TransactionHashes> transaction_hashes(const silkworm::BlockWithHash& block_with_hash) {
+        if (shared_cache_) {
+            const std::lock_guard<std::mutex> lock(access_);
+            const auto cached_hashes = transaction_hashes_cache_.get(block_with_hash.hash);
+            if (cached_hashes) {
+                return *cached_hashes;
+            }
+        } else {
+            const auto cached_hashes = transaction_hashes_cache_.get(block_with_hash.hash);
+            if (cached_hashes) {
+                return *cached_hashes;
+            }
+        }
+
+        const auto& transactions = block_with_hash.block.transactions;
+        auto hashes = std::make_shared<TransactionHashes>();
+        hashes->reserve(transactions.size());
+        for (const auto& transaction : transactions) {
+            const auto hash{hash_of_transaction(transaction)};
+            hashes->push_back(silkworm::to_bytes32({hash.bytes, silkworm::kHashLength}));
+        }
+        if (transactions.empty()) {
+            // same as blocks: transactions of a non-canonical block may be removed and restored later
+            return hashes;
+        }
+
+        if (shared_cache_) {
+            const std::lock_guard<std::mutex> lock(access_);
+            transaction_hashes_cache_.insert(block_with_hash.hash, hashes);
+        } else {
+            transaction_hashes_cache_.insert(block_with_hash.hash, hashes);
+        }
+        return hashes;
+    }
+
 private:
     mutable std::mutex access_;
     boost::compute::detail::lru_cache<evmc::bytes32, silkworm::BlockWithHash> block_cache_;
+    boost::compute::detail::lru_cache<evmc::bytes32, std::shared_ptr<const TransactionHashes>> transaction_hashes_cache_;
     bool shared_cache_;
 };
 
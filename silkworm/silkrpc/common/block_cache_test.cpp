@@ -64,5 +64,28 @@ TEST_CASE("insert entry in cache(no-lock)", "[silkrpc][commands][block_cache]")
     CHECK((*ret_block_option).hash == block1.hash);
 }
 
+TEST_CASE("transaction hashes computed once per block", "[silkrpc][commands][block_cache]") {
+    BlockCache block_cache(2, true);
+    silkworm::BlockWithHash block1{};
+    block1.hash = 0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32;
+    block1.block.transactions.resize(2);
+    block1.block.transactions[1].nonce = 1;
+
+    const auto hashes = block_cache.transaction_hashes(block1);
+    REQUIRE(hashes->size() == 2);
+    const auto hash0{hash_of_transaction(block1.block.transactions[0])};
+    CHECK((*hashes)[0] == silkworm::to_bytes32({hash0.bytes, silkworm::kHashLength}));
+    CHECK((*hashes)[0] != (*hashes)[1]);
+    CHECK(block_cache.transaction_hashes(block1) == hashes);
+
+    SECTION("block without transactions not memoized") {
+        silkworm::BlockWithHash block2{};
+        block2.hash = 0x474f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32;
+        const auto empty_hashes = block_cache.transaction_hashes(block2);
+        CHECK(empty_hashes->empty());
+        CHECK(block_cache.transaction_hashes(block2) != empty_hashes);
+    }
+}
+
 } // namespace silkrpc
 
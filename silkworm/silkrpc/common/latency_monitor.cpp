@@ -0,0 +1,39 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "latency_monitor.hpp"
+
+namespace silkrpc {
+
+bool LatencyMonitor::record(uint64_t latency_ns) {
+    ++count_;
+    total_latency_ns_ += latency_ns;
+    auto max_latency_ns = max_latency_ns_.load();
+    while (latency_ns > max_latency_ns && !max_latency_ns_.compare_exchange_weak(max_latency_ns, latency_ns)) {
+    }
+    if (latency_ns > slo_ns_) {
+        ++slo_violations_;
+        return false;
+    }
+    return true;
+}
+
+uint64_t LatencyMonitor::mean_latency_ns() const noexcept {
+    const uint64_t count = count_;
+    return count == 0 ? 0 : total_latency_ns_ / count;
+}
+
+} // namespace silkrpc
@@ -0,0 +1,52 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace silkrpc {
+
+//! The default latency objective of Engine API calls, well below the block slot time of the consensus layer
+const uint64_t kDefaultEngineLatencySlo = 1'000; // milliseconds
+
+//! Latency statistics of the calls served against a target latency (SLO)
+class LatencyMonitor {
+public:
+    explicit LatencyMonitor(uint64_t slo_ns) : slo_ns_(slo_ns) {}
+
+    LatencyMonitor(const LatencyMonitor&) = delete;
+    LatencyMonitor& operator=(const LatencyMonitor&) = delete;
+
+    //! Record the latency of one call: return false if it exceeds the SLO
+    bool record(uint64_t latency_ns);
+
+    uint64_t slo_ns() const noexcept { return slo_ns_; }
+    uint64_t count() const noexcept { return count_; }
+    uint64_t slo_violations() const noexcept { return slo_violations_; }
+    uint64_t max_latency_ns() const noexcept { return max_latency_ns_; }
+    uint64_t mean_latency_ns() const noexcept;
+
+private:
+    const uint64_t slo_ns_;
+    std::atomic_uint64_t count_{0};
+    std::atomic_uint64_t slo_violations_{0};
+    std::atomic_uint64_t total_latency_ns_{0};
+    std::atomic_uint64_t max_latency_ns_{0};
+};
+
+} // namespace silkrpc
@@ -0,0 +1,45 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "latency_monitor.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+TEST_CASE("latency monitor", "[silkrpc][common][latency_monitor]") {
+    LatencyMonitor monitor{1'000};
+
+    SECTION("no calls") {
+        CHECK(monitor.slo_ns() == 1'000);
+        CHECK(monitor.count() == 0);
+        CHECK(monitor.slo_violations() == 0);
+        CHECK(monitor.max_latency_ns() == 0);
+        CHECK(monitor.mean_latency_ns() == 0);
+    }
+
+    SECTION("calls within and beyond the SLO") {
+        CHECK(monitor.record(200));
+        CHECK(monitor.record(1'000));
+        CHECK(!monitor.record(1'800));
+        CHECK(monitor.count() == 3);
+        CHECK(monitor.slo_violations() == 1);
+        CHECK(monitor.max_latency_ns() == 1'800);
+        CHECK(monitor.mean_latency_ns() == 1'000);
+    }
+}
+
+} // namespace silkrpc
@@ -0,0 +1,108 @@
+/*
+   Copyright 2020 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+
+#include <boost/compute/detail/lru_cache.hpp>
+
+#include <silkworm/silkrpc/types/receipt.hpp>
+
+namespace silkrpc {
+
+using ReceiptsWaiter = std::function<void(std::exception_ptr, std::shared_ptr<const Receipts>)>;
+
+//! Fully derived receipts of the most recently used blocks, keyed by block hash so that reorgs never return stale entries
+class ReceiptsCache {
+public:
+    explicit ReceiptsCache(std::size_t capacity = 256, bool shared_cache = true)
+        : receipts_cache_(capacity), shared_cache_(shared_cache) {}
+
+    std::shared_ptr<const Receipts> get(const evmc::bytes32& block_hash) {
+        if (shared_cache_) {
+            const std::lock_guard<std::mutex> lock(access_);
+            return get_unlocked(block_hash);
+        }
+        return get_unlocked(block_hash);
+    }
+
+    void insert(const evmc::bytes32& block_hash, std::shared_ptr<const Receipts> receipts) {
+        if (shared_cache_) {
+            const std::lock_guard<std::mutex> lock(access_);
+            return receipts_cache_.insert(block_hash, std::move(receipts));
+        }
+        receipts_cache_.insert(block_hash, std::move(receipts));
+    }
+
+    //! Mark the receipts of the given block as being regenerated: return false if another request is already doing it
+    bool start_regeneration(const evmc::bytes32& block_hash) {
+        const std::lock_guard<std::mutex> lock(access_);
+        return regenerations_.try_emplace(block_hash).second;
+    }
+
+    //! Register a waiter for the regeneration in progress: return false if the regeneration is not in progress anymore
+    bool wait_regeneration(const evmc::bytes32& block_hash, ReceiptsWaiter waiter) {
+        const std::lock_guard<std::mutex> lock(access_);
+        auto it = regenerations_.find(block_hash);
+        if (it == regenerations_.end()) {
+            return false;
+        }
+        it->second.push_back(std::move(waiter));
+        return true;
+    }
+
+    //! Complete the regeneration of the given block, storing the receipts (if any) and notifying all the waiters
+    void finish_regeneration(const evmc::bytes32& block_hash, std::shared_ptr<const Receipts> receipts, std::exception_ptr error) {
+        std::vector<ReceiptsWaiter> waiters;
+        {
+            const std::lock_guard<std::mutex> lock(access_);
+            if (receipts) {
+                receipts_cache_.insert(block_hash, receipts);
+            }
+            auto it = regenerations_.find(block_hash);
+            if (it != regenerations_.end()) {
+                waiters = std::move(it->second);
+                regenerations_.erase(it);
+            }
+        }
+        for (auto& waiter : waiters) {
+            waiter(error, receipts);
+        }
+    }
+
+private:
+    std::shared_ptr<const Receipts> get_unlocked(const evmc::bytes32& block_hash) {
+        const auto cached_receipts = receipts_cache_.get(block_hash);
+        return cached_receipts ? *cached_receipts : nullptr;
+    }
+
+    mutable std::mutex access_;
+    boost::compute::detail::lru_cache<evmc::bytes32, std::shared_ptr<const Receipts>> receipts_cache_;
+    std::map<evmc::bytes32, std::vector<ReceiptsWaiter>> regenerations_;
+    bool shared_cache_;
+};
+
+} // namespace silkrpc
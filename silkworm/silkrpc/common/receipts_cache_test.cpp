@@ -0,0 +1,76 @@
+/*
+   Copyright 2021 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "receipts_cache.hpp"
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+using evmc::literals::operator""_bytes32;
+
+TEST_CASE("receipts cache key not present", "[silkrpc][common][receipts_cache]") {
+    ReceiptsCache receipts_cache(1, true);
+    CHECK(receipts_cache.get(0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32) == nullptr);
+}
+
+TEST_CASE("insert receipts in cache", "[silkrpc][common][receipts_cache]") {
+    evmc::bytes32 bh1{0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+    evmc::bytes32 bh2{0x474f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+    ReceiptsCache receipts_cache(1, false);
+
+    auto receipts = std::make_shared<Receipts>(2);
+    (*receipts)[1].cumulative_gas_used = 21000;
+    receipts_cache.insert(bh1, receipts);
+
+    const auto cached_receipts = receipts_cache.get(bh1);
+    REQUIRE(cached_receipts != nullptr);
+    CHECK(cached_receipts->size() == 2);
+    CHECK((*cached_receipts)[1].cumulative_gas_used == 21000);
+
+    SECTION("least recently used block evicted") {
+        receipts_cache.insert(bh2, std::make_shared<Receipts>(1));
+        CHECK(receipts_cache.get(bh1) == nullptr);
+        CHECK(receipts_cache.get(bh2) != nullptr);
+    }
+}
+
+TEST_CASE("coalesce receipts regeneration", "[silkrpc][common][receipts_cache]") {
+    evmc::bytes32 bh1{0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+    ReceiptsCache receipts_cache(2, true);
+
+    CHECK(receipts_cache.start_regeneration(bh1));
+    CHECK(!receipts_cache.start_regeneration(bh1));
+
+    int notified{0};
+    std::shared_ptr<const Receipts> notified_receipts;
+    CHECK(receipts_cache.wait_regeneration(bh1, [&](std::exception_ptr error, std::shared_ptr<const Receipts> receipts) {
+        CHECK(!error);
+        notified_receipts = receipts;
+        ++notified;
+    }));
+
+    SECTION("waiters notified and receipts cached on success") {
+        const auto receipts = std::make_shared<const Receipts>(3);
+        receipts_cache.finish_regeneration(bh1, receipts, nullptr);
+        CHECK(notified == 1);
+        CHECK(notified_receipts == receipts);
+        CHECK(receipts_cache.get(bh1) == receipts);
+        CHECK(!receipts_cache.wait_regeneration(bh1, [](auto, auto) {}));
+        CHECK(receipts_cache.start_regeneration(bh1));
+    }
+}
+
+} // namespace silkrpc
@@ -0,0 +1,151 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "admission_controller.hpp"
+
+#include <fstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <silkworm/silkrpc/common/log.hpp>
+
+namespace silkrpc {
+
+AdmissionController::AdmissionController(const AdmissionSettings& settings, const CostClassLimiter* cost_class_limiter)
+    : settings_(settings), cost_class_limiter_(cost_class_limiter) {}
+
+bool AdmissionController::try_open_connection(const boost::asio::ip::address& address) {
+    const std::lock_guard<std::mutex> lock(access_);
+    if (settings_.max_connections != 0 && open_connections_ >= settings_.max_connections) {
+        ++rejected_connections_;
+        SILKRPC_WARN << "AdmissionController: connection from " << address << " rejected, open connections: " << open_connections_ << "\n";
+        return false;
+    }
+    auto& address_connections = connections_by_address_[address];
+    if (settings_.max_connections_per_ip != 0 && address_connections >= settings_.max_connections_per_ip) {
+        ++rejected_connections_;
+        SILKRPC_WARN << "AdmissionController: connection from " << address << " rejected, open connections: " << address_connections << "\n";
+        return false;
+    }
+    ++address_connections;
+    ++open_connections_;
+    return true;
+}
+
+void AdmissionController::close_connection(const boost::asio::ip::address& address) {
+    const std::lock_guard<std::mutex> lock(access_);
+    const auto it = connections_by_address_.find(address);
+    if (it == connections_by_address_.end()) {
+        return;
+    }
+    if (--it->second == 0) {
+        connections_by_address_.erase(it);
+    }
+    --open_connections_;
+}
+
+void AdmissionController::add_context(const boost::asio::io_context& io_context) {
+    auto& context_in_flight = in_flight_by_context_[&io_context];
+    if (!context_in_flight) {
+        context_in_flight = std::make_unique<std::atomic_size_t>(0);
+    }
+}
+
+void AdmissionController::start(boost::asio::io_context& io_context) {
+    if (settings_.max_resident_memory == 0) {
+        return;
+    }
+    sample_resident_memory();
+    boost::asio::co_spawn(io_context, sample_resident_memory_periodically(io_context), boost::asio::detached);
+}
+
+boost::asio::awaitable<void> AdmissionController::sample_resident_memory_periodically(boost::asio::io_context& io_context) {
+    boost::asio::steady_timer timer{io_context};
+    while (true) {
+        timer.expires_after(kResidentMemorySamplingInterval);
+        co_await timer.async_wait(boost::asio::use_awaitable);
+        sample_resident_memory();
+    }
+}
+
+bool AdmissionController::try_admit_request(CostClass cost_class, const boost::asio::io_context& io_context) {
+    auto* in_flight = context_in_flight(io_context);
+    const auto previous_in_flight = in_flight != nullptr ? in_flight->fetch_add(1) : 0;
+    if (cost_class != CostClass::light && is_overloaded(previous_in_flight)) {
+        if (in_flight != nullptr) {
+            --*in_flight;
+        }
+        ++rejected_requests_;
+        return false;
+    }
+    return true;
+}
+
+void AdmissionController::complete_request(const boost::asio::io_context& io_context) {
+    if (auto* in_flight = context_in_flight(io_context)) {
+        --*in_flight;
+    }
+}
+
+std::size_t AdmissionController::open_connections() const {
+    const std::lock_guard<std::mutex> lock(access_);
+    return open_connections_;
+}
+
+std::size_t AdmissionController::in_flight_requests(const boost::asio::io_context& io_context) const {
+    const auto* in_flight = context_in_flight(io_context);
+    return in_flight != nullptr ? in_flight->load() : 0;
+}
+
+std::atomic_size_t* AdmissionController::context_in_flight(const boost::asio::io_context& io_context) const {
+    const auto it = in_flight_by_context_.find(&io_context);
+    return it != in_flight_by_context_.end() ? it->second.get() : nullptr;
+}
+
+bool AdmissionController::is_overloaded(std::size_t context_in_flight) const {
+    if (settings_.max_in_flight_requests != 0 && context_in_flight >= settings_.max_in_flight_requests) {
+        return true;
+    }
+    if (settings_.max_queued_requests != 0 && cost_class_limiter_ != nullptr) {
+        if (cost_class_limiter_->total_queue_depth() >= settings_.max_queued_requests) {
+            return true;
+        }
+    }
+    if (settings_.max_resident_memory != 0 && resident_memory_ >= settings_.max_resident_memory) {
+        return true;
+    }
+    return false;
+}
+
+uint64_t AdmissionController::resident_memory() const {
+#ifdef __linux__
+    std::ifstream statm{"/proc/self/statm"};
+    uint64_t total_pages{0}, resident_pages{0};
+    if (statm >> total_pages >> resident_pages) {
+        return resident_pages * static_cast<uint64_t>(::sysconf(_SC_PAGESIZE)) / (1024 * 1024);
+    }
+#endif
+    return 0;
+}
+
+} // namespace silkrpc
@@ -0,0 +1,137 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <silkworm/silkrpc/config.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address.hpp>
+
+#include <silkworm/silkrpc/concurrency/cost_class_limiter.hpp>
+
+namespace silkrpc {
+
+const uint32_t kDefaultMaxConnections = 8'192;
+const uint32_t kDefaultMaxConnectionsPerIp = 0;
+const uint32_t kDefaultMaxInFlightRequests = 256;
+const uint32_t kDefaultMaxQueuedRequests = 1'024;
+const uint64_t kDefaultMaxResidentMemory = 0;
+const std::chrono::milliseconds kResidentMemorySamplingInterval{100};
+
+//! Limits beyond which new connections or low-priority requests are rejected, zero means unlimited
+struct AdmissionSettings {
+    //! Max number of open connections
+    uint32_t max_connections{kDefaultMaxConnections};
+    //! Max number of open connections from the same remote address
+    uint32_t max_connections_per_ip{kDefaultMaxConnectionsPerIp};
+    //! Max number of requests in flight on one execution context
+    uint32_t max_in_flight_requests{kDefaultMaxInFlightRequests};
+    //! Max number of requests waiting for an execution slot in the cost class queues
+    uint32_t max_queued_requests{kDefaultMaxQueuedRequests};
+    //! Max resident memory of the process in MiB
+    uint64_t max_resident_memory{kDefaultMaxResidentMemory};
+};
+
+//! Admission control shedding load early under overload, so that the admitted requests keep being served quickly
+class AdmissionController {
+public:
+    explicit AdmissionController(const AdmissionSettings& settings = {}, const CostClassLimiter* cost_class_limiter = nullptr);
+
+    AdmissionController(const AdmissionController&) = delete;
+    AdmissionController& operator=(const AdmissionController&) = delete;
+
+    //! Count a new connection from the given address: return false if it must be rejected
+    bool try_open_connection(const boost::asio::ip::address& address);
+
+    //! Forget a connection previously opened
+    void close_connection(const boost::asio::ip::address& address);
+
+    //! Track the in-flight requests running on the given context: all contexts must be added before serving any request
+    void add_context(const boost::asio::io_context& io_context);
+
+    //! Sample the resident memory periodically on the given context, if limited
+    void start(boost::asio::io_context& io_context);
+
+    //! Sample the resident memory once, used by the next admissions
+    void sample_resident_memory() { resident_memory_ = resident_memory(); }
+
+    //! Count a new request running on the given context: return false if it must be rejected. Light requests are never
+    //! rejected here because each connection serves one request at a time, so the connection limits already bound them.
+    //! Requests running on contexts not added are limited only by queued requests and resident memory
+    bool try_admit_request(CostClass cost_class, const boost::asio::io_context& io_context);
+
+    //! Forget a request previously admitted
+    void complete_request(const boost::asio::io_context& io_context);
+
+    std::size_t open_connections() const;
+    std::size_t in_flight_requests(const boost::asio::io_context& io_context) const;
+    uint64_t rejected_connections() const noexcept { return rejected_connections_; }
+    uint64_t rejected_requests() const noexcept { return rejected_requests_; }
+
+protected:
+    //! The resident memory of the process in MiB, zero if not available
+    virtual uint64_t resident_memory() const;
+
+private:
+    boost::asio::awaitable<void> sample_resident_memory_periodically(boost::asio::io_context& io_context);
+
+    bool is_overloaded(std::size_t context_in_flight) const;
+
+    std::atomic_size_t* context_in_flight(const boost::asio::io_context& io_context) const;
+
+    const AdmissionSettings settings_;
+    const CostClassLimiter* cost_class_limiter_;
+
+    //! Guards the connection counters only, taken once per connection and never per request
+    mutable std::mutex access_;
+    std::size_t open_connections_{0};
+    std::map<boost::asio::ip::address, std::size_t> connections_by_address_;
+
+    //! The in-flight requests by context, never modified while serving requests so that lookups need no lock
+    std::map<const boost::asio::io_context*, std::unique_ptr<std::atomic_size_t>> in_flight_by_context_;
+
+    //! The last sample of the resident memory of the process in MiB
+    std::atomic_uint64_t resident_memory_{0};
+
+    std::atomic_uint64_t rejected_connections_{0};
+    std::atomic_uint64_t rejected_requests_{0};
+};
+
+//! The admission of one request running on a context, completed on destruction
+class AdmissionTicket {
+public:
+    AdmissionTicket(AdmissionController& controller, const boost::asio::io_context& io_context) : controller_(controller), io_context_(io_context) {}
+    ~AdmissionTicket() { controller_.complete_request(io_context_); }
+
+    AdmissionTicket(const AdmissionTicket&) = delete;
+    AdmissionTicket& operator=(const AdmissionTicket&) = delete;
+
+private:
+    AdmissionController& controller_;
+    const boost::asio::io_context& io_context_;
+};
+
+} // namespace silkrpc
@@ -0,0 +1,131 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "admission_controller.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+class AdmissionControllerForTest : public AdmissionController {
+public:
+    using AdmissionController::AdmissionController;
+
+    uint64_t memory{0};
+
+protected:
+    uint64_t resident_memory() const override { return memory; }
+};
+
+TEST_CASE("admission of connections", "[silkrpc][concurrency][admission_controller]") {
+    const auto address1 = boost::asio::ip::make_address("10.0.0.1");
+    const auto address2 = boost::asio::ip::make_address("10.0.0.2");
+
+    SECTION("max connections") {
+        AdmissionController controller{AdmissionSettings{.max_connections = 2, .max_connections_per_ip = 0}};
+        CHECK(controller.try_open_connection(address1));
+        CHECK(controller.try_open_connection(address2));
+        CHECK(!controller.try_open_connection(address2));
+        CHECK(controller.open_connections() == 2);
+        CHECK(controller.rejected_connections() == 1);
+        controller.close_connection(address1);
+        CHECK(controller.try_open_connection(address2));
+    }
+
+    SECTION("max connections per ip") {
+        AdmissionController controller{AdmissionSettings{.max_connections = 0, .max_connections_per_ip = 1}};
+        CHECK(controller.try_open_connection(address1));
+        CHECK(!controller.try_open_connection(address1));
+        CHECK(controller.try_open_connection(address2));
+        controller.close_connection(address1);
+        CHECK(controller.try_open_connection(address1));
+        CHECK(controller.rejected_connections() == 1);
+    }
+}
+
+TEST_CASE("admission of requests", "[silkrpc][concurrency][admission_controller]") {
+    boost::asio::io_context io_context1;
+    boost::asio::io_context io_context2;
+
+    SECTION("max in-flight requests per context") {
+        AdmissionController controller{AdmissionSettings{.max_in_flight_requests = 1, .max_queued_requests = 0}};
+        controller.add_context(io_context1);
+        controller.add_context(io_context2);
+        CHECK(controller.try_admit_request(CostClass::evm, io_context1));
+        CHECK(!controller.try_admit_request(CostClass::trace, io_context1));
+        CHECK(controller.try_admit_request(CostClass::light, io_context1));
+        CHECK(controller.try_admit_request(CostClass::evm, io_context2));
+        CHECK(controller.in_flight_requests(io_context1) == 2);
+        CHECK(controller.rejected_requests() == 1);
+        controller.complete_request(io_context1);
+        controller.complete_request(io_context1);
+        CHECK(controller.in_flight_requests(io_context1) == 0);
+        CHECK(controller.try_admit_request(CostClass::trace, io_context1));
+    }
+
+    SECTION("requests on contexts not added are not limited per context") {
+        AdmissionController controller{AdmissionSettings{.max_in_flight_requests = 1, .max_queued_requests = 0}};
+        CHECK(controller.try_admit_request(CostClass::evm, io_context1));
+        CHECK(controller.try_admit_request(CostClass::evm, io_context1));
+        CHECK(controller.in_flight_requests(io_context1) == 0);
+        controller.complete_request(io_context1);
+        CHECK(controller.rejected_requests() == 0);
+    }
+
+    SECTION("max queued requests") {
+        CostClassLimiter limiter{CostClassSettings{.light_concurrency = 0, .evm_concurrency = 1, .trace_concurrency = 1}};
+        AdmissionController controller{AdmissionSettings{.max_in_flight_requests = 0, .max_queued_requests = 1}, &limiter};
+        CHECK(controller.try_admit_request(CostClass::evm, io_context1));
+        REQUIRE(limiter.try_acquire(CostClass::evm));
+        auto waiter = [&]() -> boost::asio::awaitable<void> { co_await limiter.acquire(CostClass::evm, io_context1); };
+        boost::asio::co_spawn(io_context1, waiter(), boost::asio::detached);
+        io_context1.poll();
+        CHECK(limiter.queue_depth(CostClass::evm) == 1);
+        CHECK(limiter.total_queue_depth() == 1);
+        CHECK(!controller.try_admit_request(CostClass::evm, io_context1));
+        CHECK(controller.try_admit_request(CostClass::light, io_context1));
+        limiter.release(CostClass::evm);
+        io_context1.run();
+        CHECK(controller.try_admit_request(CostClass::evm, io_context1));
+    }
+
+    SECTION("max resident memory") {
+        AdmissionControllerForTest controller{AdmissionSettings{.max_in_flight_requests = 0, .max_queued_requests = 0, .max_resident_memory = 1'024}};
+        controller.memory = 512;
+        controller.sample_resident_memory();
+        CHECK(controller.try_admit_request(CostClass::evm, io_context1));
+        controller.memory = 2'048;
+        CHECK(controller.try_admit_request(CostClass::evm, io_context1));
+        controller.sample_resident_memory();
+        CHECK(!controller.try_admit_request(CostClass::evm, io_context1));
+        CHECK(controller.try_admit_request(CostClass::light, io_context1));
+    }
+
+    SECTION("resident memory sampled periodically") {
+        AdmissionControllerForTest controller{AdmissionSettings{.max_in_flight_requests = 0, .max_queued_requests = 0, .max_resident_memory = 1'024}};
+        controller.memory = 2'048;
+        controller.start(io_context1);
+        CHECK(!controller.try_admit_request(CostClass::evm, io_context1));
+        controller.memory = 512;
+        io_context1.run_for(kResidentMemorySamplingInterval * 3);
+        CHECK(controller.try_admit_request(CostClass::evm, io_context1));
+    }
+}
+
+} // namespace silkrpc
@@ -0,0 +1,36 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <silkworm/silkrpc/config.hpp>
+
+#include <boost/asio/cancellation_state.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/system/system_error.hpp>
+
+namespace silkrpc {
+
+//! Throw operation_aborted if the cancellation of the running coroutine has been requested. Coroutines throw by themselves
+//! only when awaiting asynchronous operations, so loops whose steps may complete without suspending must check explicitly:
+//!     throw_if_cancelled(co_await boost::asio::this_coro::cancellation_state);
+inline void throw_if_cancelled(const boost::asio::cancellation_state& state) {
+    if (state.cancelled() != boost::asio::cancellation_type::none) {
+        throw boost::system::system_error{boost::asio::error::operation_aborted};
+    }
+}
+
+} // namespace silkrpc
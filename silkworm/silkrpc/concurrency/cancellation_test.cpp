@@ -0,0 +1,58 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "cancellation.hpp"
+
+#include <exception>
+
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+TEST_CASE("throw if cancelled", "[silkrpc][concurrency][cancellation]") {
+    boost::asio::io_context io_context;
+    boost::asio::cancellation_signal cancellation_signal;
+    int steps{0};
+    std::exception_ptr loop_eptr;
+
+    auto loop = [&]() -> boost::asio::awaitable<void> {
+        for (int i{0}; i < 10; ++i) {
+            throw_if_cancelled(co_await boost::asio::this_coro::cancellation_state);
+            if (++steps == 3) {
+                cancellation_signal.emit(boost::asio::cancellation_type::terminal);
+            }
+        }
+    };
+    boost::asio::co_spawn(io_context, loop(), boost::asio::bind_cancellation_slot(cancellation_signal.slot(), [&](std::exception_ptr eptr) {
+        loop_eptr = eptr;
+    }));
+    io_context.run();
+
+    CHECK(steps == 3);
+    REQUIRE(loop_eptr);
+    try {
+        std::rethrow_exception(loop_eptr);
+    } catch (const boost::system::system_error& se) {
+        CHECK(se.code() == boost::asio::error::operation_aborted);
+    }
+}
+
+} // namespace silkrpc
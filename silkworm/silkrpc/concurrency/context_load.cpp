@@ -0,0 +1,43 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "context_load.hpp"
+
+namespace silkrpc {
+
+ContextLoad::ContextLoad(std::size_t num_contexts)
+    : num_contexts_(num_contexts), in_flight_{std::make_unique<std::atomic_size_t[]>(num_contexts)} {}
+
+std::size_t ContextLoad::select(std::size_t local_index) const {
+    const std::size_t local_in_flight = in_flight_[local_index];
+    if (local_in_flight < kMinContextLoadGap) {
+        return local_index;
+    }
+
+    // Loads are sampled without synchronization: a slightly stale view only leads to a slightly worse choice
+    std::size_t selected_index = local_index;
+    std::size_t selected_in_flight = local_in_flight;
+    for (std::size_t i{0}; i < num_contexts_; ++i) {
+        const std::size_t in_flight = in_flight_[i];
+        if (in_flight < selected_in_flight) {
+            selected_index = i;
+            selected_in_flight = in_flight;
+        }
+    }
+    return selected_in_flight + kMinContextLoadGap <= local_in_flight ? selected_index : local_index;
+}
+
+} // namespace silkrpc
@@ -0,0 +1,51 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace silkrpc {
+
+//! Min difference in requests in flight for moving a request away from its local context, so that hops pay off
+const std::size_t kMinContextLoadGap = 2;
+
+//! The load of the execution contexts measured as requests in flight, used to pick where to run the next request
+class ContextLoad {
+public:
+    explicit ContextLoad(std::size_t num_contexts);
+
+    ContextLoad(const ContextLoad&) = delete;
+    ContextLoad& operator=(const ContextLoad&) = delete;
+
+    //! Select the least-loaded context, preferring the local one unless it carries at least kMinContextLoadGap more requests
+    std::size_t select(std::size_t local_index) const;
+
+    void increment(std::size_t index) noexcept { ++in_flight_[index]; }
+    void decrement(std::size_t index) noexcept { --in_flight_[index]; }
+
+    std::size_t size() const noexcept { return num_contexts_; }
+    std::size_t in_flight(std::size_t index) const noexcept { return in_flight_[index]; }
+
+private:
+    std::size_t num_contexts_;
+    std::unique_ptr<std::atomic_size_t[]> in_flight_;
+};
+
+} // namespace silkrpc
@@ -0,0 +1,55 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "context_load.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+TEST_CASE("context load", "[silkrpc][concurrency][context_load]") {
+    ContextLoad load{3};
+    CHECK(load.size() == 3);
+
+    SECTION("idle contexts keep requests local") {
+        CHECK(load.select(0) == 0);
+        CHECK(load.select(2) == 2);
+    }
+
+    SECTION("small imbalance keeps requests local") {
+        load.increment(0);
+        load.increment(1);
+        load.increment(1);
+        load.increment(2);
+        CHECK(load.select(1) == 1);
+    }
+
+    SECTION("large imbalance moves requests to the least-loaded context") {
+        for (int i{0}; i < 4; ++i) {
+            load.increment(0);
+        }
+        load.increment(1);
+        load.increment(1);
+        load.increment(2);
+        CHECK(load.in_flight(0) == 4);
+        CHECK(load.select(0) == 2);
+        load.decrement(0);
+        load.decrement(0);
+        CHECK(load.select(0) == 0);
+    }
+}
+
+} // namespace silkrpc
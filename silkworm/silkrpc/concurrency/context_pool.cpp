@@ -40,15 +40,22 @@ Context::Context(
     std::shared_ptr<BlockCache> block_cache,
     std::shared_ptr<ethdb::kv::StateCache> state_cache,
     std::shared_ptr<mdbx::env_managed> chaindata_env,
-    WaitMode wait_mode)
+    WaitMode wait_mode,
+    ContextSharedState shared_state,
+    std::optional<std::pair<int, int>> cpus)
     : io_context_{std::make_shared<boost::asio::io_context>()},
       io_context_work_{boost::asio::make_work_guard(*io_context_)},
       grpc_context_{std::make_unique<agrpc::GrpcContext>(std::make_unique<grpc::CompletionQueue>())},
       grpc_context_work_{boost::asio::make_work_guard(grpc_context_->get_executor())},
       block_cache_(block_cache),
       state_cache_(state_cache),
+      shared_state_(std::move(shared_state)),
       chaindata_env_(chaindata_env),
-      wait_mode_(wait_mode) {
+      wait_mode_(wait_mode),
+      cpus_(cpus) {
+    if (wait_mode == WaitMode::adaptive) {
+        adaptive_wait_strategy_ = std::make_unique<AdaptiveWaitStrategy>();
+    }
     std::shared_ptr<grpc::Channel> channel = create_channel();
     if (chaindata_env) {
         database_ = std::make_unique<ethdb::file::LocalDatabase>(chaindata_env);
@@ -80,6 +87,9 @@ void Context::execute_loop_single_threaded(WaitStrategy&& wait_strategy) {
 void Context::execute_loop_multi_threaded() {
     SILKRPC_DEBUG << "Multi-thread execution loop start [" << this << "]\n";
     std::thread grpc_context_thread{[&]() {
+        if (cpus_) {
+            pin_current_thread(cpus_->second);
+        }
         grpc_context_->run_completion_queue();
     }};
     io_context_->run();
@@ -91,6 +101,10 @@ void Context::execute_loop_multi_threaded() {
 }
 
 void Context::execute_loop() {
+    // The GrpcContext runs on this same thread except in blocking mode, where it gets its own thread
+    if (cpus_) {
+        pin_current_thread(cpus_->first);
+    }
     switch (wait_mode_) {
         case WaitMode::backoff:
             execute_loop_agrpc();
@@ -110,6 +124,9 @@ void Context::execute_loop() {
         case WaitMode::busy_spin:
             execute_loop_single_threaded(BusySpinWaitStrategy{});
         break;
+        case WaitMode::adaptive:
+            execute_loop_single_threaded(*adaptive_wait_strategy_);
+        break;
     }
 }
 
@@ -118,7 +135,9 @@ void Context::stop() {
     SILKRPC_DEBUG << "Context::stop io_context " << io_context_ << " [" << this << "]\n";
 }
 
-ContextPool::ContextPool(std::size_t pool_size, ChannelFactory create_channel, std::optional<std::string> datadir, WaitMode wait_mode) : next_index_{0} {
+ContextPool::ContextPool(std::size_t pool_size, ChannelFactory create_channel, std::optional<std::string> datadir, WaitMode wait_mode,
+                         LogsSettings logs_settings, bool reserve_context, ContextAffinity affinity, std::size_t state_checkpoint_cache_bytes)
+    : pool_size_{pool_size}, next_index_{0} {
     if (pool_size == 0) {
         throw std::logic_error("ContextPool::ContextPool pool_size is 0");
     }
@@ -144,9 +163,36 @@ ContextPool::ContextPool(std::size_t pool_size, ChannelFactory create_channel, s
     // Create the unique state cache to be shared among the execution contexts
     auto state_cache = std::make_shared<ethdb::kv::CoherentStateCache>();
 
-    // Create as many execution contexts as required by the pool size
-    for (std::size_t i{0}; i < pool_size; ++i) {
-        contexts_.emplace_back(Context{create_channel, block_cache, state_cache, chain_env, wait_mode});
+    ContextSharedState shared_state;
+
+    // Create the unique state checkpoint cache to be shared among the execution contexts, if enabled
+    if (state_checkpoint_cache_bytes > 0) {
+        shared_state.state_checkpoint_cache = std::make_shared<state::StateCheckpointCache>(state_checkpoint_cache_bytes);
+    }
+
+    // Create the unique gas price window to be shared among the execution contexts
+    shared_state.gas_price_window = std::make_shared<GasPriceWindow>();
+
+    // Create the unique fee history cache to be shared among the execution contexts
+    shared_state.fee_history_cache = std::make_shared<FeeHistoryCache>();
+
+    // Create the unique receipts cache to be shared among the execution contexts
+    shared_state.receipts_cache = std::make_shared<ReceiptsCache>();
+
+    shared_state.logs_settings = logs_settings;
+
+    // Create the unique filter registry to be shared among the execution contexts
+    shared_state.filter_registry = std::make_shared<FilterRegistry>();
+
+    // Create the unique tip log index to be shared among the execution contexts, if enabled
+    if (logs_settings.tip_window > 0) {
+        shared_state.tip_log_index = std::make_shared<TipLogIndex>(logs_settings.tip_window);
+    }
+
+    // Create as many execution contexts as required by the pool size plus the reserved one, each having its own channel
+    const std::size_t num_contexts = reserve_context ? pool_size + 1 : pool_size;
+    for (std::size_t i{0}; i < num_contexts; ++i) {
+        contexts_.emplace_back(Context{create_channel, block_cache, state_cache, chain_env, wait_mode, shared_state, affinity.context_cpus(i)});
         SILKRPC_DEBUG << "ContextPool::ContextPool context[" << i << "] " << contexts_[i] << "\n";
     }
 }
@@ -209,10 +255,17 @@ void ContextPool::run() {
 Context& ContextPool::next_context() {
     // Use a round-robin scheme to choose the next context to use
     auto& context = contexts_[next_index_];
-    next_index_ = ++next_index_ % contexts_.size();
+    next_index_ = ++next_index_ % pool_size_;
     return context;
 }
 
+Context& ContextPool::reserved_context() {
+    if (contexts_.size() == pool_size_) {
+        throw std::logic_error("ContextPool::reserved_context no context reserved");
+    }
+    return contexts_.back();
+}
+
 boost::asio::io_context& ContextPool::next_io_context() {
     auto& client_context = next_context();
     return *client_context.io_context();
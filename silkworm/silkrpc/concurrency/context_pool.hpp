@@ -21,7 +21,9 @@
 #include <iostream>
 #include <list>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <agrpc/asio_grpc.hpp>
@@ -31,7 +33,15 @@
 
 #include <silkworm/silkrpc/common/block_cache.hpp>
 #include <silkworm/silkrpc/common/log.hpp>
+#include <silkworm/silkrpc/common/receipts_cache.hpp>
+#include <silkworm/silkrpc/concurrency/cpu_affinity.hpp>
 #include <silkworm/silkrpc/concurrency/wait_strategy.hpp>
+#include <silkworm/silkrpc/core/fee_history_oracle.hpp>
+#include <silkworm/silkrpc/core/filter_registry.hpp>
+#include <silkworm/silkrpc/core/gas_price_oracle.hpp>
+#include <silkworm/silkrpc/core/logs_extractor.hpp>
+#include <silkworm/silkrpc/core/state_checkpoint.hpp>
+#include <silkworm/silkrpc/core/tip_log_index.hpp>
 #include <silkworm/silkrpc/ethbackend/backend.hpp>
 #include <silkworm/silkrpc/ethdb/database.hpp>
 #include <silkworm/silkrpc/ethdb/kv/state_cache.hpp>
@@ -42,6 +52,17 @@ namespace silkrpc {
 
 using ChannelFactory = std::function<std::shared_ptr<grpc::Channel>()>;
 
+//! The state shared among the execution contexts of one pool, each part optional.
+struct ContextSharedState {
+    std::shared_ptr<state::StateCheckpointCache> state_checkpoint_cache;
+    std::shared_ptr<GasPriceWindow> gas_price_window;
+    std::shared_ptr<FeeHistoryCache> fee_history_cache;
+    std::shared_ptr<ReceiptsCache> receipts_cache;
+    LogsSettings logs_settings;
+    std::shared_ptr<FilterRegistry> filter_registry;
+    std::shared_ptr<TipLogIndex> tip_log_index;
+};
+
 //! Asynchronous client scheduler running an execution loop.
 class Context {
   public:
@@ -50,7 +71,9 @@ class Context {
         std::shared_ptr<BlockCache> block_cache,
         std::shared_ptr<ethdb::kv::StateCache> state_cache,
         std::shared_ptr<mdbx::env_managed> chaindata_env = {},
-        WaitMode wait_mode = WaitMode::blocking);
+        WaitMode wait_mode = WaitMode::blocking,
+        ContextSharedState shared_state = {},
+        std::optional<std::pair<int, int>> cpus = {});
 
     boost::asio::io_context* io_context() const noexcept { return io_context_.get(); }
     grpc::CompletionQueue* grpc_queue() const noexcept { return grpc_context_->get_completion_queue(); }
@@ -61,6 +84,14 @@ class Context {
     std::unique_ptr<txpool::TransactionPool>& tx_pool() noexcept { return tx_pool_; }
     std::shared_ptr<BlockCache>& block_cache() noexcept { return block_cache_; }
     std::shared_ptr<ethdb::kv::StateCache>& state_cache() noexcept { return state_cache_; }
+    std::shared_ptr<state::StateCheckpointCache>& state_checkpoint_cache() noexcept { return shared_state_.state_checkpoint_cache; }
+    std::shared_ptr<GasPriceWindow>& gas_price_window() noexcept { return shared_state_.gas_price_window; }
+    std::shared_ptr<FeeHistoryCache>& fee_history_cache() noexcept { return shared_state_.fee_history_cache; }
+    std::shared_ptr<ReceiptsCache>& receipts_cache() noexcept { return shared_state_.receipts_cache; }
+    const LogsSettings& logs_settings() const noexcept { return shared_state_.logs_settings; }
+    std::shared_ptr<FilterRegistry>& filter_registry() noexcept { return shared_state_.filter_registry; }
+    std::shared_ptr<TipLogIndex>& tip_log_index() noexcept { return shared_state_.tip_log_index; }
+    const AdaptiveWaitStrategy* adaptive_wait_strategy() const noexcept { return adaptive_wait_strategy_.get(); }
 
     //! Execute the scheduler loop until stopped.
     void execute_loop();
@@ -95,8 +126,15 @@ class Context {
     std::unique_ptr<txpool::TransactionPool> tx_pool_;
     std::shared_ptr<BlockCache> block_cache_;
     std::shared_ptr<ethdb::kv::StateCache> state_cache_;
+    ContextSharedState shared_state_;
     std::shared_ptr<mdbx::env_managed> chaindata_env_;
     WaitMode wait_mode_;
+
+    //! The CPUs to pin the io_context and GrpcContext threads to (optional).
+    std::optional<std::pair<int, int>> cpus_;
+
+    //! The wait strategy of the adaptive wait mode, kept here to expose its state (optional).
+    std::unique_ptr<AdaptiveWaitStrategy> adaptive_wait_strategy_;
 };
 
 std::ostream& operator<<(std::ostream& out, Context& c);
@@ -105,7 +143,9 @@ std::ostream& operator<<(std::ostream& out, Context& c);
 // [currently cannot start/stop more than once because grpc::CompletionQueue cannot be used after shutdown]
 class ContextPool {
 public:
-    explicit ContextPool(std::size_t pool_size, ChannelFactory create_channel, std::optional<std::string> datadir = {}, WaitMode wait_mode = WaitMode::blocking);
+    explicit ContextPool(std::size_t pool_size, ChannelFactory create_channel, std::optional<std::string> datadir = {}, WaitMode wait_mode = WaitMode::blocking,
+                         LogsSettings logs_settings = {}, bool reserve_context = false, ContextAffinity affinity = {},
+                         std::size_t state_checkpoint_cache_bytes = state::kDefaultCheckpointCacheMaxBytes);
     ~ContextPool();
 
     ContextPool(const ContextPool&) = delete;
@@ -123,10 +163,21 @@ public:
 
     boost::asio::io_context& next_io_context();
 
+    //! The context reserved for latency-critical services, never returned by next_context and run on its own thread
+    Context& reserved_context();
+
+    //! The number of contexts used in round-robin, the reserved one excluded
+    std::size_t size() const noexcept { return pool_size_; }
+
+    Context& context(std::size_t index) { return contexts_.at(index); }
+
 private:
-    // The pool of contexts
+    // The pool of contexts, followed by the reserved one if any
     std::vector<Context> contexts_;
 
+    // The number of contexts used in round-robin
+    std::size_t pool_size_;
+
     //! The pool of threads running the execution contexts.
     boost::asio::detail::thread_group context_threads_;
 
@@ -135,6 +135,20 @@ TEST_CASE("create context pool", "[silkrpc][context_pool]") {
         CHECK(&io_context2 == &io_context5);
         CHECK(&io_context3 == &io_context6);
     }
+
+    SECTION("no reserved context by default") {
+        ContextPool cp{1, create_channel};
+        CHECK_THROWS_MATCHES(cp.reserved_context(), std::logic_error, Message("ContextPool::reserved_context no context reserved"));
+    }
+
+    SECTION("reserved context excluded from round-robin") {
+        ContextPool cp{2, create_channel, {}, WaitMode::blocking, {}, /*reserve_context=*/true};
+        auto& reserved_context = cp.reserved_context();
+        for (int i{0}; i < 4; ++i) {
+            CHECK(&cp.next_context() != &reserved_context);
+        }
+        CHECK(reserved_context.backend() != cp.next_context().backend());
+    }
 }
 
 TEST_CASE("start context pool", "[silkrpc][context_pool]") {
@@ -153,6 +167,13 @@ TEST_CASE("start context pool", "[silkrpc][context_pool]") {
         cp.stop();
         cp.join();
     }
+
+    SECTION("running 2 thread pinned to CPU pairs") {
+        ContextPool cp{2, create_channel, {}, WaitMode::blocking, {}, false, ContextAffinity{{0}, /*pair_cpus=*/true}};
+        cp.start();
+        cp.stop();
+        cp.join();
+    }
 }
 
 TEST_CASE("run context pool", "[silkrpc][context_pool]") {
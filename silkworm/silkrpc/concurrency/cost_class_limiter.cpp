@@ -0,0 +1,137 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "cost_class_limiter.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <boost/asio/cancellation_type.hpp>
+#include <boost/asio/compose.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+namespace silkrpc {
+
+CostClassLimiter::CostClassLimiter(const CostClassSettings& settings) {
+    classes_[static_cast<std::size_t>(CostClass::light)].max_concurrency = settings.light_concurrency;
+    classes_[static_cast<std::size_t>(CostClass::evm)].max_concurrency = settings.evm_concurrency;
+    classes_[static_cast<std::size_t>(CostClass::trace)].max_concurrency = settings.trace_concurrency;
+}
+
+boost::asio::awaitable<void> CostClassLimiter::acquire(CostClass cost_class, boost::asio::io_context& io_context) {
+    if (try_acquire(cost_class)) {
+        co_return;
+    }
+    co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(boost::system::error_code)>(
+        [this, cost_class, &io_context](auto&& self) {
+            auto cancellation_slot = self.get_cancellation_state().slot();
+            auto shared_self = std::make_shared<std::decay_t<decltype(self)>>(std::move(self));
+            const std::lock_guard<std::mutex> lock(access_);
+            auto& state = classes_[static_cast<std::size_t>(cost_class)];
+            // A slot may have been released since the first attempt
+            if (try_acquire_unlocked(state)) {
+                boost::asio::post(io_context, [shared_self]() mutable { shared_self->complete({}); });
+                return;
+            }
+            const auto waiter_id = next_waiter_id_++;
+            state.waiters.push_back({waiter_id, [&io_context, shared_self](boost::system::error_code ec) {
+                boost::asio::post(io_context, [shared_self, ec]() mutable { shared_self->complete(ec); });
+            }});
+            ++total_queue_depth_;
+            if (cancellation_slot.is_connected()) {
+                cancellation_slot.assign([this, cost_class, waiter_id](boost::asio::cancellation_type /*type*/) {
+                    cancel_waiter(cost_class, waiter_id);
+                });
+            }
+            ++state.queued_count;
+            if (state.waiters.size() > state.max_queue_depth) {
+                state.max_queue_depth = state.waiters.size();
+            }
+        },
+        boost::asio::use_awaitable);
+}
+
+bool CostClassLimiter::try_acquire(CostClass cost_class) {
+    const std::lock_guard<std::mutex> lock(access_);
+    return try_acquire_unlocked(classes_[static_cast<std::size_t>(cost_class)]);
+}
+
+void CostClassLimiter::release(CostClass cost_class) {
+    std::function<void(boost::system::error_code)> resume;
+    {
+        const std::lock_guard<std::mutex> lock(access_);
+        auto& state = classes_[static_cast<std::size_t>(cost_class)];
+        if (state.waiters.empty()) {
+            --state.in_flight;
+            return;
+        }
+        // The slot passes directly to the first waiter, so in-flight count does not change
+        resume = std::move(state.waiters.front().resume);
+        state.waiters.pop_front();
+        --total_queue_depth_;
+    }
+    resume({});
+}
+
+std::size_t CostClassLimiter::in_flight(CostClass cost_class) const {
+    const std::lock_guard<std::mutex> lock(access_);
+    return classes_[static_cast<std::size_t>(cost_class)].in_flight;
+}
+
+std::size_t CostClassLimiter::queue_depth(CostClass cost_class) const {
+    const std::lock_guard<std::mutex> lock(access_);
+    return classes_[static_cast<std::size_t>(cost_class)].waiters.size();
+}
+
+std::size_t CostClassLimiter::max_queue_depth(CostClass cost_class) const {
+    const std::lock_guard<std::mutex> lock(access_);
+    return classes_[static_cast<std::size_t>(cost_class)].max_queue_depth;
+}
+
+uint64_t CostClassLimiter::queued_count(CostClass cost_class) const {
+    const std::lock_guard<std::mutex> lock(access_);
+    return classes_[static_cast<std::size_t>(cost_class)].queued_count;
+}
+
+bool CostClassLimiter::try_acquire_unlocked(ClassState& state) {
+    if (state.max_concurrency != 0 && state.in_flight >= state.max_concurrency) {
+        return false;
+    }
+    ++state.in_flight;
+    return true;
+}
+
+void CostClassLimiter::cancel_waiter(CostClass cost_class, uint64_t waiter_id) {
+    std::function<void(boost::system::error_code)> resume;
+    {
+        const std::lock_guard<std::mutex> lock(access_);
+        auto& waiters = classes_[static_cast<std::size_t>(cost_class)].waiters;
+        const auto it = std::find_if(waiters.begin(), waiters.end(), [&](const auto& waiter) { return waiter.id == waiter_id; });
+        if (it == waiters.end()) {
+            return;
+        }
+        resume = std::move(it->resume);
+        waiters.erase(it);
+        --total_queue_depth_;
+    }
+    resume(boost::asio::error::operation_aborted);
+}
+
+} // namespace silkrpc
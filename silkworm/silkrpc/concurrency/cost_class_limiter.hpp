@@ -0,0 +1,121 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include <silkworm/silkrpc/config.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/system/error_code.hpp>
+
+namespace silkrpc {
+
+//! The cost classes of the RPC methods, from the cheapest to the heaviest
+enum class CostClass : std::size_t {
+    light = 0,  // chain data lookups
+    evm = 1,    // single transaction execution (e.g. eth_call, eth_estimateGas)
+    trace = 2,  // block or transaction re-execution with tracing (e.g. debug_traceBlockByNumber, trace_filter)
+};
+
+constexpr std::size_t kCostClassCount{3};
+
+//! By default EVM and trace requests together cannot exceed the default number of workers, so trace traffic never starves eth_call
+const uint32_t kDefaultLightConcurrency = 0;
+const uint32_t kDefaultEvmConcurrency = 12;
+const uint32_t kDefaultTraceConcurrency = 4;
+
+//! Max number of requests of each cost class executing at the same time, zero means unlimited
+struct CostClassSettings {
+    uint32_t light_concurrency{kDefaultLightConcurrency};
+    uint32_t evm_concurrency{kDefaultEvmConcurrency};
+    uint32_t trace_concurrency{kDefaultTraceConcurrency};
+};
+
+//! Bound on the requests of each cost class executing at the same time, the exceeding ones wait in a FIFO queue
+class CostClassLimiter {
+public:
+    explicit CostClassLimiter(const CostClassSettings& settings = {});
+
+    CostClassLimiter(const CostClassLimiter&) = delete;
+    CostClassLimiter& operator=(const CostClassLimiter&) = delete;
+
+    //! Wait for a free execution slot in the given class, resuming on the given I/O context. A cancelled request leaves the queue
+    //! and throws operation_aborted without taking any slot
+    boost::asio::awaitable<void> acquire(CostClass cost_class, boost::asio::io_context& io_context);
+
+    //! Take a free execution slot in the given class without waiting: return false if none is available
+    bool try_acquire(CostClass cost_class);
+
+    //! Give the execution slot back, handing it over to the first waiting request if any
+    void release(CostClass cost_class);
+
+    std::size_t in_flight(CostClass cost_class) const;
+    std::size_t queue_depth(CostClass cost_class) const;
+    std::size_t max_queue_depth(CostClass cost_class) const;
+    uint64_t queued_count(CostClass cost_class) const;
+
+    //! Number of requests waiting in all the cost classes, readable without locking on the hot path
+    std::size_t total_queue_depth() const noexcept { return total_queue_depth_; }
+
+private:
+    struct Waiter {
+        uint64_t id;
+        std::function<void(boost::system::error_code)> resume;
+    };
+
+    struct ClassState {
+        std::size_t max_concurrency{0};
+        std::size_t in_flight{0};
+        std::deque<Waiter> waiters;
+        std::size_t max_queue_depth{0};
+        uint64_t queued_count{0};
+    };
+
+    bool try_acquire_unlocked(ClassState& state);
+
+    //! Resume the given waiter with operation_aborted, unless it has already been handed a slot
+    void cancel_waiter(CostClass cost_class, uint64_t waiter_id);
+
+    mutable std::mutex access_;
+    std::array<ClassState, kCostClassCount> classes_;
+    uint64_t next_waiter_id_{0};
+    std::atomic_size_t total_queue_depth_{0};
+};
+
+//! The execution slot held by one request in its cost class, released on destruction
+class CostClassPermit {
+public:
+    CostClassPermit(CostClassLimiter& limiter, CostClass cost_class) : limiter_(limiter), cost_class_(cost_class) {}
+    ~CostClassPermit() { limiter_.release(cost_class_); }
+
+    CostClassPermit(const CostClassPermit&) = delete;
+    CostClassPermit& operator=(const CostClassPermit&) = delete;
+
+private:
+    CostClassLimiter& limiter_;
+    CostClass cost_class_;
+};
+
+} // namespace silkrpc
@@ -0,0 +1,127 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "cost_class_limiter.hpp"
+
+#include <exception>
+#include <optional>
+#include <vector>
+
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/system/system_error.hpp>
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+TEST_CASE("cost class limiter", "[silkrpc][concurrency][cost_class_limiter]") {
+    CostClassLimiter limiter{CostClassSettings{.light_concurrency = 0, .evm_concurrency = 2, .trace_concurrency = 1}};
+
+    SECTION("unlimited class") {
+        for (int i{0}; i < 100; ++i) {
+            CHECK(limiter.try_acquire(CostClass::light));
+        }
+        CHECK(limiter.in_flight(CostClass::light) == 100);
+    }
+
+    SECTION("limited class") {
+        CHECK(limiter.try_acquire(CostClass::evm));
+        CHECK(limiter.try_acquire(CostClass::evm));
+        CHECK(!limiter.try_acquire(CostClass::evm));
+        CHECK(limiter.try_acquire(CostClass::trace));
+        limiter.release(CostClass::evm);
+        CHECK(limiter.in_flight(CostClass::evm) == 1);
+        CHECK(limiter.try_acquire(CostClass::evm));
+    }
+
+    SECTION("waiting requests resumed in FIFO order") {
+        boost::asio::io_context io_context;
+        std::vector<int> executed;
+        std::optional<CostClassPermit> first_permit;
+        REQUIRE(limiter.try_acquire(CostClass::trace));
+        first_permit.emplace(limiter, CostClass::trace);
+
+        const auto request = [&](int id) -> boost::asio::awaitable<void> {
+            co_await limiter.acquire(CostClass::trace, io_context);
+            CostClassPermit permit{limiter, CostClass::trace};
+            executed.push_back(id);
+        };
+        boost::asio::co_spawn(io_context, request(1), boost::asio::detached);
+        boost::asio::co_spawn(io_context, request(2), boost::asio::detached);
+        // Waiting requests keep the context busy, so just run the ready handlers
+        io_context.poll();
+        io_context.restart();
+        CHECK(executed.empty());
+        CHECK(limiter.queue_depth(CostClass::trace) == 2);
+        CHECK(limiter.max_queue_depth(CostClass::trace) == 2);
+        CHECK(limiter.queued_count(CostClass::trace) == 2);
+        CHECK(limiter.total_queue_depth() == 2);
+
+        first_permit.reset();
+        io_context.run();
+        CHECK(executed == std::vector<int>{1, 2});
+        CHECK(limiter.queue_depth(CostClass::trace) == 0);
+        CHECK(limiter.total_queue_depth() == 0);
+        CHECK(limiter.in_flight(CostClass::trace) == 0);
+        CHECK(limiter.in_flight(CostClass::evm) == 0);
+    }
+
+    SECTION("cancelled waiting request leaves the queue") {
+        boost::asio::io_context io_context;
+        std::vector<int> executed;
+        std::optional<CostClassPermit> first_permit;
+        REQUIRE(limiter.try_acquire(CostClass::trace));
+        first_permit.emplace(limiter, CostClass::trace);
+
+        const auto request = [&](int id) -> boost::asio::awaitable<void> {
+            co_await limiter.acquire(CostClass::trace, io_context);
+            CostClassPermit permit{limiter, CostClass::trace};
+            executed.push_back(id);
+        };
+        boost::asio::cancellation_signal cancellation_signal;
+        std::exception_ptr cancelled_error;
+        boost::asio::co_spawn(io_context, request(1),
+            boost::asio::bind_cancellation_slot(cancellation_signal.slot(), [&](std::exception_ptr error) { cancelled_error = error; }));
+        boost::asio::co_spawn(io_context, request(2), boost::asio::detached);
+        io_context.poll();
+        io_context.restart();
+        CHECK(limiter.queue_depth(CostClass::trace) == 2);
+
+        cancellation_signal.emit(boost::asio::cancellation_type::terminal);
+        io_context.poll();
+        io_context.restart();
+        CHECK(limiter.queue_depth(CostClass::trace) == 1);
+        CHECK(limiter.total_queue_depth() == 1);
+        REQUIRE(cancelled_error);
+        try {
+            std::rethrow_exception(cancelled_error);
+        } catch (const boost::system::system_error& se) {
+            CHECK(se.code() == boost::asio::error::operation_aborted);
+        }
+
+        first_permit.reset();
+        io_context.run();
+        CHECK(executed == std::vector<int>{2});
+        CHECK(limiter.queue_depth(CostClass::trace) == 0);
+        CHECK(limiter.in_flight(CostClass::trace) == 0);
+    }
+}
+
+} // namespace silkrpc
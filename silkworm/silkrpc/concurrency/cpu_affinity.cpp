@@ -0,0 +1,112 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "cpu_affinity.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <atomic>
+#include <latch>
+#include <memory>
+#include <stdexcept>
+
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_split.h>
+#include <boost/asio/post.hpp>
+
+#include <silkworm/silkrpc/common/log.hpp>
+
+namespace silkrpc {
+
+static int parse_cpu(absl::string_view text) {
+    int cpu{0};
+    if (!absl::SimpleAtoi(text, &cpu) || cpu < 0) {
+        throw std::invalid_argument{"invalid CPU: " + std::string{text}};
+    }
+    return cpu;
+}
+
+CpuList parse_cpu_list(const std::string& text) {
+    CpuList cpus;
+    if (text.empty()) {
+        return cpus;
+    }
+    for (const auto range : absl::StrSplit(text, ',')) {
+        const std::vector<absl::string_view> bounds = absl::StrSplit(range, absl::MaxSplits('-', 1));
+        const int first = parse_cpu(bounds[0]);
+        const int last = bounds.size() == 2 ? parse_cpu(bounds[1]) : first;
+        if (last < first) {
+            throw std::invalid_argument{"invalid CPU range: " + std::string{range}};
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+std::optional<std::pair<int, int>> ContextAffinity::context_cpus(std::size_t index) const {
+    if (cpus.empty()) {
+        return std::nullopt;
+    }
+    if (pair_cpus) {
+        return std::make_pair(cpus[(2 * index) % cpus.size()], cpus[(2 * index + 1) % cpus.size()]);
+    }
+    const int cpu = cpus[index % cpus.size()];
+    return std::make_pair(cpu, cpu);
+}
+
+bool pin_current_thread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    const int result = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (result != 0) {
+        SILKRPC_WARN << "pin_current_thread cannot pin to CPU " << cpu << " error: " << result << "\n";
+        return false;
+    }
+    return true;
+#else
+    SILKRPC_WARN << "pin_current_thread CPU pinning not supported on this platform\n";
+    return false;
+#endif
+}
+
+void pin_thread_pool(boost::asio::thread_pool& pool, std::size_t num_threads, const CpuList& cpus) {
+    if (cpus.empty() || num_threads == 0) {
+        return;
+    }
+    // Each task blocks until all have arrived, so that every pool thread runs exactly one of them
+    auto all_pinned = std::make_shared<std::latch>(static_cast<std::ptrdiff_t>(num_threads + 1));
+    auto next_index = std::make_shared<std::atomic_size_t>(0);
+    for (std::size_t i{0}; i < num_threads; ++i) {
+        boost::asio::post(pool, [all_pinned, next_index, &cpus]() {
+            const auto index = next_index->fetch_add(1);
+            pin_current_thread(cpus[index % cpus.size()]);
+            all_pinned->arrive_and_wait();
+        });
+    }
+    all_pinned->arrive_and_wait();
+}
+
+} // namespace silkrpc
@@ -0,0 +1,52 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/thread_pool.hpp>
+
+namespace silkrpc {
+
+//! The list of CPU identifiers threads are pinned to, empty meaning no pinning
+using CpuList = std::vector<int>;
+
+//! Parse a CPU list like "0-3,8,10-11", the empty string meaning no pinning
+CpuList parse_cpu_list(const std::string& text);
+
+//! Placement of the execution context threads on the CPUs
+struct ContextAffinity {
+    //! CPUs assigned in round-robin to the contexts, empty meaning no pinning
+    CpuList cpus;
+    //! Assign two consecutive CPUs to each context: one for io_context and one for GrpcContext, otherwise both share one CPU
+    bool pair_cpus{false};
+
+    //! The CPUs of io_context and GrpcContext for the context at the given index, if any
+    std::optional<std::pair<int, int>> context_cpus(std::size_t index) const;
+};
+
+//! Pin the calling thread to the given CPU, return false if not supported or not permitted
+bool pin_current_thread(int cpu);
+
+//! Pin each thread of the pool to one of the CPUs in round-robin, waiting until all of them are pinned
+void pin_thread_pool(boost::asio::thread_pool& pool, std::size_t num_threads, const CpuList& cpus);
+
+} // namespace silkrpc
@@ -0,0 +1,82 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "cpu_affinity.hpp"
+
+#include <stdexcept>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+TEST_CASE("parse_cpu_list", "[silkrpc][concurrency][cpu_affinity]") {
+    SECTION("empty list") {
+        CHECK(parse_cpu_list("").empty());
+    }
+
+    SECTION("single CPUs") {
+        CHECK(parse_cpu_list("3") == CpuList{3});
+        CHECK(parse_cpu_list("0,2,4") == CpuList{0, 2, 4});
+    }
+
+    SECTION("ranges") {
+        CHECK(parse_cpu_list("0-3") == CpuList{0, 1, 2, 3});
+        CHECK(parse_cpu_list("0-1,8,10-11") == CpuList{0, 1, 8, 10, 11});
+    }
+
+    SECTION("invalid lists") {
+        CHECK_THROWS_AS(parse_cpu_list("a"), std::invalid_argument);
+        CHECK_THROWS_AS(parse_cpu_list("1,"), std::invalid_argument);
+        CHECK_THROWS_AS(parse_cpu_list("-1"), std::invalid_argument);
+        CHECK_THROWS_AS(parse_cpu_list("3-1"), std::invalid_argument);
+        CHECK_THROWS_AS(parse_cpu_list("1-2-3"), std::invalid_argument);
+    }
+}
+
+TEST_CASE("ContextAffinity::context_cpus", "[silkrpc][concurrency][cpu_affinity]") {
+    SECTION("no pinning") {
+        ContextAffinity affinity;
+        CHECK(!affinity.context_cpus(0));
+    }
+
+    SECTION("one CPU per context") {
+        ContextAffinity affinity{{4, 5, 6}, false};
+        CHECK(affinity.context_cpus(0) == std::make_pair(4, 4));
+        CHECK(affinity.context_cpus(2) == std::make_pair(6, 6));
+        CHECK(affinity.context_cpus(3) == std::make_pair(4, 4));
+    }
+
+    SECTION("CPU pair per context") {
+        ContextAffinity affinity{{0, 1, 2, 3}, true};
+        CHECK(affinity.context_cpus(0) == std::make_pair(0, 1));
+        CHECK(affinity.context_cpus(1) == std::make_pair(2, 3));
+        CHECK(affinity.context_cpus(2) == std::make_pair(0, 1));
+    }
+}
+
+TEST_CASE("pin_current_thread", "[silkrpc][concurrency][cpu_affinity]") {
+    CHECK(!pin_current_thread(-1));
+}
+
+TEST_CASE("pin_thread_pool", "[silkrpc][concurrency][cpu_affinity]") {
+    boost::asio::thread_pool pool{2};
+    CHECK_NOTHROW(pin_thread_pool(pool, 2, CpuList{0}));
+    CHECK_NOTHROW(pin_thread_pool(pool, 2, CpuList{}));
+    pool.join();
+}
+
+} // namespace silkrpc
@@ -0,0 +1,66 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "io_backend.hpp"
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace silkrpc {
+
+std::string_view io_backend_name() noexcept {
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    return "io_uring";
+#elif defined(BOOST_ASIO_HAS_EPOLL)
+    return "epoll";
+#elif defined(BOOST_ASIO_HAS_KQUEUE)
+    return "kqueue";
+#elif defined(BOOST_ASIO_HAS_IOCP)
+    return "iocp";
+#else
+    return "select";
+#endif
+}
+
+bool io_backend_is_io_uring() noexcept {
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool io_uring_supported() noexcept {
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+    // Probe by setting up the smallest ring: it fails on old kernels or when io_uring is disabled (e.g. by seccomp)
+    io_uring_params params{};
+    const auto ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, 1, &params));
+    if (ring_fd < 0) {
+        return false;
+    }
+    ::close(ring_fd);
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace silkrpc
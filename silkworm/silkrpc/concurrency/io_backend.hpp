@@ -0,0 +1,32 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <string_view>
+
+namespace silkrpc {
+
+//! The name of the asynchronous I/O backend used by io_context, chosen at build time (see SILKRPC_USE_IO_URING)
+std::string_view io_backend_name() noexcept;
+
+//! Check if the io_context backend is io_uring
+bool io_backend_is_io_uring() noexcept;
+
+//! Check if the running kernel supports io_uring, whatever the backend
+bool io_uring_supported() noexcept;
+
+} // namespace silkrpc
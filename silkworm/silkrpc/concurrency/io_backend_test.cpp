@@ -0,0 +1,38 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "io_backend.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+TEST_CASE("io_backend_name", "[silkrpc][concurrency][io_backend]") {
+    const auto name = io_backend_name();
+    CHECK(!name.empty());
+    CHECK(io_backend_is_io_uring() == (name == "io_uring"));
+}
+
+TEST_CASE("io_uring_supported", "[silkrpc][concurrency][io_backend]") {
+    // The io_uring backend cannot run unless the kernel supports it
+    if (io_backend_is_io_uring()) {
+        CHECK(io_uring_supported());
+    } else {
+        CHECK_NOTHROW(io_uring_supported());
+    }
+}
+
+} // namespace silkrpc
@@ -16,12 +16,48 @@
 
 #include "wait_strategy.hpp"
 
+#include <chrono>
+#include <cstddef>
 #include <utility>
 
 #include <absl/strings/str_cat.h>
 
 namespace silkrpc {
 
+static int64_t steady_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+AdaptiveWaitStrategy::AdaptiveWaitStrategy() : state_start_ns_{steady_now_ns()} {}
+
+std::chrono::nanoseconds AdaptiveWaitStrategy::time_in_state(State state) const {
+    auto elapsed_ns = state_elapsed_ns_[static_cast<std::size_t>(state)].load(std::memory_order_relaxed);
+    if (state == state_.load(std::memory_order_relaxed)) {
+        elapsed_ns += steady_now_ns() - state_start_ns_.load(std::memory_order_relaxed);
+    }
+    return std::chrono::nanoseconds{elapsed_ns};
+}
+
+void AdaptiveWaitStrategy::transition(State next) {
+    const auto now_ns = steady_now_ns();
+    const auto current = state_.load(std::memory_order_relaxed);
+    state_elapsed_ns_[static_cast<std::size_t>(current)] += now_ns - state_start_ns_.load(std::memory_order_relaxed);
+    state_start_ns_.store(now_ns, std::memory_order_relaxed);
+    state_.store(next, std::memory_order_relaxed);
+    ++transitions_;
+    idle_polls_ = 0;
+    busy_polls_ = 0;
+}
+
+std::ostream& operator<<(std::ostream& out, AdaptiveWaitStrategy::State state) {
+    switch (state) {
+        case AdaptiveWaitStrategy::State::spinning: out << "spinning"; break;
+        case AdaptiveWaitStrategy::State::yielding: out << "yielding"; break;
+        case AdaptiveWaitStrategy::State::sleeping: out << "sleeping"; break;
+    }
+    return out;
+}
+
 bool AbslParseFlag(absl::string_view text, WaitMode* wait_mode, std::string* error) {
     if (text == "backoff") {
         *wait_mode = WaitMode::backoff;
@@ -47,6 +83,10 @@ bool AbslParseFlag(absl::string_view text, WaitMode* wait_mode, std::string* err
         *wait_mode = WaitMode::busy_spin;
         return true;
     }
+    if (text == "adaptive") {
+        *wait_mode = WaitMode::adaptive;
+        return true;
+    }
     *error = "unknown value for WaitMode";
     return false;
 }
@@ -59,6 +99,7 @@ std::string AbslUnparseFlag(WaitMode wait_mode) {
         case WaitMode::yielding: return "yielding";
         case WaitMode::spin_wait: return "spin_wait";
         case WaitMode::busy_spin: return "busy_spin";
+        case WaitMode::adaptive: return "adaptive";
         default: return absl::StrCat(wait_mode);
     }
 }
@@ -36,9 +36,14 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <ostream>
 #include <string>
 #include <thread>
 
@@ -46,7 +51,7 @@
 
 namespace silkrpc {
 
-// These wait strategies are experimental for performance tests and not yet production-ready.
+// These wait strategies are experimental for performance tests and not yet production-ready, except AdaptiveWaitStrategy.
 
 class SleepingWaitStrategy {
   public:
@@ -147,13 +152,94 @@ class BusySpinWaitStrategy {
     }
 };
 
+//! Wait strategy moving between spinning, yielding and sleeping depending on the recent work counts.
+//! Idle streaks step it down one state at a time, while any work wakes it up from sleeping at once: promotion to
+//! spinning requires a busy streak, so that sporadic work does not keep the core spinning (hysteresis).
+class AdaptiveWaitStrategy {
+  public:
+    enum class State : uint8_t {
+        spinning,
+        yielding,
+        sleeping
+    };
+
+    //! Number of consecutive idle polls before stepping down from spinning to yielding
+    inline static const uint32_t kIdlePollsToYield{1'000};
+    //! Number of consecutive idle polls before stepping down from yielding to sleeping
+    inline static const uint32_t kIdlePollsToSleep{10'000};
+    //! Number of consecutive busy polls before stepping up from yielding to spinning
+    inline static const uint32_t kBusyPollsToSpin{64};
+
+    AdaptiveWaitStrategy();
+
+    AdaptiveWaitStrategy(const AdaptiveWaitStrategy&) = delete;
+    AdaptiveWaitStrategy& operator=(const AdaptiveWaitStrategy&) = delete;
+
+    inline void idle(int work_count) {
+        const auto state = state_.load(std::memory_order_relaxed);
+        if (work_count > 0) {
+            idle_polls_ = 0;
+            ++busy_polls_;
+            if (state == State::sleeping) {
+                transition(State::yielding);
+            } else if (state == State::yielding && busy_polls_ >= kBusyPollsToSpin) {
+                transition(State::spinning);
+            }
+            return;
+        }
+
+        busy_polls_ = 0;
+        ++idle_polls_;
+        switch (state) {
+            case State::spinning:
+                if (idle_polls_ >= kIdlePollsToYield) {
+                    transition(State::yielding);
+                }
+            break;
+            case State::yielding:
+                std::this_thread::yield();
+                if (idle_polls_ >= kIdlePollsToSleep) {
+                    transition(State::sleeping);
+                }
+            break;
+            case State::sleeping:
+                std::this_thread::sleep_for(kSleepDuration);
+            break;
+        }
+    }
+
+    //! The current state, safe to read from any thread
+    State state() const noexcept { return state_.load(std::memory_order_relaxed); }
+
+    //! The total time spent in the given state so far, safe to read from any thread
+    std::chrono::nanoseconds time_in_state(State state) const;
+
+    //! The number of state transitions so far
+    uint64_t transitions() const noexcept { return transitions_.load(std::memory_order_relaxed); }
+
+  private:
+    void transition(State next);
+
+    inline static const std::chrono::milliseconds kSleepDuration{1};
+
+    std::atomic<State> state_{State::spinning};
+    std::atomic_int64_t state_start_ns_;
+    std::array<std::atomic_int64_t, 3> state_elapsed_ns_{};
+    std::atomic_uint64_t transitions_{0};
+    uint32_t idle_polls_{0};
+    uint32_t busy_polls_{0};
+};
+
+std::ostream& operator<<(std::ostream& out, AdaptiveWaitStrategy::State state);
+
 enum class WaitMode {
     backoff,    /* Wait strategy implemented in asio-grpc's agrpc::run */
     blocking,   /* Custom multi-thread wait strategy implemented here */
     sleeping,   /* Custom single-thread wait strategies implemented here */
     yielding,
     spin_wait,
-    busy_spin
+    busy_spin,
+    adaptive    /* Custom single-thread wait strategy switching among spinning, yielding and sleeping */
 };
 
 bool AbslParseFlag(absl::string_view text, WaitMode* wait_mode, std::string* error);
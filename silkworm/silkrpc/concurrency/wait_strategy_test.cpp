@@ -22,6 +22,9 @@
 #include <thread>
 #include <vector>
 
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <catch2/catch.hpp>
 #include <grpcpp/grpcpp.h>
 
@@ -35,7 +38,7 @@ using Catch::Matchers::Message;
 
 TEST_CASE("parse wait mode", "[silkrpc][common][log]") {
     std::vector<absl::string_view> input_texts{
-        "backoff", "blocking", "sleeping", "yielding", "spin_wait", "busy_spin"
+        "backoff", "blocking", "sleeping", "yielding", "spin_wait", "busy_spin", "adaptive"
     };
     std::vector<WaitMode> expected_wait_modes{
         WaitMode::backoff,
@@ -44,6 +47,7 @@ TEST_CASE("parse wait mode", "[silkrpc][common][log]") {
         WaitMode::yielding,
         WaitMode::spin_wait,
         WaitMode::busy_spin,
+        WaitMode::adaptive,
     };
     for (auto i{0}; i < input_texts.size(); i++) {
         WaitMode wait_mode;
@@ -71,9 +75,10 @@ TEST_CASE("unparse wait mode", "[silkrpc][common][log]") {
         WaitMode::yielding,
         WaitMode::spin_wait,
         WaitMode::busy_spin,
+        WaitMode::adaptive,
     };
     std::vector<absl::string_view> expected_texts{
-        "backoff", "blocking", "sleeping", "yielding", "spin_wait", "busy_spin"
+        "backoff", "blocking", "sleeping", "yielding", "spin_wait", "busy_spin", "adaptive"
     };
     for (auto i{0}; i < input_wait_modes.size(); i++) {
         const auto text{AbslUnparseFlag(input_wait_modes[i])};
@@ -119,4 +124,129 @@ TEST_CASE("BusySpinWaitStrategy", "[silkrpc][context_pool]") {
     sleep_then_check_wait(wait_strategy, 10ms, 1);
 }
 
+TEST_CASE("AdaptiveWaitStrategy", "[silkrpc][context_pool]") {
+    using State = AdaptiveWaitStrategy::State;
+    AdaptiveWaitStrategy wait_strategy;
+    sleep_then_check_wait(wait_strategy, 10ms, 1);
+    sleep_then_check_wait(wait_strategy, 20ms, 0);
+    sleep_then_check_wait(wait_strategy, 10ms, 1);
+
+    SECTION("start spinning") {
+        CHECK(wait_strategy.state() == State::spinning);
+        CHECK(wait_strategy.transitions() == 0);
+    }
+
+    SECTION("step down to sleeping when idle") {
+        for (uint32_t i{0}; i < AdaptiveWaitStrategy::kIdlePollsToYield; ++i) {
+            wait_strategy.idle(0);
+        }
+        CHECK(wait_strategy.state() == State::yielding);
+        for (uint32_t i{0}; i < AdaptiveWaitStrategy::kIdlePollsToSleep; ++i) {
+            wait_strategy.idle(0);
+        }
+        CHECK(wait_strategy.state() == State::sleeping);
+        CHECK(wait_strategy.transitions() == 2);
+        CHECK(wait_strategy.time_in_state(State::spinning) >= 10ms);
+        CHECK(wait_strategy.time_in_state(State::yielding) > 0ns);
+
+        // Each idle poll while sleeping lasts at least the sleep duration of 1ms
+        const uint32_t kSleepingPolls{10};
+        for (uint32_t i{0}; i < kSleepingPolls; ++i) {
+            wait_strategy.idle(0);
+        }
+        CHECK(wait_strategy.time_in_state(State::sleeping) >= kSleepingPolls * 1ms);
+
+        // Any work wakes it up, but spinning again requires a busy streak
+        wait_strategy.idle(1);
+        CHECK(wait_strategy.state() == State::yielding);
+        for (uint32_t i{1}; i < AdaptiveWaitStrategy::kBusyPollsToSpin; ++i) {
+            wait_strategy.idle(1);
+        }
+        CHECK(wait_strategy.state() == State::yielding);
+        wait_strategy.idle(1);
+        CHECK(wait_strategy.state() == State::spinning);
+        CHECK(wait_strategy.transitions() == 4);
+    }
+
+    SECTION("sporadic work does not step up to spinning") {
+        for (uint32_t i{0}; i < AdaptiveWaitStrategy::kIdlePollsToYield; ++i) {
+            wait_strategy.idle(0);
+        }
+        for (uint32_t i{0}; i < 100; ++i) {
+            wait_strategy.idle(1);
+            wait_strategy.idle(0);
+        }
+        CHECK(wait_strategy.state() == State::yielding);
+    }
+}
+
+//! Event loop polling an io_context on its own thread with the given wait strategy, like Context does
+template <typename WaitStrategy>
+class PollingLoop {
+  public:
+    explicit PollingLoop(WaitStrategy& wait_strategy)
+        : work_guard_{boost::asio::make_work_guard(io_context_)}, thread_{[&]() {
+            while (!stopped_) {
+                wait_strategy.idle(static_cast<int>(io_context_.poll()));
+            }
+        }} {}
+
+    ~PollingLoop() {
+        stopped_ = true;
+        thread_.join();
+    }
+
+    boost::asio::io_context& io_context() { return io_context_; }
+
+  private:
+    boost::asio::io_context io_context_;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard_;
+    std::atomic_bool stopped_{false};
+    std::thread thread_;
+};
+
+//! Post one handler to the loop and wait for its execution, i.e. the wake-up latency of the loop
+inline void round_trip(boost::asio::io_context& io_context) {
+    std::atomic_bool executed{false};
+    boost::asio::post(io_context, [&]() { executed = true; });
+    while (!executed) {
+        std::this_thread::yield();
+    }
+}
+
+template <typename WaitStrategy>
+void benchmark_round_trip(const std::string& name) {
+    WaitStrategy wait_strategy;
+    PollingLoop<WaitStrategy> loop{wait_strategy};
+    BENCHMARK("round trip busy " + name) {
+        round_trip(loop.io_context());
+    };
+    BENCHMARK("round trip after 2ms idle " + name) {
+        std::this_thread::sleep_for(2ms);
+        round_trip(loop.io_context());
+    };
+}
+
+TEST_CASE("wait strategy benchmark", "[.][silkrpc][concurrency][wait_strategy][benchmark]") {
+    benchmark_round_trip<BusySpinWaitStrategy>("busy_spin");
+    benchmark_round_trip<SpinWaitWaitStrategy>("spin_wait");
+    benchmark_round_trip<YieldingWaitStrategy>("yielding");
+    benchmark_round_trip<SleepingWaitStrategy>("sleeping");
+    benchmark_round_trip<AdaptiveWaitStrategy>("adaptive");
+
+    // The blocking mode runs the io_context waiting on its reactor
+    boost::asio::io_context io_context;
+    auto work_guard = boost::asio::make_work_guard(io_context);
+    std::thread blocking_thread{[&]() { io_context.run(); }};
+    BENCHMARK("round trip busy blocking") {
+        round_trip(io_context);
+    };
+    BENCHMARK("round trip after 2ms idle blocking") {
+        std::this_thread::sleep_for(2ms);
+        round_trip(io_context);
+    };
+    work_guard.reset();
+    blocking_thread.join();
+}
+
 } // namespace silkrpc
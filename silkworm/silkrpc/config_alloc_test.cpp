@@ -0,0 +1,118 @@
+/*
+   Copyright 2021 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+// The same tests are built also with the default cache size of asio, in order to compare the allocations it saves
+#ifdef SILKRPC_ALLOC_TEST_DEFAULT_CACHE
+#undef BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
+#endif
+
+#include "config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <catch2/catch.hpp>
+
+#include <silkworm/silkrpc/test/allocation_count.hpp>
+
+namespace silkrpc {
+
+#ifdef BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
+constexpr std::size_t kRecyclingCacheSize{BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE};
+#else
+constexpr std::size_t kRecyclingCacheSize{2};  // asio default
+#endif
+
+//! The shape of the awaitable chain of one request: nesting depth and number of cursor operations at the bottom
+struct RequestShape {
+    std::string name;
+    std::size_t depth;
+    std::size_t cursor_ops;
+
+    std::size_t frames() const { return depth + 1 + cursor_ops; }
+};
+
+// handler -> transaction begin -> read_account -> get_latest/get_as_of -> cursor ops
+static const RequestShape kGetBalanceShape{"eth_getBalance", 4, 4};
+// handler -> block read -> EVM executor -> state reader -> ... -> cursor ops for accounts, code and storage
+static const RequestShape kCallShape{"eth_call", 8, 64};
+
+boost::asio::awaitable<uint64_t> cursor_op(uint64_t key) {
+    co_return key + 1;
+}
+
+boost::asio::awaitable<uint64_t> nested_call(std::size_t depth, std::size_t cursor_ops) {
+    if (depth == 0) {
+        uint64_t value{0};
+        for (uint64_t i{0}; i < cursor_ops; ++i) {
+            value += co_await cursor_op(i);
+        }
+        co_return value;
+    }
+    co_return co_await nested_call(depth - 1, cursor_ops);
+}
+
+boost::asio::awaitable<void> count_allocations(const RequestShape& shape, std::size_t num_requests, uint64_t& allocations) {
+    // The first request fills the per-thread recycling cache
+    co_await nested_call(shape.depth, shape.cursor_ops);
+    const auto start_count = test::allocation_count();
+    for (std::size_t i{0}; i < num_requests; ++i) {
+        co_await nested_call(shape.depth, shape.cursor_ops);
+    }
+    allocations = test::allocation_count() - start_count;
+}
+
+static uint64_t allocations_after_warm_up(const RequestShape& shape, std::size_t num_requests) {
+    uint64_t allocations{0};
+    boost::asio::io_context io_context;
+    boost::asio::co_spawn(io_context, count_allocations(shape, num_requests, allocations), boost::asio::detached);
+    io_context.run();
+    return allocations;
+}
+
+TEST_CASE("check awaitable frame recycling", "[silkrpc][config]") {
+    const std::size_t kNumRequests{100};
+    for (const auto& shape : {kGetBalanceShape, kCallShape}) {
+        const auto allocations = allocations_after_warm_up(shape, kNumRequests);
+        WARN(shape.name << "-like request: " << shape.frames() << " awaitable frames, " << allocations / kNumRequests
+             << " global allocations with recycling cache size " << kRecyclingCacheSize);
+#ifdef SILKRPC_ALLOC_TEST_DEFAULT_CACHE
+        // The default cache holds too few frames for the awaitable chains of one request, which keep allocating
+        CHECK(allocations >= kNumRequests);
+#else
+        // Once warmed up, the recycling cache holds all the frames nested at the same time, so no request allocates anymore
+        CHECK(allocations == 0);
+#endif
+    }
+}
+
+TEST_CASE("awaitable frame recycling benchmark", "[.][silkrpc][config][benchmark]") {
+    for (const auto& shape : {kGetBalanceShape, kCallShape}) {
+        boost::asio::io_context io_context;
+        BENCHMARK(shape.name + "-like request") {
+            boost::asio::co_spawn(io_context, nested_call(shape.depth, shape.cursor_ops), boost::asio::detached);
+            io_context.restart();
+            return io_context.run();
+        };
+    }
+}
+
+} // namespace silkrpc
@@ -16,12 +16,57 @@
 
 #include "cached_chain.hpp"
 
+#include <vector>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
 #include <silkworm/silkrpc/core/blocks.hpp>
 #include <silkworm/silkrpc/core/rawdb/chain.hpp>
 
 namespace silkrpc::core {
 
-boost::asio::awaitable<silkworm::BlockWithHash> read_block_by_number(BlockCache& cache, const rawdb::DatabaseReader& reader, uint64_t block_number) {
+// Max number of senders recovered by a single worker task
+const std::size_t kSenderRecoveryBatchSize = 32;
+
+static boost::asio::awaitable<void> recover_senders(boost::asio::thread_pool& workers, const std::vector<silkworm::Transaction*>& transactions,
+                                                    std::size_t first, std::size_t count) {
+    using namespace boost::asio::experimental::awaitable_operators;
+    if (count <= kSenderRecoveryBatchSize) {
+        co_await boost::asio::co_spawn(workers, [&]() -> boost::asio::awaitable<void> {
+            for (std::size_t i{first}; i < first + count; ++i) {
+                transactions[i]->recover_sender();
+            }
+            co_return;
+        }, boost::asio::use_awaitable);
+        co_return;
+    }
+    const auto half = count / 2;
+    co_await (recover_senders(workers, transactions, first, half) && recover_senders(workers, transactions, first + half, count - half));
+}
+
+// Senders missing from the database are recovered once, before the block is shared through the cache
+static boost::asio::awaitable<void> recover_missing_senders(silkworm::BlockWithHash& block_with_hash, boost::asio::thread_pool* workers) {
+    std::vector<silkworm::Transaction*> transactions;
+    for (auto& transaction : block_with_hash.block.transactions) {
+        if (!transaction.from) {
+            transactions.push_back(&transaction);
+        }
+    }
+    if (transactions.empty()) {
+        co_return;
+    }
+    if (workers == nullptr) {
+        for (auto transaction : transactions) {
+            transaction->recover_sender();
+        }
+        co_return;
+    }
+    co_await recover_senders(*workers, transactions, 0, transactions.size());
+}
+
+boost::asio::awaitable<silkworm::BlockWithHash> read_block_by_number(BlockCache& cache, const rawdb::DatabaseReader& reader, uint64_t block_number, boost::asio::thread_pool* workers) {
     const auto block_hash = co_await rawdb::read_canonical_block_hash(reader, block_number);
     const auto cached_block = cache.get(block_hash);
     if (cached_block) {
@@ -31,12 +76,13 @@ boost::asio::awaitable<silkworm::BlockWithHash> read_block_by_number(BlockCache&
     if (block_with_hash.block.transactions.size() != 0) {
        // don't save empty (without txs) blocks to cache, if block become non-canonical (not in main chain), we remove it's transactions,
        // but block can in the future become canonical(inserted in main chain) with its transactions
+       co_await recover_missing_senders(block_with_hash, workers);
        cache.insert(block_hash, block_with_hash);
     }
     co_return block_with_hash;
 }
 
-boost::asio::awaitable<silkworm::BlockWithHash> read_block_by_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const evmc::bytes32& block_hash) {
+boost::asio::awaitable<silkworm::BlockWithHash> read_block_by_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const evmc::bytes32& block_hash, boost::asio::thread_pool* workers) {
     const auto cached_block = cache.get(block_hash);
     if (cached_block) {
         co_return cached_block.value();
@@ -45,38 +91,37 @@ boost::asio::awaitable<silkworm::BlockWithHash> read_block_by_hash(BlockCache& c
     if (block_with_hash.block.transactions.size() != 0) {
        // don't save empty (without txs) blocks to cache, if block become non-canonical (not in main chain), we remove it's transactions,
        // but block can in the future become canonical(inserted in main chain) with its transactions
+       co_await recover_missing_senders(block_with_hash, workers);
        cache.insert(block_hash, block_with_hash);
     }
     co_return block_with_hash;
 }
 
-boost::asio::awaitable<silkworm::BlockWithHash> read_block_by_number_or_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const silkrpc::BlockNumberOrHash& bnoh) {
+boost::asio::awaitable<silkworm::BlockWithHash> read_block_by_number_or_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const silkrpc::BlockNumberOrHash& bnoh, boost::asio::thread_pool* workers) {
     if (bnoh.is_number()) {
-        co_return co_await read_block_by_number(cache, reader, bnoh.number());
+        co_return co_await read_block_by_number(cache, reader, bnoh.number(), workers);
     } else if (bnoh.is_hash()) {
-        co_return co_await read_block_by_hash(cache, reader, bnoh.hash());
+        co_return co_await read_block_by_hash(cache, reader, bnoh.hash(), workers);
     } else if (bnoh.is_tag()) {
         auto [block_number, ignore] = co_await get_block_number(bnoh.tag(), reader, /*latest_required=*/false);
-        co_return co_await read_block_by_number(cache, reader, block_number);
+        co_return co_await read_block_by_number(cache, reader, block_number, workers);
     }
     throw std::runtime_error{"invalid block_number_or_hash value"};
 }
 
-boost::asio::awaitable<silkworm::BlockWithHash> read_block_by_transaction_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const evmc::bytes32& transaction_hash) {
+boost::asio::awaitable<silkworm::BlockWithHash> read_block_by_transaction_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const evmc::bytes32& transaction_hash, boost::asio::thread_pool* workers) {
     auto block_number = co_await rawdb::read_block_number_by_transaction_hash(reader, transaction_hash);
-    co_return co_await read_block_by_number(cache, reader, block_number);
+    co_return co_await read_block_by_number(cache, reader, block_number, workers);
 }
 
-boost::asio::awaitable<std::optional<silkrpc::TransactionWithBlock>> read_transaction_by_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const evmc::bytes32& transaction_hash) {
+boost::asio::awaitable<std::optional<silkrpc::TransactionWithBlock>> read_transaction_by_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const evmc::bytes32& transaction_hash, boost::asio::thread_pool* workers) {
     auto block_number = co_await rawdb::read_block_number_by_transaction_hash(reader, transaction_hash);
-    auto block_with_hash = co_await read_block_by_number(cache, reader, block_number);
-    const silkworm::ByteView tx_hash{transaction_hash.bytes, silkworm::kHashLength};
+    auto block_with_hash = co_await read_block_by_number(cache, reader, block_number, workers);
+    const auto transaction_hashes = cache.transaction_hashes(block_with_hash);
 
-    const auto transactions = block_with_hash.block.transactions;
+    const auto& transactions = block_with_hash.block.transactions;
     for (std::size_t idx{0}; idx < transactions.size(); idx++) {
-        auto ethash_hash{hash_of_transaction(transactions[idx])};
-        silkworm::ByteView hash_view{ethash_hash.bytes, silkworm::kHashLength};
-        if (tx_hash == hash_view) {
+        if ((*transaction_hashes)[idx] == transaction_hash) {
             const auto block_header = block_with_hash.block.header;
             co_return TransactionWithBlock{block_with_hash, transactions[idx], block_with_hash.hash, block_header.number, block_header.base_fee_per_gas, idx};
         }
@@ -0,0 +1,70 @@
+/*
+   Copyright 2020 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "cached_state.hpp"
+
+#include <mutex>
+
+#include <silkworm/silkrpc/core/rawdb/util.hpp>
+
+namespace silkrpc::state {
+
+std::optional<silkworm::Account> CachedState::read_account(const evmc::address& address) const noexcept {
+    {
+        std::shared_lock lock{access_};
+        const auto it = accounts_.find(address);
+        if (it != accounts_.end()) {
+            return it->second;
+        }
+    }
+    const std::lock_guard<std::mutex> base_lock{base_access_};
+    const auto account = base_.read_account(address);
+    std::unique_lock lock{access_};
+    return accounts_.try_emplace(address, account).first->second;
+}
+
+silkworm::ByteView CachedState::read_code(const evmc::bytes32& code_hash) const noexcept {
+    {
+        std::shared_lock lock{access_};
+        const auto it = code_.find(code_hash);
+        if (it != code_.end()) {
+            return it->second;
+        }
+    }
+    const std::lock_guard<std::mutex> base_lock{base_access_};
+    silkworm::Bytes code{base_.read_code(code_hash)};
+    std::unique_lock lock{access_};
+    // Map nodes are never erased, so the returned view stays valid for the cache lifetime
+    return code_.try_emplace(code_hash, std::move(code)).first->second;
+}
+
+evmc::bytes32 CachedState::read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept {
+    auto storage_key = composite_storage_key(address, incarnation, location.bytes);
+    {
+        std::shared_lock lock{access_};
+        const auto it = storage_.find(storage_key);
+        if (it != storage_.end()) {
+            return it->second;
+        }
+    }
+    const std::lock_guard<std::mutex> base_lock{base_access_};
+    const auto value = base_.read_storage(address, incarnation, location);
+    std::unique_lock lock{access_};
+    return storage_.try_emplace(std::move(storage_key), value).first->second;
+}
+
+} // namespace silkrpc::state
@@ -0,0 +1,124 @@
+/*
+   Copyright 2020 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+#include <silkworm/silkrpc/config.hpp> // NOLINT(build/include_order)
+
+#include <evmc/evmc.hpp>
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/state/state.hpp>
+#include <silkworm/core/types/account.hpp>
+
+namespace silkrpc::state {
+
+//! Thread-safe read-through cache on top of a base state, shared by concurrent executions on the same state
+//! Reads missing in cache are serialized because the base state runs on one database transaction
+class CachedState : public silkworm::State {
+public:
+    explicit CachedState(silkworm::State& base) : base_(base) {}
+
+    CachedState(const CachedState&) = delete;
+    CachedState& operator=(const CachedState&) = delete;
+
+    std::optional<silkworm::Account> read_account(const evmc::address& address) const noexcept override;
+
+    silkworm::ByteView read_code(const evmc::bytes32& code_hash) const noexcept override;
+
+    evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept override;
+
+    uint64_t previous_incarnation(const evmc::address& address) const noexcept override {
+        const std::lock_guard<std::mutex> base_lock{base_access_};
+        return base_.previous_incarnation(address);
+    }
+
+    std::optional<silkworm::BlockHeader> read_header(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override {
+        const std::lock_guard<std::mutex> base_lock{base_access_};
+        return base_.read_header(block_number, block_hash);
+    }
+
+    bool read_body(uint64_t block_number, const evmc::bytes32& block_hash, silkworm::BlockBody& out) const noexcept override {
+        const std::lock_guard<std::mutex> base_lock{base_access_};
+        return base_.read_body(block_number, block_hash, out);
+    }
+
+    std::optional<intx::uint256> total_difficulty(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override {
+        const std::lock_guard<std::mutex> base_lock{base_access_};
+        return base_.total_difficulty(block_number, block_hash);
+    }
+
+    evmc::bytes32 state_root_hash() const override {
+        const std::lock_guard<std::mutex> base_lock{base_access_};
+        return base_.state_root_hash();
+    }
+
+    uint64_t current_canonical_block() const override {
+        const std::lock_guard<std::mutex> base_lock{base_access_};
+        return base_.current_canonical_block();
+    }
+
+    std::optional<evmc::bytes32> canonical_hash(uint64_t block_number) const override {
+        const std::lock_guard<std::mutex> base_lock{base_access_};
+        return base_.canonical_hash(block_number);
+    }
+
+    void insert_block(const silkworm::Block& block, const evmc::bytes32& hash) override {}
+
+    void canonize_block(uint64_t block_number, const evmc::bytes32& block_hash) override {}
+
+    void decanonize_block(uint64_t block_number) override {}
+
+    void insert_receipts(uint64_t block_number, const std::vector<silkworm::Receipt>& receipts) override {}
+
+    void begin_block(uint64_t block_number) override {}
+
+    void update_account(
+        const evmc::address& address,
+        std::optional<silkworm::Account> initial,
+        std::optional<silkworm::Account> current) override {}
+
+    void update_account_code(
+        const evmc::address& address,
+        uint64_t incarnation,
+        const evmc::bytes32& code_hash,
+        silkworm::ByteView code) override {}
+
+    void update_storage(
+        const evmc::address& address,
+        uint64_t incarnation,
+        const evmc::bytes32& location,
+        const evmc::bytes32& initial,
+        const evmc::bytes32& current) override {}
+
+    void unwind_state_changes(uint64_t block_number) override {}
+
+private:
+    silkworm::State& base_;
+    mutable std::mutex base_access_;
+    mutable std::shared_mutex access_;
+    mutable std::map<evmc::address, std::optional<silkworm::Account>> accounts_;
+    mutable std::map<evmc::bytes32, silkworm::Bytes> code_;
+    mutable std::map<silkworm::Bytes, evmc::bytes32> storage_;
+};
+
+} // namespace silkrpc::state
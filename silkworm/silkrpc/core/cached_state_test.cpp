@@ -0,0 +1,72 @@
+/*
+   Copyright 2020 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "cached_state.hpp"
+
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+#include <silkworm/core/state/in_memory_state.hpp>
+
+namespace silkrpc::state {
+
+using evmc::literals::operator""_address, evmc::literals::operator""_bytes32;
+
+TEST_CASE("CachedState", "[silkrpc][core][cached_state]") {
+    const auto address{0xe0a2bd4258d2768837baa26a28fe71dc079f84c7_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto value{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32};
+    const auto code_hash{0x1111111111111111111111111111111111111111111111111111111111111111_bytes32};
+    const silkworm::Bytes code{0x60, 0x00};
+
+    silkworm::InMemoryState base;
+    silkworm::Account account{.nonce = 1, .balance = 100, .incarnation = 1};
+    base.update_account(address, std::nullopt, account);
+    base.update_storage(address, 1, location, evmc::bytes32{}, value);
+    base.update_account_code(address, 1, code_hash, code);
+
+    CachedState state{base};
+
+    SECTION("read through base state") {
+        CHECK(state.read_account(address) == account);
+        CHECK(state.read_storage(address, 1, location) == value);
+        CHECK(state.read_code(code_hash) == silkworm::ByteView{code});
+        CHECK(state.read_account(0x0000000000000000000000000000000000000001_address) == std::nullopt);
+    }
+
+    SECTION("serve reads from cache once warmed") {
+        CHECK(state.read_account(address) == account);
+        CHECK(state.read_storage(address, 1, location) == value);
+
+        silkworm::Account updated_account{.nonce = 2, .balance = 50, .incarnation = 1};
+        base.update_account(address, account, updated_account);
+        base.update_storage(address, 1, location, value, evmc::bytes32{});
+
+        CHECK(state.read_account(address) == account);
+        CHECK(state.read_storage(address, 1, location) == value);
+    }
+
+    SECTION("writes are ignored") {
+        silkworm::Account updated_account{.nonce = 2, .balance = 50, .incarnation = 1};
+        state.update_account(address, account, updated_account);
+        state.update_storage(address, 1, location, value, evmc::bytes32{});
+
+        CHECK(state.read_account(address) == account);
+        CHECK(state.read_storage(address, 1, location) == value);
+    }
+}
+
+} // namespace silkrpc::state
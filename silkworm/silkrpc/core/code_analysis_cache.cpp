@@ -0,0 +1,39 @@
+/*
+   Copyright 2020 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "code_analysis_cache.hpp"
+
+#include <silkworm/core/common/base.hpp>
+
+namespace silkrpc {
+
+CodeAnalysisCache& CodeAnalysisCache::instance() {
+    static CodeAnalysisCache analysis_cache;
+    return analysis_cache;
+}
+
+void CodeAnalysisCache::record_lookup(const evmc::bytes32& code_hash) {
+    if (code_hash == silkworm::kEmptyHash) {
+        return;
+    }
+    if (analyses_.get_as_copy(code_hash)) {
+        ++hit_count_;
+    } else {
+        ++miss_count_;
+    }
+}
+
+} // namespace silkrpc
@@ -0,0 +1,65 @@
+/*
+   Copyright 2020 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <silkworm/silkrpc/config.hpp> // NOLINT(build/include_order)
+
+#include <evmc/evmc.hpp>
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wattributes"
+#include <silkworm/core/execution/evm.hpp>
+#pragma GCC diagnostic pop
+
+namespace silkrpc {
+
+const std::size_t kDefaultCodeAnalysisCacheSize = 5'000;
+
+//! Process-wide cache of evmone code analyses keyed by code hash, shared by all the EVM executors
+class CodeAnalysisCache {
+public:
+    //! The unique instance shared by all the executors
+    static CodeAnalysisCache& instance();
+
+    explicit CodeAnalysisCache(std::size_t max_size = kDefaultCodeAnalysisCacheSize) : analyses_{max_size, /*thread_safe=*/true} {}
+
+    CodeAnalysisCache(const CodeAnalysisCache&) = delete;
+    CodeAnalysisCache& operator=(const CodeAnalysisCache&) = delete;
+
+    //! Make the given EVM look up and store the analyses of executed code in this cache
+    void attach(silkworm::EVM& evm) noexcept { evm.analysis_cache = &analyses_; }
+
+    //! Return the analysis of the given code, if already available
+    auto get(const evmc::bytes32& code_hash) { return analyses_.get_as_copy(code_hash); }
+
+    //! Record whether the analysis of the code about to be executed is already available
+    void record_lookup(const evmc::bytes32& code_hash);
+
+    std::size_t size() const noexcept { return analyses_.size(); }
+    uint64_t hit_count() const noexcept { return hit_count_; }
+    uint64_t miss_count() const noexcept { return miss_count_; }
+
+private:
+    silkworm::AnalysisCache analyses_;
+    std::atomic_uint64_t hit_count_{0};
+    std::atomic_uint64_t miss_count_{0};
+};
+
+} // namespace silkrpc
@@ -0,0 +1,57 @@
+/*
+   Copyright 2020 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "code_analysis_cache.hpp"
+
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+#include <silkworm/core/common/base.hpp>
+
+namespace silkrpc {
+
+using evmc::literals::operator""_bytes32;
+
+TEST_CASE("code analysis cache") {
+    CodeAnalysisCache analysis_cache{4};
+
+    SECTION("empty cache") {
+        CHECK(analysis_cache.size() == 0);
+        CHECK(analysis_cache.hit_count() == 0);
+        CHECK(analysis_cache.miss_count() == 0);
+    }
+
+    SECTION("missing code not found") {
+        CHECK(!analysis_cache.get(0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32));
+    }
+
+    SECTION("lookup of missing code counted as miss") {
+        analysis_cache.record_lookup(0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32);
+        CHECK(analysis_cache.hit_count() == 0);
+        CHECK(analysis_cache.miss_count() == 1);
+    }
+
+    SECTION("lookup of empty code not counted") {
+        analysis_cache.record_lookup(silkworm::kEmptyHash);
+        CHECK(analysis_cache.hit_count() == 0);
+        CHECK(analysis_cache.miss_count() == 0);
+    }
+
+    SECTION("same instance shared process-wide") {
+        CHECK(&CodeAnalysisCache::instance() == &CodeAnalysisCache::instance());
+    }
+}
+
+} // namespace silkrpc
@@ -21,6 +21,7 @@
 #include <utility>
 
 #include <boost/asio/compose.hpp>
+#include <boost/asio/experimental/awaitable_operators.hpp>
 #include <boost/asio/post.hpp>
 #include <boost/asio/use_awaitable.hpp>
 #include <silkworm/silkrpc/core/blocks.hpp>
@@ -79,27 +80,56 @@ boost::asio::awaitable<intx::uint256> EstimateGasOracle::estimate_gas(const Call
 
     SILKRPC_DEBUG << "hi: " << hi << ", lo: " << lo << ", cap: " << cap << "\n";
 
-    silkworm::Transaction transaction{call.to_transaction()};
-    while (lo + 1 < hi) {
-        auto mid = (hi + lo) / 2;
-        transaction.gas_limit = mid;
+    if (hi >= kTxGas && co_await is_plain_transfer(call, block_number)) {
+        SILKRPC_DEBUG << "EstimateGasOracle::estimate_gas plain transfer returns " << kTxGas << "\n";
+        co_return kTxGas;
+    }
 
-        auto failed = co_await try_execution(transaction);
+    silkworm::Transaction transaction{call.to_transaction()};
+    const auto result = co_await execute_at_cap(transaction, cap);
 
-        if (failed) {
-            lo = mid;
-        } else {
-            hi = mid;
+    // Any gas limit below the gas consumed before refund by the unconstrained execution fails, and usually it's enough on its own
+    const uint64_t gas_consumed = cap - result.gas_left + result.gas_refund;
+    if (gas_consumed > lo + 1) {
+        lo = gas_consumed - 1;
+    }
+    if (gas_consumed > lo && gas_consumed < hi) {
+        if (co_await try_execution(transaction, gas_consumed)) {
+            SILKRPC_DEBUG << "EstimateGasOracle::estimate_gas returns consumed gas " << gas_consumed << "\n";
+            co_return gas_consumed;
         }
+        lo = gas_consumed;
     }
 
-    if (hi == cap) {
-        transaction.gas_limit = hi;
-        auto failed = co_await try_execution(transaction);
-        SILKRPC_DEBUG << "HI == cap tested again with " << (failed ? "failure" : "succeed") << "\n";
+    // Quaternary search evaluating three candidate gas limits concurrently at each round
+    using namespace boost::asio::experimental::awaitable_operators;
+    while (lo + 1 < hi) {
+        const auto step = (hi - lo) / 4;
+        if (step == 0) {
+            const auto mid = (hi + lo) / 2;
+            if (co_await try_execution(transaction, mid)) {
+                hi = mid;
+            } else {
+                lo = mid;
+            }
+            continue;
+        }
 
-        if (failed) {
-            throw EstimateGasException{-1, "gas required exceeds allowance (" + std::to_string(cap) + ")"};
+        const auto gas1 = lo + step, gas2 = lo + 2 * step, gas3 = lo + 3 * step;
+        const auto [success1, success2, success3] = co_await (
+            try_execution(transaction, gas1) && try_execution(transaction, gas2) && try_execution(transaction, gas3));
+        SILKRPC_DEBUG << "lo: " << lo << ", hi: " << hi << ", probes: " << success1 << success2 << success3 << "\n";
+
+        if (success1) {
+            hi = gas1;
+        } else if (success2) {
+            lo = gas1;
+            hi = gas2;
+        } else if (success3) {
+            lo = gas2;
+            hi = gas3;
+        } else {
+            lo = gas3;
         }
     }
 
@@ -107,17 +137,39 @@ boost::asio::awaitable<intx::uint256> EstimateGasOracle::estimate_gas(const Call
     co_return hi;
 }
 
-boost::asio::awaitable<bool> EstimateGasOracle::try_execution(const silkworm::Transaction& transaction) {
+boost::asio::awaitable<bool> EstimateGasOracle::is_plain_transfer(const Call& call, uint64_t block_number) {
+    if (!call.to || (call.data && !call.data->empty()) || !call.access_list.empty()) {
+        co_return false;
+    }
+
+    std::optional<silkworm::Account> to_account{co_await account_reader_(*call.to, block_number + 1)};
+    if (to_account && to_account->code_hash != silkworm::kEmptyHash) {
+        co_return false;
+    }
+
+    const auto value = call.value.value_or(0);
+    if (value > 0) {
+        std::optional<silkworm::Account> from_account{co_await account_reader_(call.from.value_or(evmc::address{0}), block_number + 1)};
+        if (!from_account || from_account->balance < value) {
+            co_return false;
+        }
+    }
+
+    co_return true;
+}
+
+boost::asio::awaitable<silkrpc::ExecutionResult> EstimateGasOracle::execute_at_cap(silkworm::Transaction& transaction, uint64_t cap) {
+    transaction.gas_limit = cap;
     const auto result = co_await executor_(transaction);
 
-    bool failed = true;
     if (result.pre_check_error) {
         SILKRPC_DEBUG << "result error " << result.pre_check_error.value() << "\n";
+        throw EstimateGasException{-1, "gas required exceeds allowance (" + std::to_string(cap) + ")"};
     } else if (result.error_code == evmc_status_code::EVMC_SUCCESS) {
         SILKRPC_DEBUG << "result SUCCESS\n";
-        failed = false;
-    } else if (result.error_code == evmc_status_code::EVMC_INSUFFICIENT_BALANCE) {
-        SILKRPC_DEBUG << "result INSUFFICIENTE BALANCE\n";
+    } else if (result.error_code == evmc_status_code::EVMC_INSUFFICIENT_BALANCE || result.error_code == evmc_status_code::EVMC_OUT_OF_GAS) {
+        SILKRPC_DEBUG << "result " << result.error_code << " at cap " << cap << "\n";
+        throw EstimateGasException{-1, "gas required exceeds allowance (" + std::to_string(cap) + ")"};
     } else {
         const auto error_message = EVMExecutor<>::get_error_message(result.error_code, result.data);
         SILKRPC_DEBUG << "result message " << error_message << ", code " << result.error_code << "\n";
@@ -128,7 +180,18 @@ boost::asio::awaitable<bool> EstimateGasOracle::try_execution(const silkworm::Tr
         }
     }
 
-    co_return failed;
+    co_return result;
+}
+
+boost::asio::awaitable<bool> EstimateGasOracle::try_execution(silkworm::Transaction transaction, uint64_t gas_limit) {
+    transaction.gas_limit = gas_limit;
+    const auto result = co_await executor_(transaction);
+
+    // Any failure below the cap just means the gas limit is too low, the execution at cap has already reported errors
+    const bool success = !result.pre_check_error && result.error_code == evmc_status_code::EVMC_SUCCESS;
+    SILKRPC_DEBUG << "try_execution gas_limit: " << gas_limit << " success: " << success << "\n";
+
+    co_return success;
 }
 
 } // namespace silkrpc::ego
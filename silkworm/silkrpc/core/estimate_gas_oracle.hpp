@@ -87,7 +87,13 @@ public:
     boost::asio::awaitable<intx::uint256> estimate_gas(const Call& call, uint64_t block_number);
 
 private:
-    boost::asio::awaitable<bool> try_execution(const silkworm::Transaction& transaction);
+    //! Check if the call is a plain value transfer to an account without code
+    boost::asio::awaitable<bool> is_plain_transfer(const Call& call, uint64_t block_number);
+
+    //! Execute the transaction at the highest gas limit, throwing if it cannot succeed
+    boost::asio::awaitable<silkrpc::ExecutionResult> execute_at_cap(silkworm::Transaction& transaction, uint64_t cap);
+
+    boost::asio::awaitable<bool> try_execution(silkworm::Transaction transaction, uint64_t gas_limit);
 
     const BlockHeaderProvider& block_header_provider_;
     const AccountReader& account_reader_;
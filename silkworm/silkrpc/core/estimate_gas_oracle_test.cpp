@@ -17,6 +17,7 @@
 #include "estimate_gas_oracle.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iostream>
 
@@ -57,21 +58,25 @@ TEST_CASE("EstimateGasException") {
 TEST_CASE("estimate gas") {
     boost::asio::thread_pool pool{1};
 
-    uint64_t count{0};
-    std::vector<bool> steps;
+    std::atomic<uint64_t> count{0};
+    uint64_t required_gas{kTxGas};
+    uint64_t used_gas{kTxGas};
+    uint64_t refunded_gas{0};
     intx::uint256 kBalance{1'000'000'000};
 
-    silkrpc::ExecutionResult kSuccessResult{evmc_status_code::EVMC_SUCCESS};
-    silkrpc::ExecutionResult kFailureResult{evmc_status_code::EVMC_INSUFFICIENT_BALANCE};
-
     silkworm::BlockHeader kBlockHeader;
     kBlockHeader.gas_limit = kTxGas * 2;
 
     silkworm::Account kAccount{0, kBalance};
 
-    Executor executor = [&steps, &count](const silkworm::Transaction& transaction) -> boost::asio::awaitable<silkrpc::ExecutionResult> {
-        bool success = steps[count++];
-        silkrpc::ExecutionResult result{success ? evmc_status_code::EVMC_SUCCESS : evmc_status_code::EVMC_INSUFFICIENT_BALANCE};
+    // Execution succeeds iff the gas limit is at least required_gas, consuming used_gas after refund
+    Executor executor = [&](const silkworm::Transaction& transaction) -> boost::asio::awaitable<silkrpc::ExecutionResult> {
+        ++count;
+        if (transaction.gas_limit < required_gas) {
+            co_return silkrpc::ExecutionResult{evmc_status_code::EVMC_OUT_OF_GAS, 0};
+        }
+        silkrpc::ExecutionResult result{evmc_status_code::EVMC_SUCCESS, transaction.gas_limit - used_gas};
+        result.gas_refund = refunded_gas;
         co_return result;
     };
 
@@ -86,10 +91,16 @@ TEST_CASE("estimate gas") {
     Call call;
     EstimateGasOracle estimate_gas_oracle{block_header_provider, account_reader, executor};
 
-    SECTION("Call empty, always fails but last step") {
-        steps.resize(16);
-        std::fill_n(steps.begin(), steps.size(), false);
-        steps[15] = true;
+    SECTION("Call empty, always fails") {
+        required_gas = kTxGas * 3;
+        auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
+        CHECK_THROWS_MATCHES(result.get(), EstimateGasException, Message("gas required exceeds allowance (42000)"));
+        CHECK(count == 1);
+    }
+
+    SECTION("Call empty, succeeds at cap only") {
+        required_gas = kTxGas * 2;
+        used_gas = kTxGas + 1;
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
         const intx::uint256 &estimate_gas = result.get();
 
@@ -97,58 +108,46 @@ TEST_CASE("estimate gas") {
     }
 
     SECTION("Call empty, always succeeds") {
-        steps.resize(16);
-        std::fill_n(steps.begin(), steps.size(), true);
-
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
         const intx::uint256 &estimate_gas = result.get();
 
         CHECK(estimate_gas == kTxGas);
+        CHECK(count == 2);
     }
 
-    SECTION("Call empty, alternatively fails and succeeds") {
-        int current = false;
-        auto generate = [&current]() -> bool {
-            return ++current % 2 == 0;;
-        };
-        steps.resize(16);
-        std::generate_n(steps.begin(), steps.size(), generate);
-
+    SECTION("Call empty, gas used plus refund is enough") {
+        required_gas = 30'000;
+        used_gas = 25'000;
+        refunded_gas = 5'000;
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
         const intx::uint256 &estimate_gas = result.get();
 
-        CHECK(estimate_gas == 0x88b6);
+        CHECK(estimate_gas == 30'000);
+        CHECK(count == 2);
     }
 
-    SECTION("Call empty, alternatively succeeds and fails") {
-        int current = false;
-        auto generate = [&current]() -> bool {
-            return current++ % 2 == 0;;
-        };
-        steps.resize(16);
-        std::generate_n(steps.begin(), steps.size(), generate);
-
+    SECTION("Call empty, gas used plus refund is not enough") {
+        required_gas = 30'500;
+        used_gas = 25'000;
+        refunded_gas = 5'000;
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
         const intx::uint256 &estimate_gas = result.get();
 
-        CHECK(estimate_gas == 0x6d5e);
+        CHECK(estimate_gas == 30'500);
     }
 
-    SECTION("Call with gas, always fails but last step") {
+    SECTION("Call with gas, search above gas used") {
         call.gas = kTxGas * 4;
-        steps.resize(17);
-        std::fill_n(steps.begin(), steps.size(), false);
-        steps[16] = true;
+        required_gas = 50'001;
+        used_gas = 40'000;
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
         const intx::uint256 &estimate_gas = result.get();
 
-        CHECK(estimate_gas == kTxGas * 4);
+        CHECK(estimate_gas == 50'001);
     }
 
     SECTION("Call with gas, always succeeds") {
         call.gas = kTxGas * 4;
-        steps.resize(17);
-        std::fill_n(steps.begin(), steps.size(), true);
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
         const intx::uint256 &estimate_gas = result.get();
 
@@ -158,9 +157,7 @@ TEST_CASE("estimate gas") {
     SECTION("Call with gas_price, gas not capped") {
         call.gas = kTxGas * 2;
         call.gas_price = intx::uint256{10'000};
-        steps.resize(16);
-        std::fill_n(steps.begin(), steps.size(), false);
-        steps[15] = true;
+        required_gas = kTxGas * 2;
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
         const intx::uint256 &estimate_gas = result.get();
 
@@ -170,35 +167,27 @@ TEST_CASE("estimate gas") {
     SECTION("Call with gas_price, gas capped") {
         call.gas = kTxGas * 2;
         call.gas_price = intx::uint256{40'000};
-        steps.resize(13);
-        std::fill_n(steps.begin(), steps.size(), false);
-        steps[12] = true;
+        required_gas = kTxGas * 2;
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
-        const intx::uint256 &estimate_gas = result.get();
-
-        CHECK(estimate_gas == 0x61a8);
+        CHECK_THROWS_MATCHES(result.get(), EstimateGasException, Message("gas required exceeds allowance (25000)"));
     }
 
     SECTION("Call with gas_price and value, gas not capped") {
         call.gas = kTxGas * 2;
         call.gas_price = intx::uint256{10'000};
         call.value = intx::uint256{500'000'000};
-        steps.resize(16);
-        std::fill_n(steps.begin(), steps.size(), false);
-        steps[15] = true;
+        required_gas = 23'456;
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
         const intx::uint256 &estimate_gas = result.get();
 
-        CHECK(estimate_gas == kTxGas * 2);
+        CHECK(estimate_gas == 23'456);
     }
 
     SECTION("Call with gas_price and value, gas capped") {
         call.gas = kTxGas * 2;
         call.gas_price = intx::uint256{20'000};
         call.value = intx::uint256{500'000'000};
-        steps.resize(13);
-        std::fill_n(steps.begin(), steps.size(), false);
-        steps[12] = true;
+        required_gas = 0x61a8;
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
         const intx::uint256 &estimate_gas = result.get();
 
@@ -207,19 +196,23 @@ TEST_CASE("estimate gas") {
 
     SECTION("Call gas above allowance, always succeeds, gas capped") {
         call.gas = kGasCap * 2;
-        steps.resize(26);
-        std::fill_n(steps.begin(), steps.size(), true);
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
         const intx::uint256 &estimate_gas = result.get();
 
         CHECK(estimate_gas == kTxGas);
     }
 
+    SECTION("Call gas above allowance, search in whole range") {
+        call.gas = kGasCap * 2;
+        required_gas = 12'345'678;
+        auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
+        const intx::uint256 &estimate_gas = result.get();
+
+        CHECK(estimate_gas == 12'345'678);
+    }
+
     SECTION("Call gas below minimum, always succeeds") {
         call.gas = kTxGas / 2;
-
-        steps.resize(26);
-        std::fill_n(steps.begin(), steps.size(), true);
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
         const intx::uint256 &estimate_gas = result.get();
 
@@ -228,8 +221,7 @@ TEST_CASE("estimate gas") {
 
     SECTION("Call with too high value, exception") {
         call.value = intx::uint256{2'000'000'000};
-        steps.resize(16);
-        std::fill_n(steps.begin(), steps.size(), false);
+        required_gas = kGasCap;
 
         try {
             auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
@@ -239,6 +231,43 @@ TEST_CASE("estimate gas") {
             CHECK(true);
         }
     }
+
+    SECTION("Call reverted at cap, exception") {
+        Executor reverting_executor = [](const silkworm::Transaction& transaction) -> boost::asio::awaitable<silkrpc::ExecutionResult> {
+            co_return silkrpc::ExecutionResult{evmc_status_code::EVMC_REVERT, transaction.gas_limit, *silkworm::from_hex("0x00")};
+        };
+        EstimateGasOracle reverting_oracle{block_header_provider, account_reader, reverting_executor};
+        auto result = boost::asio::co_spawn(pool, reverting_oracle.estimate_gas(call, 0), boost::asio::use_future);
+        try {
+            result.get();
+            CHECK(false);
+        } catch (const EstimateGasException& e) {
+            CHECK(e.error_code() == 3);
+        }
+    }
+
+    SECTION("Plain transfer to account without code") {
+        call.to = evmc::address{0x52};
+        call.value = intx::uint256{1'000};
+        required_gas = kTxGas * 2;
+        auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
+        const intx::uint256 &estimate_gas = result.get();
+
+        CHECK(estimate_gas == kTxGas);
+        CHECK(count == 0);
+    }
+
+    SECTION("Transfer to account with code") {
+        kAccount.code_hash = evmc::bytes32{0x01};
+        call.to = evmc::address{0x52};
+        required_gas = 30'000;
+        used_gas = 30'000;
+        auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, 0), boost::asio::use_future);
+        const intx::uint256 &estimate_gas = result.get();
+
+        CHECK(estimate_gas == 30'000);
+        CHECK(count == 2);
+    }
 }
 
 } // namespace silkrpc::ego
@@ -17,6 +17,7 @@
 #include "evm_debug.hpp"
 
 #include <memory>
+#include <optional>
 #include <stack>
 #include <string>
 
@@ -381,15 +382,34 @@ boost::asio::awaitable<DebugExecutorResult> DebugExecutor<WorldState, VM>::execu
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     const auto chain_config_ptr = lookup_chain_config(chain_id);
     state::RemoteState remote_state{io_context_, database_reader_, block_number};
-    EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number, remote_state};
+    state::CheckpointState checkpoint_state{remote_state};
+    EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number, checkpoint_state};
+
+    // Resume from the nearest cached checkpoint instead of replaying the whole block prefix
+    std::int32_t first_index{0};
+    std::optional<evmc::bytes32> block_hash;
+    if (checkpoint_cache_ != nullptr && index > 0) {
+        block_hash = block.header.hash();
+        const auto checkpoint = checkpoint_cache_->find(*block_hash, static_cast<uint32_t>(index));
+        if (checkpoint) {
+            checkpoint_state.restore(*checkpoint->second);
+            first_index = static_cast<std::int32_t>(checkpoint->first);
+        }
+    }
 
-    for (auto idx = 0; idx < index; idx++) {
+    for (auto idx = first_index; idx < index; idx++) {
         silkrpc::Transaction txn{block.transactions[idx]};
 
         if (!txn.from) {
             txn.recover_sender();
         }
         const auto execution_result = co_await executor.call(block, txn);
+
+        const auto executed_count = static_cast<uint32_t>(idx + 1);
+        if (block_hash && checkpoint_cache_->should_checkpoint(executed_count, static_cast<uint32_t>(index))) {
+            executor.write_state(block_number);
+            checkpoint_cache_->insert(*block_hash, executed_count, checkpoint_state.checkpoint());
+        }
     }
     executor.reset();
 
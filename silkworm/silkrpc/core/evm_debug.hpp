@@ -34,6 +34,7 @@
 
 #include <silkworm/silkrpc/concurrency/context_pool.hpp>
 #include <silkworm/silkrpc/core/rawdb/accessors.hpp>
+#include <silkworm/silkrpc/core/state_checkpoint.hpp>
 #include <silkworm/silkrpc/json/stream.hpp>
 #include <silkworm/silkrpc/types/block.hpp>
 #include <silkworm/silkrpc/types/call.hpp>
@@ -138,8 +139,9 @@ public:
         boost::asio::io_context& io_context,
         const core::rawdb::DatabaseReader& database_reader,
         boost::asio::thread_pool& workers,
-        const DebugConfig& config = DEFAULT_DEBUG_CONFIG)
-        : io_context_(io_context), database_reader_(database_reader), workers_{workers}, config_{config} {}
+        const DebugConfig& config = DEFAULT_DEBUG_CONFIG,
+        state::StateCheckpointCache* checkpoint_cache = nullptr)
+        : io_context_(io_context), database_reader_(database_reader), workers_{workers}, config_{config}, checkpoint_cache_{checkpoint_cache} {}
     virtual ~DebugExecutor() {}
 
     DebugExecutor(const DebugExecutor&) = delete;
@@ -160,6 +162,7 @@ private:
     const core::rawdb::DatabaseReader& database_reader_;
     boost::asio::thread_pool& workers_;
     const DebugConfig& config_;
+    state::StateCheckpointCache* checkpoint_cache_;
 };
 } // namespace silkrpc::debug
 
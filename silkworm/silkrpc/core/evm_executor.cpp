@@ -17,14 +17,20 @@
 #include "evm_executor.hpp"
 
 #include <array>
+#include <atomic>
+#include <exception>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
 
+#include <boost/asio/cancellation_type.hpp>
 #include <boost/asio/compose.hpp>
+#include <boost/asio/error.hpp>
 #include <boost/asio/post.hpp>
 #include <boost/asio/use_awaitable.hpp>
+#include <boost/system/system_error.hpp>
 #include <evmc/evmc.hpp>
 #include <intx/intx.hpp>
 #include <silkworm/core/chain/intrinsic_gas.hpp>
@@ -33,6 +39,7 @@
 
 #include <silkworm/silkrpc/common/log.hpp>
 #include <silkworm/silkrpc/common/util.hpp>
+#include <silkworm/silkrpc/core/code_analysis_cache.hpp>
 #include <silkworm/silkrpc/types/transaction.hpp>
 
 namespace silkrpc {
@@ -176,6 +183,12 @@ template<typename WorldState, typename VM>
 void EVMExecutor<WorldState, VM>::reset() {
     state_.clear_journal_and_substate();
 }
+
+template<typename WorldState, typename VM>
+void EVMExecutor<WorldState, VM>::write_state(uint64_t block_number) {
+    state_.write_to_db(block_number);
+}
+
 template<typename WorldState, typename VM>
 std::optional<std::string> EVMExecutor<WorldState, VM>::pre_check(const VM& evm, const silkworm::Transaction& txn, const intx::uint256 base_fee_per_gas, const intx::uint128 g0) {
     const evmc_revision rev{evm.revision()};
@@ -215,13 +228,38 @@ boost::asio::awaitable<ExecutionResult> EVMExecutor<WorldState, VM>::call(
     SILKRPC_DEBUG << "EVMExecutor::call: " << block.header.number << " gasLimit: " << txn.gas_limit << " refund: " << refund << " gasBailout: " << gas_bailout << "\n";
     SILKRPC_DEBUG << "EVMExecutor::call:Transaction: " << &txn << "Txn: " << txn << "\n";
 
-    const auto exec_result = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(ExecutionResult)>(
+    // The exception pointer passed to the completion is rethrown on the awaiting coroutine
+    const auto exec_result = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(std::exception_ptr, ExecutionResult)>(
         [this, &block, &txn, &tracers, &refund, &gas_bailout](auto&& self) {
             SILKRPC_TRACE << "EVMExecutor::call post block: " << block.header.number << " txn: " << &txn << "\n";
-            boost::asio::post(workers_, [this, &block, &txn, &tracers, &refund, &gas_bailout, self = std::move(self)]() mutable {
+
+            // The call cancelled while still waiting for a worker is never executed
+            auto cancelled = std::make_shared<std::atomic_bool>(false);
+            auto cancellation_slot = self.get_cancellation_state().slot();
+            if (cancellation_slot.is_connected()) {
+                cancellation_slot.assign([cancelled](boost::asio::cancellation_type /*type*/) { *cancelled = true; });
+            }
+
+            boost::asio::post(workers_, [this, &block, &txn, &tracers, &refund, &gas_bailout, cancelled, self = std::move(self)]() mutable {
+                if (*cancelled) {
+                    SILKRPC_DEBUG << "EVMExecutor::call cancelled txn: " << &txn << "\n";
+                    const auto eptr = std::make_exception_ptr(boost::system::system_error{boost::asio::error::operation_aborted});
+                    boost::asio::post(io_context_, [eptr, self = std::move(self)]() mutable {
+                        self.complete(eptr, ExecutionResult{});
+                    });
+                    return;
+                }
+
                 VM evm{block, state_, config_};
                 evm.beneficiary = consensus_engine_->get_beneficiary(block.header);
 
+                // Nested frames are looked up inside the EVM, so only the entry code is accounted for
+                auto& analysis_cache = CodeAnalysisCache::instance();
+                analysis_cache.attach(evm);
+                if (txn.to) {
+                    analysis_cache.record_lookup(state_.get_code_hash(*txn.to));
+                }
+
                 for (auto& tracer : tracers) {
                     evm.add_tracer(*tracer);
                 }
@@ -239,7 +277,7 @@ boost::asio::awaitable<ExecutionResult> EVMExecutor<WorldState, VM>::call(
                     silkworm::Bytes data{};
                     ExecutionResult exec_result{1000, txn.gas_limit, data, *error};
                     boost::asio::post(io_context_, [exec_result, self = std::move(self)]() mutable {
-                        self.complete(exec_result);
+                        self.complete({}, exec_result);
                     });
                     return;
                 }
@@ -260,7 +298,7 @@ boost::asio::awaitable<ExecutionResult> EVMExecutor<WorldState, VM>::call(
                         std::string error = "insufficient funds for gas * price + value: address 0x" + from + " have " + intx::to_string(have) + " want " + intx::to_string(want+txn.value);
                         ExecutionResult exec_result{1000, txn.gas_limit, data, error};
                         boost::asio::post(io_context_, [exec_result, self = std::move(self)]() mutable {
-                            self.complete(exec_result);
+                            self.complete({}, exec_result);
                         });
                         return;
                     }
@@ -301,9 +339,10 @@ boost::asio::awaitable<ExecutionResult> EVMExecutor<WorldState, VM>::call(
                 }
                 state_.finalize_transaction();
 
-                ExecutionResult exec_result{result.status, gas_left, result.data};
+                const uint64_t gas_refund{txn.gas_limit - gas_used - result.gas_left};
+                ExecutionResult exec_result{result.status, gas_left, result.data, std::nullopt, gas_refund};
                 boost::asio::post(io_context_, [exec_result, self = std::move(self)]() mutable {
-                    self.complete(exec_result);
+                    self.complete({}, exec_result);
                 });
             });
         },
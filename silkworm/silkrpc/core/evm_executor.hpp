@@ -47,6 +47,7 @@ struct ExecutionResult {
     uint64_t gas_left;
     silkworm::Bytes data;
     std::optional<std::string> pre_check_error{std::nullopt};
+    uint64_t gas_refund{0}; // already included in gas_left when refund is enabled
 };
 
 using Tracers = std::vector<std::shared_ptr<silkworm::EvmTracer>>;
@@ -62,7 +63,7 @@ public:
         const silkworm::ChainConfig& config,
         boost::asio::thread_pool& workers,
         uint64_t block_number,
-        state::RemoteState& remote_state)
+        silkworm::State& remote_state)
         : io_context_(io_context), db_reader_(db_reader), config_(config), workers_{workers}, remote_state_{remote_state}, state_{remote_state_} {
              consensus_engine_ = silkworm::consensus::engine_factory(config);
              SILKWORM_ASSERT(consensus_engine_ != NULL);
@@ -75,6 +76,12 @@ public:
     boost::asio::awaitable<ExecutionResult> call(const silkworm::Block& block, const silkworm::Transaction& txn, const Tracers& tracers = {}, bool refund = true, bool gas_bailout = false);
     void reset();
 
+    //! Flush the changes committed so far into the underlying state
+    void write_state(uint64_t block_number);
+
+    //! Logs emitted by the transactions executed since the last reset
+    const std::vector<silkworm::Log>& logs() const { return state_.logs(); }
+
 private:
     std::optional<std::string> pre_check(const VM& evm, const silkworm::Transaction& txn, const intx::uint256 base_fee_per_gas, const intx::uint128 g0);
     uint64_t refund_gas(const VM& evm, const silkworm::Transaction& txn, uint64_t gas_left, uint64_t gas_refund);
@@ -83,7 +90,7 @@ private:
     const core::rawdb::DatabaseReader& db_reader_;
     const silkworm::ChainConfig& config_;
     boost::asio::thread_pool& workers_;
-    state::RemoteState& remote_state_;
+    silkworm::State& remote_state_;
     WorldState state_;
     std::unique_ptr<silkworm::consensus::IEngine> consensus_engine_;
 };
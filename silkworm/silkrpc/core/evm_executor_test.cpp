@@ -26,8 +26,11 @@
 #include <catch2/catch.hpp>
 #include <evmc/evmc.hpp>
 #include <intx/intx.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/state/in_memory_state.hpp>
 
 #include <silkworm/silkrpc/common/util.hpp>
+#include <silkworm/silkrpc/core/code_analysis_cache.hpp>
 #include <silkworm/silkrpc/types/transaction.hpp>
 
 namespace silkrpc {
@@ -241,6 +244,55 @@ TEST_CASE("EVMexecutor") {
         CHECK(result.error_code == 0);
     }
 
+    SECTION("second call of same code reuses cached analysis") {
+        StubDatabase tx_database;
+        const uint64_t chain_id = 5;
+        const auto chain_config_ptr = lookup_chain_config(chain_id);
+
+        ChannelFactory my_channel = []() { return grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials()); };
+        ContextPool my_pool{1, my_channel};
+        boost::asio::thread_pool workers{1};
+        my_pool.start();
+
+        // PUSH1 0x2a PUSH1 0x00 MSTORE PUSH1 0x20 PUSH1 0x00 RETURN
+        const auto code{*silkworm::from_hex("602a60005260206000f3")};
+        const auto code_hash{silkworm::to_bytes32({silkworm::keccak256(code).bytes, silkworm::kHashLength})};
+        const auto contract_address{0x8e4d1ea201b908ab5e1f5a1c3f9f1b4f6c1f6b2a_address};
+        silkworm::InMemoryState state;
+        silkworm::Account contract;
+        contract.code_hash = code_hash;
+        contract.incarnation = 1;
+        state.update_account(contract_address, std::nullopt, contract);
+        state.update_account_code(contract_address, contract.incarnation, code_hash, code);
+
+        const auto block_number = 6000000;
+        silkworm::Block block{};
+        block.header.number = block_number;
+        silkworm::Transaction txn{};
+        txn.gas_limit = 600000;
+        txn.from = 0xa872626373628737383927236382161739290870_address;
+        txn.to = contract_address;
+
+        boost::asio::io_context& io_context = my_pool.next_io_context();
+        auto& analysis_cache = CodeAnalysisCache::instance();
+        EVMExecutor first_executor{io_context, tx_database, *chain_config_ptr, workers, block_number, state};
+        auto first_result = boost::asio::co_spawn(io_context.get_executor(), first_executor.call(block, txn, {}, true, true), boost::asio::use_future).get();
+        const auto first_analysis = analysis_cache.get(code_hash);
+        const auto hits_before_second_call = analysis_cache.hit_count();
+        EVMExecutor second_executor{io_context, tx_database, *chain_config_ptr, workers, block_number, state};
+        auto second_result = boost::asio::co_spawn(io_context.get_executor(), second_executor.call(block, txn, {}, true, true), boost::asio::use_future).get();
+        const auto second_analysis = analysis_cache.get(code_hash);
+        my_pool.stop();
+        my_pool.join();
+        CHECK(first_result.error_code == 0);
+        CHECK(second_result.error_code == 0);
+        CHECK(second_result.data == first_result.data);
+        REQUIRE(first_analysis);
+        REQUIRE(second_analysis);
+        CHECK(*second_analysis == *first_analysis);  // a miss would have stored a new analysis
+        CHECK(analysis_cache.hit_count() == hits_before_second_call + 1);
+    }
+
     static silkworm::Bytes error_data{
                                0x08, 0xc3, 0x79, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
                                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
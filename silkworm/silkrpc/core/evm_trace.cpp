@@ -18,10 +18,12 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <set>
 #include <stack>
 #include <string>
 
+#include <boost/asio/this_coro.hpp>
 #include <evmc/hex.hpp>
 #include <evmc/instructions.h>
 #include <intx/intx.hpp>
@@ -33,10 +35,13 @@
 
 #include <silkworm/silkrpc/common/log.hpp>
 #include <silkworm/silkrpc/common/util.hpp>
+#include <silkworm/silkrpc/concurrency/cancellation.hpp>
 #include <silkworm/silkrpc/consensus/ethash.hpp>
 #include <silkworm/silkrpc/core/cached_chain.hpp>
 #include <silkworm/silkrpc/core/evm_executor.hpp>
 #include <silkworm/silkrpc/core/rawdb/chain.hpp>
+#include <silkworm/silkrpc/ethdb/bitmap.hpp>
+#include <silkworm/silkrpc/ethdb/tables.hpp>
 #include <silkworm/silkrpc/json/types.hpp>
 
 namespace silkrpc::trace {
@@ -1126,20 +1131,28 @@ void IntraBlockStateTracer::on_reward_granted(const silkworm::CallResult& result
     }
 }
 
+boost::asio::awaitable<roaring::Roaring> get_call_index_bitmap(const core::rawdb::DatabaseReader& db_reader, const std::string& table,
+    const std::set<evmc::address>& addresses, uint64_t start, uint64_t end) {
+    SILKRPC_TRACE << "table: " << table << " #addresses: " << addresses.size() << " start: " << start << " end: " << end << "\n";
+    roaring::Roaring result_bitmap;
+    for (const auto& address : addresses) {
+        const silkworm::Bytes address_key{std::begin(address.bytes), std::end(address.bytes)};
+        const auto bitmap = co_await ethdb::bitmap::get(db_reader, table, address_key, start, end);
+        SILKRPC_TRACE << "bitmap: " << bitmap.toString() << "\n";
+        result_bitmap |= bitmap;
+    }
+    SILKRPC_TRACE << "result_bitmap: " << result_bitmap.toString() << "\n";
+    co_return result_bitmap;
+}
+
 template<typename WorldState, typename VM>
 boost::asio::awaitable<std::vector<Trace>> TraceCallExecutor<WorldState, VM>::trace_block(const silkworm::BlockWithHash& block_with_hash, Filter& filter, json::Stream* stream) {
     std::vector<Trace> traces;
 
-    const auto trace_call_results = co_await trace_block_transactions(block_with_hash.block, {false, true, false});
+    const auto trace_call_results = co_await trace_block_transactions(block_with_hash, {false, true, false});
     for (std::uint64_t pos = 0; pos < trace_call_results.size(); pos++) {
-        silkrpc::Transaction transaction{block_with_hash.block.transactions[pos]};
-        if (!transaction.from) {
-            transaction.recover_sender();
-        }
-        const auto hash = hash_of_transaction(transaction);
-        const auto tnx_hash = silkworm::to_bytes32({hash.bytes, silkworm::kHashLength});
-
         const auto& trace_call_result = trace_call_results.at(pos);
+        const auto& tnx_hash = trace_call_result.traces.transaction_hash;
         const auto& call_traces = trace_call_result.traces.trace;
 
         for (const auto& call_trace : call_traces) {
@@ -1218,7 +1231,8 @@ boost::asio::awaitable<std::vector<Trace>> TraceCallExecutor<WorldState, VM>::tr
 }
 
 template<typename WorldState, typename VM>
-boost::asio::awaitable<std::vector<TraceCallResult>> TraceCallExecutor<WorldState, VM>::trace_block_transactions(const silkworm::Block& block, const TraceConfig& config) {
+boost::asio::awaitable<std::vector<TraceCallResult>> TraceCallExecutor<WorldState, VM>::trace_block_transactions(const silkworm::BlockWithHash& block_with_hash, const TraceConfig& config) {
+    const auto& block = block_with_hash.block;
     auto block_number = block.header.number;
     const auto& transactions = block.transactions;
 
@@ -1236,6 +1250,8 @@ boost::asio::awaitable<std::vector<TraceCallResult>> TraceCallExecutor<WorldStat
     state::RemoteState curr_remote_state{io_context_, database_reader_, block_number-1};
     EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number-1, curr_remote_state};
 
+    const auto transaction_hashes = block_cache_.transaction_hashes(block_with_hash);
+
     std::vector<TraceCallResult> trace_call_result(transactions.size());
     for (std::uint64_t index = 0; index < transactions.size(); index++) {
         silkrpc::Transaction transaction{block.transactions[index]};
@@ -1245,8 +1261,7 @@ boost::asio::awaitable<std::vector<TraceCallResult>> TraceCallExecutor<WorldStat
 
         auto& result = trace_call_result.at(index);
         TraceCallTraces& traces = result.traces;
-        auto hash{hash_of_transaction(transaction)};
-        traces.transaction_hash = silkworm::to_bytes32({hash.bytes, silkworm::kHashLength});
+        traces.transaction_hash = (*transaction_hashes)[index];
 
         Tracers tracers;
         if (config.vm_trace) {
@@ -1353,8 +1368,8 @@ boost::asio::awaitable<std::vector<Trace>> TraceCallExecutor<WorldState, VM>::tr
     const auto result = co_await execute(block_with_hash.block.header.number-1, block_with_hash.block, transaction, transaction.transaction_index, {false, true, false});
     const auto& trace_result = result.traces.trace;
 
-    const auto hash = hash_of_transaction(transaction);
-    const auto tnx_hash = silkworm::to_bytes32({hash.bytes, silkworm::kHashLength});
+    const auto transaction_hashes = block_cache_.transaction_hashes(block_with_hash);
+    const auto& tnx_hash = (*transaction_hashes)[transaction.transaction_index];
 
     for (const auto& call_trace : trace_result) {
         Trace trace{call_trace};
@@ -1374,8 +1389,8 @@ template<typename WorldState, typename VM>
 boost::asio::awaitable<void> TraceCallExecutor<WorldState, VM>::trace_filter(const TraceFilter& trace_filter, json::Stream* stream) {
     SILKRPC_INFO << "TraceCallExecutor::trace_filter: filter " << trace_filter << "\n";
 
-    const auto from_block_with_hash = co_await core::read_block_by_number_or_hash(block_cache_, database_reader_, trace_filter.from_block);
-    const auto to_block_with_hash = co_await core::read_block_by_number_or_hash(block_cache_, database_reader_, trace_filter.to_block);
+    const auto from_block_with_hash = co_await core::read_block_by_number_or_hash(block_cache_, database_reader_, trace_filter.from_block, &workers_);
+    const auto to_block_with_hash = co_await core::read_block_by_number_or_hash(block_cache_, database_reader_, trace_filter.to_block, &workers_);
 
     if (from_block_with_hash.block.header.number > to_block_with_hash.block.header.number) {
         const Error error{-32000, "invalid parameters: fromBlock cannot be greater than toBlock"};
@@ -1392,12 +1407,31 @@ boost::asio::awaitable<void> TraceCallExecutor<WorldState, VM>::trace_filter(con
     filter.after = trace_filter.after;
     filter.count = trace_filter.count;
 
-    auto block_number = from_block_with_hash.block.header.number;
+    const auto from_number = from_block_with_hash.block.header.number;
+    const auto to_number = to_block_with_hash.block.header.number;
+    roaring::Roaring block_numbers;
+    block_numbers.addRange(from_number, to_number + 1); // [min, max)
+    if (!filter.from_addresses.empty() || !filter.to_addresses.empty()) {
+        // Execute only the blocks indexed as containing calls from/to the requested addresses
+        auto addresses_bitmap = co_await get_call_index_bitmap(database_reader_, db::table::kCallFromIndex, filter.from_addresses, from_number, to_number);
+        addresses_bitmap |= co_await get_call_index_bitmap(database_reader_, db::table::kCallToIndex, filter.to_addresses, from_number, to_number);
+        block_numbers &= addresses_bitmap;
+        SILKRPC_DEBUG << "TraceCallExecutor::trace_filter: block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
+    }
+
+    auto block_number_it = block_numbers.begin();
     auto block_with_hash = from_block_with_hash;
-    while (block_number++ <= to_block_with_hash.block.header.number) {
+    if (block_number_it != block_numbers.end() && *block_number_it == to_number) {
+        block_with_hash = to_block_with_hash;
+    } else if (block_number_it != block_numbers.end() && *block_number_it != from_number) {
+        block_with_hash = co_await core::read_block_by_number(block_cache_, database_reader_, *block_number_it, &workers_);
+    }
+    while (block_number_it != block_numbers.end()) {
+        throw_if_cancelled(co_await boost::asio::this_coro::cancellation_state);
+        const uint64_t block_number = *block_number_it;
         const Block block{block_with_hash, {}, false};
         SILKRPC_INFO << "TraceCallExecutor::trace_filter: processing "
-            << " block_number: " << block_number-1
+            << " block_number: " << block_number
             << " block: " << block
             << "\n";
 
@@ -1407,10 +1441,12 @@ boost::asio::awaitable<void> TraceCallExecutor<WorldState, VM>::trace_filter(con
             break;
         }
 
-        if (block_number == to_block_with_hash.block.header.number) {
+        ++block_number_it;
+        const uint64_t next_block_number = block_number_it != block_numbers.end() ? *block_number_it : to_number + 1;
+        if (next_block_number == to_number) {
             block_with_hash = to_block_with_hash;
         } else {
-            block_with_hash = co_await core::read_block_by_number(block_cache_, database_reader_, block_number);
+            block_with_hash = co_await core::read_block_by_number(block_cache_, database_reader_, next_block_number, &workers_);
         }
     }
 
@@ -1435,7 +1471,8 @@ boost::asio::awaitable<TraceCallResult> TraceCallExecutor<WorldState, VM>::execu
     const auto chain_config_ptr = lookup_chain_config(chain_id);
 
     state::RemoteState remote_state{io_context_, database_reader_, block_number};
-    silkworm::IntraBlockState initial_ibs{remote_state};
+    state::CheckpointState initial_state{remote_state};
+    silkworm::IntraBlockState initial_ibs{initial_state};
 
     Tracers tracers;
     StateAddresses state_addresses(initial_ibs);
@@ -1443,8 +1480,24 @@ boost::asio::awaitable<TraceCallResult> TraceCallExecutor<WorldState, VM>::execu
     tracers.push_back(tracer);
 
     state::RemoteState curr_remote_state{io_context_, database_reader_, block_number};
-    EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number, curr_remote_state};
-    for (auto idx = 0; idx < transaction.transaction_index; idx++) {
+    state::CheckpointState curr_state{curr_remote_state};
+    EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number, curr_state};
+
+    // Resume from the nearest cached checkpoint instead of replaying the whole block prefix
+    const auto target_index = static_cast<uint32_t>(transaction.transaction_index);
+    uint32_t first_index{0};
+    std::optional<evmc::bytes32> block_hash;
+    if (checkpoint_cache_ != nullptr && transaction.transaction_index > 0) {
+        block_hash = block.header.hash();
+        const auto checkpoint = checkpoint_cache_->find(*block_hash, target_index);
+        if (checkpoint) {
+            initial_state.restore(*checkpoint->second);
+            curr_state.restore(*checkpoint->second);
+            first_index = checkpoint->first;
+        }
+    }
+
+    for (auto idx = first_index; idx < target_index; idx++) {
         silkrpc::Transaction txn{block.transactions[idx]};
 
         if (!txn.from) {
@@ -1452,6 +1505,11 @@ boost::asio::awaitable<TraceCallResult> TraceCallExecutor<WorldState, VM>::execu
         }
         const auto execution_result = co_await executor.call(block, txn, tracers, /*refund=*/true, /*gas_bailout=*/true);
         executor.reset();
+
+        if (block_hash && checkpoint_cache_->should_checkpoint(idx + 1, target_index)) {
+            executor.write_state(block_number);
+            checkpoint_cache_->insert(*block_hash, idx + 1, curr_state.checkpoint());
+        }
     }
 
     tracers.clear();
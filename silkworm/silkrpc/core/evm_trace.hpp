@@ -31,6 +31,8 @@
 #include <boost/asio/thread_pool.hpp>
 #include <nlohmann/json.hpp>
 
+#include <croaring/roaring.hh>
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wattributes"
 #include <silkworm/core/execution/evm.hpp>
@@ -40,6 +42,7 @@
 #include <silkworm/silkrpc/common/block_cache.hpp>
 #include <silkworm/silkrpc/concurrency/context_pool.hpp>
 #include <silkworm/silkrpc/core/rawdb/accessors.hpp>
+#include <silkworm/silkrpc/core/state_checkpoint.hpp>
 #include <silkworm/silkrpc/json/stream.hpp>
 #include <silkworm/silkrpc/types/block.hpp>
 #include <silkworm/silkrpc/types/call.hpp>
@@ -363,21 +366,26 @@ struct Filter {
     std::uint32_t count{std::numeric_limits<uint32_t>::max()};
 };
 
+//! Collect the blocks in [start, end] where any of the given addresses appears in the specified call index table
+boost::asio::awaitable<roaring::Roaring> get_call_index_bitmap(const core::rawdb::DatabaseReader& db_reader, const std::string& table,
+    const std::set<evmc::address>& addresses, uint64_t start, uint64_t end);
+
 template<typename WorldState = silkworm::IntraBlockState, typename VM = silkworm::EVM>
 class TraceCallExecutor {
 public:
     explicit TraceCallExecutor(boost::asio::io_context& io_context,
         silkrpc::BlockCache& block_cache,
         const core::rawdb::DatabaseReader& database_reader,
-        boost::asio::thread_pool& workers)
-    : io_context_(io_context), block_cache_(block_cache), database_reader_(database_reader), workers_{workers} {}
+        boost::asio::thread_pool& workers,
+        state::StateCheckpointCache* checkpoint_cache = nullptr)
+    : io_context_(io_context), block_cache_(block_cache), database_reader_(database_reader), workers_{workers}, checkpoint_cache_{checkpoint_cache} {}
     virtual ~TraceCallExecutor() {}
 
     TraceCallExecutor(const TraceCallExecutor&) = delete;
     TraceCallExecutor& operator=(const TraceCallExecutor&) = delete;
 
     boost::asio::awaitable<std::vector<Trace>> trace_block(const silkworm::BlockWithHash& block_with_hash, Filter& filter, json::Stream* stream = nullptr);
-    boost::asio::awaitable<std::vector<TraceCallResult>> trace_block_transactions(const silkworm::Block& block, const TraceConfig& config);
+    boost::asio::awaitable<std::vector<TraceCallResult>> trace_block_transactions(const silkworm::BlockWithHash& block_with_hash, const TraceConfig& config);
     boost::asio::awaitable<TraceCallResult> trace_call(const silkworm::Block& block, const silkrpc::Call& call, const TraceConfig& config);
     boost::asio::awaitable<TraceManyCallResult> trace_calls(const silkworm::Block& block, const std::vector<TraceCall>& calls);
     boost::asio::awaitable<TraceCallResult> trace_transaction(const silkworm::Block& block, const silkrpc::Transaction& transaction, const TraceConfig& config) {
@@ -394,6 +402,7 @@ private:
     silkrpc::BlockCache& block_cache_;
     const core::rawdb::DatabaseReader& database_reader_;
     boost::asio::thread_pool& workers_;
+    state::StateCheckpointCache* checkpoint_cache_;
 };
 } // namespace silkrpc::trace
 
@@ -43,6 +43,7 @@ using evmc::literals::operator""_address;
 using evmc::literals::operator""_bytes32;
 
 using testing::_;
+using testing::Invoke;
 using testing::InvokeWithoutArgs;
 
 static silkworm::Bytes kZeroKey{*silkworm::from_hex("0000000000000000")};
@@ -2087,8 +2088,8 @@ TEST_CASE("TraceCallExecutor::trace_block_transactions") {
 
     uint64_t block_number = 1'024'165;  // 0xFA0A5
 
-    silkworm::Block block{};
-    block.header.number = block_number;
+    silkworm::BlockWithHash block_with_hash;
+    block_with_hash.block.header.number = block_number;
 
     silkworm::Transaction transaction;
     transaction.from = 0xdaae090d53f9ed9e2e1fd25258c01bac4dd6d1c5_address;
@@ -2105,13 +2106,13 @@ TEST_CASE("TraceCallExecutor::trace_block_transactions") {
     transaction.gas_limit = 0x47b760;
     transaction.type = silkworm::Transaction::Type::kLegacy;
 
-    block.transactions.push_back(transaction);
+    block_with_hash.block.transactions.push_back(transaction);
 
     TraceConfig config{true, true, true};
     BlockCache block_cache;
     TraceCallExecutor executor{context_pool.next_io_context(), block_cache, db_reader, workers};
     boost::asio::io_context& io_context = context_pool.next_io_context();
-    auto execution_result = boost::asio::co_spawn(io_context.get_executor(), executor.trace_block_transactions(block, config), boost::asio::use_future);
+    auto execution_result = boost::asio::co_spawn(io_context.get_executor(), executor.trace_block_transactions(block_with_hash, config), boost::asio::use_future);
     auto result = execution_result.get();
 
     context_pool.stop();
@@ -3928,6 +3929,12 @@ TEST_CASE("TraceCallExecutor::trace_transaction") {
     ])"_json);
 }
 
+static silkworm::Bytes serialize_bitmap(const roaring::Roaring& bitmap) {
+    silkworm::Bytes bytes(bitmap.getSizeInBytes(), '\0');
+    bitmap.write(reinterpret_cast<char*>(bytes.data()));
+    return bytes;
+}
+
 TEST_CASE("TraceCallExecutor::trace_filter") {
     SILKRPC_LOG_STREAMS(null_stream(), null_stream());
     SILKRPC_LOG_VERBOSITY(LogLevel::None);
@@ -5572,6 +5579,16 @@ TEST_CASE("TraceCallExecutor::trace_filter") {
           "fromAddress": ["0x2031832e54a2200bf678286f560f49a950db2ad5"]
         })"_json;
 
+        // TransactionDatabase::walk: TABLE CallFromIndex
+        static silkworm::Bytes kCallFromIndexKey{*silkworm::from_hex("2031832e54a2200bf678286f560f49a950db2ad500000000006ddd02")};
+        EXPECT_CALL(db_reader, walk(db::table::kCallFromIndex, silkworm::ByteView{kCallFromIndexKey}, 160, _))
+            .WillOnce(Invoke([](const std::string&, const silkworm::ByteView&, uint32_t, core::rawdb::Walker w) -> boost::asio::awaitable<void> {
+                silkworm::Bytes key{*silkworm::from_hex("2031832e54a2200bf678286f560f49a950db2ad5ffffffff")};
+                silkworm::Bytes value{serialize_bitmap(roaring::Roaring{0x6ddd02, 0x6ddd03})};
+                w(key, value);
+                co_return;
+            }));
+
         // TransactionDatabase::get_one: TABLE CanonicalHeader
         static silkworm::Bytes kCanonicalHeaderKey3{*silkworm::from_hex("00000000006ddd04")};
         static silkworm::Bytes kCanonicalHeaderValue3{*silkworm::from_hex("1b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
@@ -5635,6 +5652,89 @@ TEST_CASE("TraceCallExecutor::trace_filter") {
           "fromAddress": ["0x2031832e54a2200bf678286f560f49a950db2ad5"]
         })"_json;
 
+        // TransactionDatabase::walk: TABLE CallFromIndex
+        static silkworm::Bytes kCallFromIndexKey{*silkworm::from_hex("2031832e54a2200bf678286f560f49a950db2ad500000000006ddd02")};
+        EXPECT_CALL(db_reader, walk(db::table::kCallFromIndex, silkworm::ByteView{kCallFromIndexKey}, 160, _))
+            .WillOnce(Invoke([](const std::string&, const silkworm::ByteView&, uint32_t, core::rawdb::Walker w) -> boost::asio::awaitable<void> {
+                silkworm::Bytes key{*silkworm::from_hex("2031832e54a2200bf678286f560f49a950db2ad5ffffffff")};
+                silkworm::Bytes value{serialize_bitmap(roaring::Roaring{0x6ddd02, 0x6ddd03})};
+                w(key, value);
+                co_return;
+            }));
+
+        // TransactionDatabase::get_one: TABLE CanonicalHeader
+        static silkworm::Bytes kCanonicalHeaderKey3{*silkworm::from_hex("00000000006ddd04")};
+        static silkworm::Bytes kCanonicalHeaderValue3{*silkworm::from_hex("1b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
+        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashes, silkworm::ByteView{kCanonicalHeaderKey3}))
+            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> {
+                co_return kCanonicalHeaderValue3;
+            }));
+
+        // TransactionDatabase::get: TABLE Header
+        static silkworm::Bytes kHeaderKey2{*silkworm::from_hex("00000000006ddd041b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
+        static silkworm::Bytes kHeaderValue2{*silkworm::from_hex(
+            "f9025ba0a316f156582fb5fba2166910becdb6342965a801fa473e18cd6a0c06143cac1aa01dcc4de8dec75d7aab85b567b6ccd41ad312"
+            "451b948a7413f0a142fd40d49347940000000000000000000000000000000000000000a000636fe848d9d0dd8d3fe77deef0286329b01f"
+            "4e971501d1dc481365deea77bfa056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6"
+            "ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b9010000000000000000000000000000000000000000000000000000000000"
+            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+            "000000000000000001836ddd048401c9c380808462ca3c74b8614e65746865726d696e6420312e31332e332d302d306533323839663535"
+            "2d3230a499270541450663356185c61f970959545219dee7616763658a87d3c80730c32cca058d57ccc16cc0b0ca4269c4dee474ee3612"
+            "f83cbf54f9fbffddba6d154401a00000000000000000000000000000000000000000000000000000000000000000880000000000000000"
+            "07")};
+        EXPECT_CALL(db_reader, get_one(db::table::kHeaders, silkworm::ByteView{kHeaderKey2}))
+            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> {
+                co_return kHeaderValue2;
+            }));
+
+        // TransactionDatabase::get: TABLE BlockBody
+        static silkworm::Bytes kBlockBodyKey2{*silkworm::from_hex("00000000006ddd041b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
+        static silkworm::Bytes kBlockBodyValue2{*silkworm::from_hex("c78405c62e6f02c0")};
+        EXPECT_CALL(db_reader, get_one(db::table::kBlockBodies, silkworm::ByteView{kBlockBodyKey2}))
+            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> {
+                co_return kBlockBodyValue2;
+            }));
+
+        BlockCache block_cache;
+        TraceCallExecutor executor{context_pool.next_io_context(), block_cache, db_reader, workers};
+        boost::asio::io_context& io_context = context_pool.next_io_context();
+
+        stream.open_object();
+        auto execution_result = boost::asio::co_spawn(io_context.get_executor(), executor.trace_filter(trace_filter, &stream), boost::asio::use_future);
+        execution_result.get();
+
+        context_pool.stop();
+        io_context.stop();
+        pool_thread.join();
+
+        stream.close_object();
+        stream.close();
+
+        nlohmann::json json = nlohmann::json::parse(string_writer.get_content());
+        CHECK(json["result"] == R"([
+        ])"_json);
+    }
+
+    SECTION("from block to block with toAddress indexed in last block") {
+        TraceFilter trace_filter = R"({
+          "fromBlock": "0x6DDD02",
+          "toBlock": "0x6DDD03",
+          "toAddress": ["0x2031832e54a2200bf678286f560f49a950db2ad5"]
+        })"_json;
+
+        // TransactionDatabase::walk: TABLE CallToIndex
+        static silkworm::Bytes kCallToIndexKey{*silkworm::from_hex("2031832e54a2200bf678286f560f49a950db2ad500000000006ddd02")};
+        EXPECT_CALL(db_reader, walk(db::table::kCallToIndex, silkworm::ByteView{kCallToIndexKey}, 160, _))
+            .WillOnce(Invoke([](const std::string&, const silkworm::ByteView&, uint32_t, core::rawdb::Walker w) -> boost::asio::awaitable<void> {
+                silkworm::Bytes key{*silkworm::from_hex("2031832e54a2200bf678286f560f49a950db2ad5ffffffff")};
+                silkworm::Bytes value{serialize_bitmap(roaring::Roaring{0x6ddd01, 0x6ddd03, 0x6ddd05})};
+                w(key, value);
+                co_return;
+            }));
+
         // TransactionDatabase::get_one: TABLE CanonicalHeader
         static silkworm::Bytes kCanonicalHeaderKey3{*silkworm::from_hex("00000000006ddd04")};
         static silkworm::Bytes kCanonicalHeaderValue3{*silkworm::from_hex("1b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
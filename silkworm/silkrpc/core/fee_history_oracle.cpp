@@ -0,0 +1,245 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "fee_history_oracle.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#include <silkworm/core/chain/protocol_param.hpp>
+
+#include <silkworm/silkrpc/common/log.hpp>
+
+namespace silkrpc {
+
+// Lanes are loaded concurrently only when there is enough work for each of them
+const uint64_t kMinBlocksPerLane = 8;
+
+// Cold blocks are loaded again at most this number of times when found on different forks
+const int kMaxColdFeesLoads = 3;
+
+intx::uint256 BlockFees::reward(double percentile) const {
+    if (priority_fees.empty()) {
+        return 0;
+    }
+    // Same semantics as the reference implementation: first transaction whose running gas sum reaches the threshold
+    const auto threshold = static_cast<uint64_t>(static_cast<double>(gas_used) * percentile / 100);
+    const auto it = std::lower_bound(cumulative_gas.begin(), cumulative_gas.end(), threshold);
+    if (it == cumulative_gas.end()) {
+        return priority_fees.back();
+    }
+    return priority_fees[static_cast<std::size_t>(it - cumulative_gas.begin())];
+}
+
+static intx::uint256 compute_next_base_fee(const silkworm::BlockHeader& header) {
+    if (!header.base_fee_per_gas) {
+        return 0;
+    }
+    const auto& base_fee = *header.base_fee_per_gas;
+    const uint64_t gas_target = header.gas_limit / silkworm::param::kElasticityMultiplier;
+    if (gas_target == 0 || header.gas_used == gas_target) {
+        return base_fee;
+    }
+    if (header.gas_used > gas_target) {
+        const uint64_t gas_delta = header.gas_used - gas_target;
+        const intx::uint256 fee_delta = std::max<intx::uint256>(
+            base_fee * gas_delta / gas_target / silkworm::param::kBaseFeeMaxChangeDenominator, 1);
+        return base_fee + fee_delta;
+    }
+    const uint64_t gas_delta = gas_target - header.gas_used;
+    const intx::uint256 fee_delta = base_fee * gas_delta / gas_target / silkworm::param::kBaseFeeMaxChangeDenominator;
+    return base_fee > fee_delta ? base_fee - fee_delta : 0;
+}
+
+BlockFees make_block_fees(const silkworm::BlockWithHash& block_with_hash, const Receipts& receipts) {
+    const auto& header = block_with_hash.block.header;
+    const auto& transactions = block_with_hash.block.transactions;
+    if (receipts.size() != transactions.size()) {
+        throw std::runtime_error{"receipts not found for block " + std::to_string(header.number)};
+    }
+
+    BlockFees block_fees;
+    block_fees.block_number = header.number;
+    block_fees.hash = block_with_hash.hash;
+    block_fees.parent_hash = header.parent_hash;
+    block_fees.base_fee = header.base_fee_per_gas.value_or(0);
+    block_fees.next_base_fee = compute_next_base_fee(header);
+    block_fees.gas_used = header.gas_used;
+    if (header.gas_limit > 0) {
+        block_fees.gas_used_ratio = static_cast<double>(header.gas_used) / static_cast<double>(header.gas_limit);
+    }
+
+    std::vector<std::pair<intx::uint256, uint64_t>> fee_and_gas;
+    fee_and_gas.reserve(transactions.size());
+    for (std::size_t i{0}; i < transactions.size(); ++i) {
+        fee_and_gas.emplace_back(transactions[i].priority_fee_per_gas(block_fees.base_fee), receipts[i].gas_used);
+    }
+    std::sort(fee_and_gas.begin(), fee_and_gas.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    block_fees.priority_fees.reserve(fee_and_gas.size());
+    block_fees.cumulative_gas.reserve(fee_and_gas.size());
+    uint64_t cumulative_gas{0};
+    for (const auto& [priority_fee, gas] : fee_and_gas) {
+        cumulative_gas += gas;
+        block_fees.priority_fees.push_back(priority_fee);
+        block_fees.cumulative_gas.push_back(cumulative_gas);
+    }
+    return block_fees;
+}
+
+//! Check that the fees come from a chain of blocks whose last one has the given hash, if any
+static bool is_hash_chain(const std::vector<BlockFees>& block_fees, const std::optional<evmc::bytes32>& last_hash) {
+    for (std::size_t i{1}; i < block_fees.size(); ++i) {
+        if (block_fees[i].parent_hash != block_fees[i - 1].hash) {
+            return false;
+        }
+    }
+    return !last_hash || block_fees.empty() || block_fees.back().hash == *last_hash;
+}
+
+std::optional<BlockFees> FeeHistoryCache::get(uint64_t block_number, const evmc::bytes32& hash) const {
+    const std::lock_guard<std::mutex> lock(access_);
+    const auto& slot = ring_[block_number % ring_.size()];
+    if (slot && slot->block_number == block_number && slot->hash == hash) {
+        return slot;
+    }
+    return std::nullopt;
+}
+
+void FeeHistoryCache::insert(const BlockFees& block_fees) {
+    const std::lock_guard<std::mutex> lock(access_);
+    ring_[block_fees.block_number % ring_.size()] = block_fees;
+}
+
+boost::asio::awaitable<FeeHistory> FeeHistoryOracle::fee_history(uint64_t newest_block, uint64_t block_count, const std::vector<double>& reward_percentiles) {
+    SILKRPC_DEBUG << "FeeHistoryOracle::fee_history newest_block: " << newest_block << " block_count: " << block_count << "\n";
+
+    for (std::size_t i{0}; i < reward_percentiles.size(); ++i) {
+        if (reward_percentiles[i] < 0 || reward_percentiles[i] > 100) {
+            throw std::invalid_argument{"invalid reward percentile: " + std::to_string(reward_percentiles[i])};
+        }
+        if (i > 0 && reward_percentiles[i] < reward_percentiles[i - 1]) {
+            throw std::invalid_argument{"invalid reward percentiles: not in ascending order"};
+        }
+    }
+
+    FeeHistory history;
+    if (block_count == 0) {
+        co_return history;
+    }
+    block_count = std::min({block_count, kMaxFeeHistoryBlocks, newest_block + 1});
+    const uint64_t oldest_block = newest_block + 1 - block_count;
+
+    // Recent blocks are taken from the cache walking back from the newest one by parent hash
+    std::vector<BlockFees> block_fees(block_count);
+    uint64_t cached_count{0};
+    std::optional<evmc::bytes32> joint_hash;
+    if (cache_ != nullptr) {
+        const auto newest_block_with_hash = co_await block_provider_(newest_block);
+        auto expected_hash = newest_block_with_hash.hash;
+        while (cached_count < block_count) {
+            const uint64_t block_number = newest_block - cached_count;
+            auto cached_fees = cache_->get(block_number, expected_hash);
+            if (!cached_fees) {
+                break;
+            }
+            expected_hash = cached_fees->parent_hash;
+            block_fees[block_number - oldest_block] = std::move(*cached_fees);
+            ++cached_count;
+        }
+        joint_hash = expected_hash;
+    }
+    SILKRPC_DEBUG << "FeeHistoryOracle::fee_history cached blocks: " << cached_count << "\n";
+
+    if (cached_count < block_count) {
+        // Cold blocks are read by number on separate transactions, so a reorg in the meantime could mix different forks
+        auto cold_fees = co_await load_cold_fees(oldest_block, newest_block - cached_count);
+        for (int loads{1}; !is_hash_chain(cold_fees, joint_hash); ++loads) {
+            if (loads == kMaxColdFeesLoads) {
+                throw std::runtime_error{"chain reorganized while loading fee history"};
+            }
+            SILKRPC_DEBUG << "FeeHistoryOracle::fee_history cold blocks not on the same chain, load again\n";
+            cold_fees = co_await load_cold_fees(oldest_block, newest_block - cached_count);
+        }
+        for (auto& fees : cold_fees) {
+            if (cache_ != nullptr) {
+                cache_->insert(fees);
+            }
+            block_fees[fees.block_number - oldest_block] = std::move(fees);
+        }
+    }
+
+    history.oldest_block = oldest_block;
+    history.base_fees.reserve(block_count + 1);
+    history.gas_used_ratio.reserve(block_count);
+    if (!reward_percentiles.empty()) {
+        history.rewards = std::vector<std::vector<intx::uint256>>{};
+        history.rewards->reserve(block_count);
+    }
+    for (const auto& fees : block_fees) {
+        history.base_fees.push_back(fees.base_fee);
+        history.gas_used_ratio.push_back(fees.gas_used_ratio);
+        if (history.rewards) {
+            std::vector<intx::uint256> block_rewards;
+            block_rewards.reserve(reward_percentiles.size());
+            for (const auto percentile : reward_percentiles) {
+                block_rewards.push_back(fees.reward(percentile));
+            }
+            history.rewards->push_back(std::move(block_rewards));
+        }
+    }
+    history.base_fees.push_back(block_fees.back().next_base_fee);
+
+    co_return history;
+}
+
+boost::asio::awaitable<std::vector<BlockFees>> FeeHistoryOracle::load_cold_fees(uint64_t first_block, uint64_t last_block) {
+    const uint64_t block_count = last_block - first_block + 1;
+    std::vector<std::vector<uint64_t>> lanes(block_count < kFeeHistoryLanes * kMinBlocksPerLane ? 1 : kFeeHistoryLanes);
+    const uint64_t lane_size = (block_count + lanes.size() - 1) / lanes.size();
+    for (uint64_t block_number{first_block}; block_number <= last_block; ++block_number) {
+        lanes[(block_number - first_block) / lane_size].push_back(block_number);
+    }
+    SILKRPC_DEBUG << "FeeHistoryOracle::load_cold_fees blocks: " << block_count << " lanes: " << lanes.size() << "\n";
+
+    auto cold_fees = co_await load_lanes(lanes, 0, lanes.size());
+    if (cold_fees.size() != block_count) {
+        throw std::runtime_error{"unexpected fee records: " + std::to_string(cold_fees.size())};
+    }
+
+    co_return cold_fees;
+}
+
+boost::asio::awaitable<std::vector<BlockFees>> FeeHistoryOracle::load_lanes(const std::vector<std::vector<uint64_t>>& lanes, std::size_t first,
+                                                                            std::size_t count) {
+    using namespace boost::asio::experimental::awaitable_operators;
+
+    if (count == 1) {
+        co_return co_await fees_loader_(lanes[first]);
+    }
+
+    // Split in halves awaited together: the lane count is dynamic while the awaitable operators have fixed arity
+    const auto half = count / 2;
+    auto [block_fees, right_block_fees] = co_await (load_lanes(lanes, first, half) && load_lanes(lanes, first + half, count - half));
+    std::move(right_block_fees.begin(), right_block_fees.end(), std::back_inserter(block_fees));
+    co_return block_fees;
+}
+
+} // namespace silkrpc
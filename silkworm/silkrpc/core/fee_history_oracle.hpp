@@ -0,0 +1,102 @@
+/*
+   Copyright 2021 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <silkworm/silkrpc/config.hpp> // NOLINT(build/include_order)
+
+#include <boost/asio/awaitable.hpp>
+#include <evmc/evmc.hpp>
+#include <intx/intx.hpp>
+#include <silkworm/core/types/block.hpp>
+
+#include <silkworm/silkrpc/core/gas_price_oracle.hpp>
+#include <silkworm/silkrpc/types/fee_history.hpp>
+#include <silkworm/silkrpc/types/receipt.hpp>
+
+namespace silkrpc {
+
+const uint64_t kMaxFeeHistoryBlocks = 1024;
+const std::size_t kFeeHistoryLanes = 4;
+
+//! Compact fee statistics of one block, enough to answer any reward percentile without reloading it
+struct BlockFees {
+    uint64_t block_number{0};
+    evmc::bytes32 hash;
+    evmc::bytes32 parent_hash;
+    intx::uint256 base_fee;
+    intx::uint256 next_base_fee;
+    double gas_used_ratio{0};
+    uint64_t gas_used{0};
+    //! Effective priority fees of the block transactions, sorted in ascending order
+    std::vector<intx::uint256> priority_fees;
+    //! Running sum of the gas used by the transactions in priority fee order
+    std::vector<uint64_t> cumulative_gas;
+
+    //! Return the priority fee paid at the given percentile of the block gas used
+    intx::uint256 reward(double percentile) const;
+};
+
+BlockFees make_block_fees(const silkworm::BlockWithHash& block_with_hash, const Receipts& receipts);
+
+//! Recent per-block fee statistics shared among requests, validated by block hash
+class FeeHistoryCache {
+public:
+    explicit FeeHistoryCache(std::size_t capacity = kMaxFeeHistoryBlocks) : ring_(capacity == 0 ? 1 : capacity) {}
+
+    FeeHistoryCache(const FeeHistoryCache&) = delete;
+    FeeHistoryCache& operator=(const FeeHistoryCache&) = delete;
+
+    //! Return the fees of the block identified by number and hash, if present
+    std::optional<BlockFees> get(uint64_t block_number, const evmc::bytes32& hash) const;
+
+    void insert(const BlockFees& block_fees);
+
+private:
+    mutable std::mutex access_;
+    std::vector<std::optional<BlockFees>> ring_;
+};
+
+//! Load the fees of the given blocks, in the same order
+typedef std::function<boost::asio::awaitable<std::vector<BlockFees>>(std::vector<uint64_t>)> BlockFeesLoader;
+
+class FeeHistoryOracle {
+public:
+    explicit FeeHistoryOracle(const BlockProvider& block_provider, const BlockFeesLoader& fees_loader, FeeHistoryCache* cache = nullptr)
+        : block_provider_(block_provider), fees_loader_(fees_loader), cache_(cache) {}
+    virtual ~FeeHistoryOracle() {}
+
+    FeeHistoryOracle(const FeeHistoryOracle&) = delete;
+    FeeHistoryOracle& operator=(const FeeHistoryOracle&) = delete;
+
+    boost::asio::awaitable<FeeHistory> fee_history(uint64_t newest_block, uint64_t block_count, const std::vector<double>& reward_percentiles);
+
+private:
+    boost::asio::awaitable<std::vector<BlockFees>> load_cold_fees(uint64_t first_block, uint64_t last_block);
+
+    boost::asio::awaitable<std::vector<BlockFees>> load_lanes(const std::vector<std::vector<uint64_t>>& lanes, std::size_t first, std::size_t count);
+
+    const BlockProvider& block_provider_;
+    const BlockFeesLoader& fees_loader_;
+    FeeHistoryCache* cache_;
+};
+
+} // namespace silkrpc
@@ -0,0 +1,224 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "fee_history_oracle.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+
+namespace silkrpc {
+
+static silkworm::BlockWithHash make_block(uint64_t block_number, const std::vector<intx::uint256>& tips, uint8_t fork_id = 0) {
+    silkworm::BlockWithHash block_with_hash;
+    block_with_hash.block.header.number = block_number;
+    block_with_hash.block.header.gas_limit = 100;
+    block_with_hash.block.header.gas_used = 10 * tips.size();
+    block_with_hash.block.header.base_fee_per_gas = 10;
+    block_with_hash.hash = evmc::bytes32{block_number + 1};
+    block_with_hash.hash.bytes[0] = fork_id;
+    if (block_number > 0) {
+        block_with_hash.block.header.parent_hash = evmc::bytes32{block_number};
+        block_with_hash.block.header.parent_hash.bytes[0] = fork_id;
+    }
+    for (const auto& tip : tips) {
+        silkworm::Transaction transaction;
+        transaction.max_priority_fee_per_gas = tip;
+        transaction.max_fee_per_gas = 100;
+        block_with_hash.block.transactions.push_back(transaction);
+    }
+    return block_with_hash;
+}
+
+static Receipts make_receipts(const std::vector<uint64_t>& gas_used) {
+    Receipts receipts(gas_used.size());
+    for (std::size_t i{0}; i < gas_used.size(); ++i) {
+        receipts[i].gas_used = gas_used[i];
+    }
+    return receipts;
+}
+
+TEST_CASE("block fees") {
+    auto block_with_hash = make_block(1, {5, 1, 3});
+    block_with_hash.block.header.gas_used = 60;
+
+    SECTION("fees sorted and weighted by gas used") {
+        const auto block_fees = make_block_fees(block_with_hash, make_receipts({30, 10, 20}));
+        CHECK(block_fees.block_number == 1);
+        CHECK(block_fees.hash == block_with_hash.hash);
+        CHECK(block_fees.base_fee == 10);
+        CHECK(block_fees.gas_used_ratio == Approx(0.6));
+        CHECK(block_fees.priority_fees == std::vector<intx::uint256>{1, 3, 5});
+        CHECK(block_fees.cumulative_gas == std::vector<uint64_t>{10, 30, 60});
+        CHECK(block_fees.reward(0) == 1);
+        CHECK(block_fees.reward(10) == 1);
+        CHECK(block_fees.reward(50) == 3);
+        CHECK(block_fees.reward(60) == 5);
+        CHECK(block_fees.reward(100) == 5);
+    }
+
+    SECTION("next base fee") {
+        CHECK(make_block_fees(block_with_hash, make_receipts({30, 10, 20})).next_base_fee == 11);
+        block_with_hash.block.header.gas_used = 50;
+        CHECK(make_block_fees(block_with_hash, make_receipts({30, 10, 10})).next_base_fee == 10);
+        block_with_hash.block.header.gas_used = 0;
+        block_with_hash.block.header.base_fee_per_gas = 80;
+        CHECK(make_block_fees(block_with_hash, make_receipts({0, 0, 0})).next_base_fee == 70);
+        block_with_hash.block.header.base_fee_per_gas = std::nullopt;
+        CHECK(make_block_fees(block_with_hash, make_receipts({0, 0, 0})).next_base_fee == 0);
+    }
+
+    SECTION("empty block") {
+        const auto block_fees = make_block_fees(make_block(1, {}), {});
+        CHECK(block_fees.reward(50) == 0);
+    }
+
+    SECTION("missing receipts") {
+        CHECK_THROWS_AS(make_block_fees(block_with_hash, {}), std::runtime_error);
+    }
+}
+
+TEST_CASE("fee history") {
+    boost::asio::thread_pool pool{1};
+
+    std::vector<silkworm::BlockWithHash> blocks;
+    for (uint64_t n{0}; n < 40; ++n) {
+        blocks.push_back(make_block(n, {n + 1, n + 2}));
+    }
+    BlockProvider block_provider = [&](uint64_t block_number) -> boost::asio::awaitable<silkworm::BlockWithHash> {
+        co_return blocks[block_number];
+    };
+    uint64_t loader_calls{0};
+    uint64_t loaded_blocks{0};
+    BlockFeesLoader fees_loader = [&](std::vector<uint64_t> block_numbers) -> boost::asio::awaitable<std::vector<BlockFees>> {
+        ++loader_calls;
+        std::vector<BlockFees> block_fees;
+        for (const auto block_number : block_numbers) {
+            ++loaded_blocks;
+            block_fees.push_back(make_block_fees(blocks[block_number], make_receipts({10, 10})));
+        }
+        co_return block_fees;
+    };
+    FeeHistoryCache cache;
+
+    SECTION("zero block count") {
+        FeeHistoryOracle oracle{block_provider, fees_loader};
+        const auto history = boost::asio::co_spawn(pool, oracle.fee_history(39, 0, {}), boost::asio::use_future).get();
+        CHECK(history.base_fees.empty());
+        CHECK(history.gas_used_ratio.empty());
+        CHECK(!history.rewards);
+    }
+
+    SECTION("block count capped to available blocks") {
+        FeeHistoryOracle oracle{block_provider, fees_loader};
+        const auto history = boost::asio::co_spawn(pool, oracle.fee_history(2, 10, {}), boost::asio::use_future).get();
+        CHECK(history.oldest_block == 0);
+        CHECK(history.base_fees.size() == 4);
+        CHECK(history.gas_used_ratio.size() == 3);
+        CHECK(!history.rewards);
+    }
+
+    SECTION("invalid reward percentiles") {
+        FeeHistoryOracle oracle{block_provider, fees_loader};
+        CHECK_THROWS_AS(boost::asio::co_spawn(pool, oracle.fee_history(39, 4, {50, 10}), boost::asio::use_future).get(), std::invalid_argument);
+        CHECK_THROWS_AS(boost::asio::co_spawn(pool, oracle.fee_history(39, 4, {101}), boost::asio::use_future).get(), std::invalid_argument);
+    }
+
+    SECTION("cold range loaded in lanes") {
+        FeeHistoryOracle oracle{block_provider, fees_loader};
+        const auto history = boost::asio::co_spawn(pool, oracle.fee_history(39, 40, {0, 100}), boost::asio::use_future).get();
+        CHECK(loader_calls == kFeeHistoryLanes);
+        CHECK(loaded_blocks == 40);
+        CHECK(history.oldest_block == 0);
+        CHECK(history.base_fees.size() == 41);
+        REQUIRE(history.rewards);
+        REQUIRE(history.rewards->size() == 40);
+        for (uint64_t n{0}; n < 40; ++n) {
+            CHECK((*history.rewards)[n] == std::vector<intx::uint256>{n + 1, n + 2});
+        }
+    }
+
+    SECTION("cached blocks not loaded again") {
+        FeeHistoryOracle oracle{block_provider, fees_loader, &cache};
+        boost::asio::co_spawn(pool, oracle.fee_history(39, 10, {}), boost::asio::use_future).get();
+        loaded_blocks = 0;
+        const auto history = boost::asio::co_spawn(pool, oracle.fee_history(39, 20, {50}), boost::asio::use_future).get();
+        CHECK(loaded_blocks == 10);
+        CHECK(history.oldest_block == 20);
+        REQUIRE(history.rewards);
+        CHECK((*history.rewards)[19] == std::vector<intx::uint256>{40});
+    }
+
+    SECTION("blocks from unwound fork loaded again") {
+        FeeHistoryOracle oracle{block_provider, fees_loader, &cache};
+        boost::asio::co_spawn(pool, oracle.fee_history(39, 10, {}), boost::asio::use_future).get();
+        for (uint64_t n{35}; n < 40; ++n) {
+            blocks[n] = make_block(n, {1}, 1);
+        }
+        blocks[35].block.header.parent_hash = blocks[34].hash;
+        loaded_blocks = 0;
+        boost::asio::co_spawn(pool, oracle.fee_history(39, 10, {}), boost::asio::use_future).get();
+        CHECK(loaded_blocks == 10);
+    }
+
+    SECTION("cold blocks loaded again when found on different forks") {
+        uint64_t forked_loads{1};
+        BlockFeesLoader forked_loader = [&](std::vector<uint64_t> block_numbers) -> boost::asio::awaitable<std::vector<BlockFees>> {
+            ++loader_calls;
+            std::vector<BlockFees> block_fees;
+            for (const auto block_number : block_numbers) {
+                const auto forked = loader_calls <= forked_loads && block_number == 35;
+                const auto block_with_hash = forked ? make_block(block_number, {1, 1}, 1) : blocks[block_number];
+                block_fees.push_back(make_block_fees(block_with_hash, make_receipts({10, 10})));
+            }
+            co_return block_fees;
+        };
+        FeeHistoryOracle oracle{block_provider, forked_loader, &cache};
+        const auto history = boost::asio::co_spawn(pool, oracle.fee_history(39, 10, {50}), boost::asio::use_future).get();
+        CHECK(loader_calls == 2);
+        REQUIRE(history.rewards);
+        CHECK((*history.rewards)[5] == std::vector<intx::uint256>{36});
+
+        forked_loads = 100;
+        loader_calls = 0;
+        FeeHistoryOracle uncached_oracle{block_provider, forked_loader};
+        CHECK_THROWS_AS(boost::asio::co_spawn(pool, uncached_oracle.fee_history(39, 10, {}), boost::asio::use_future).get(), std::runtime_error);
+    }
+
+    SECTION("cold blocks not joining the cached ones loaded again") {
+        FeeHistoryOracle oracle{block_provider, fees_loader, &cache};
+        boost::asio::co_spawn(pool, oracle.fee_history(39, 5, {}), boost::asio::use_future).get();
+        const auto canonical_block = blocks[34];
+        blocks[34] = make_block(34, {1, 1}, 1);
+        blocks[34].block.header.parent_hash = blocks[33].hash;
+        loader_calls = 0;
+        BlockFeesLoader restoring_loader = [&](std::vector<uint64_t> block_numbers) -> boost::asio::awaitable<std::vector<BlockFees>> {
+            auto block_fees = co_await fees_loader(std::move(block_numbers));
+            blocks[34] = canonical_block;
+            co_return block_fees;
+        };
+        FeeHistoryOracle restoring_oracle{block_provider, restoring_loader, &cache};
+        boost::asio::co_spawn(pool, restoring_oracle.fee_history(39, 10, {}), boost::asio::use_future).get();
+        CHECK(loader_calls == 2);
+    }
+}
+
+} // namespace silkrpc
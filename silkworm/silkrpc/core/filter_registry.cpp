@@ -0,0 +1,171 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "filter_registry.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <silkworm/core/common/util.hpp>
+
+namespace silkrpc {
+
+FilterRegistry::FilterRegistry(std::chrono::milliseconds timeout) : timeout_(timeout), id_generator_{std::random_device{}()} {}
+
+std::string FilterRegistry::add_logs_filter(const Filter& filter, uint64_t next_block) {
+    return add(InstalledFilter{.type = FilterType::logs, .logs = {filter, next_block}});
+}
+
+std::string FilterRegistry::add_block_filter() {
+    return add(InstalledFilter{.type = FilterType::block});
+}
+
+std::string FilterRegistry::add_pending_transaction_filter() {
+    return add(InstalledFilter{.type = FilterType::pending_transaction});
+}
+
+bool FilterRegistry::remove(const std::string& id) {
+    const std::lock_guard<std::mutex> lock(access_);
+    return filters_.erase(id) > 0;
+}
+
+std::optional<FilterType> FilterRegistry::type(const std::string& id) {
+    const std::lock_guard<std::mutex> lock(access_);
+    const auto installed_filter = find(id);
+    if (installed_filter == nullptr) {
+        return std::nullopt;
+    }
+    return installed_filter->type;
+}
+
+std::optional<std::vector<evmc::bytes32>> FilterRegistry::take_block_hashes(const std::string& id) {
+    const std::lock_guard<std::mutex> lock(access_);
+    const auto installed_filter = find(id);
+    if (installed_filter == nullptr || installed_filter->type != FilterType::block) {
+        return std::nullopt;
+    }
+    std::vector<evmc::bytes32> block_hashes;
+    block_hashes.reserve(installed_filter->block_hashes.size());
+    for (const auto& [_, hash] : installed_filter->block_hashes) {
+        block_hashes.push_back(hash);
+    }
+    installed_filter->block_hashes.clear();
+    return block_hashes;
+}
+
+std::optional<LogsFilterCursor> FilterRegistry::logs_cursor(const std::string& id) {
+    const std::lock_guard<std::mutex> lock(access_);
+    const auto installed_filter = find(id);
+    if (installed_filter == nullptr || installed_filter->type != FilterType::logs) {
+        return std::nullopt;
+    }
+    return installed_filter->logs;
+}
+
+bool FilterRegistry::advance_logs_cursor(const std::string& id, const LogsFilterCursor& cursor, uint64_t new_next_block) {
+    const std::lock_guard<std::mutex> lock(access_);
+    const auto installed_filter = find(id);
+    if (installed_filter == nullptr || installed_filter->type != FilterType::logs) {
+        return false;
+    }
+    // An unwind may leave next_block unchanged while replacing the blocks just read, so both must match
+    const auto& logs = installed_filter->logs;
+    if (logs.next_block != cursor.next_block || logs.unwind_generation != cursor.unwind_generation) {
+        return false;
+    }
+    installed_filter->logs.next_block = new_next_block;
+    return true;
+}
+
+void FilterRegistry::on_new_block(uint64_t block_number, const evmc::bytes32& hash) {
+    const std::lock_guard<std::mutex> lock(access_);
+    for (auto& [_, installed_filter] : filters_) {
+        if (installed_filter.type != FilterType::block) {
+            continue;
+        }
+        auto& block_hashes = installed_filter.block_hashes;
+        if (block_hashes.size() == kMaxFilterBlockHashes) {
+            block_hashes.erase(block_hashes.begin());
+        }
+        block_hashes.emplace_back(block_number, hash);
+    }
+}
+
+void FilterRegistry::on_unwind(uint64_t block_number) {
+    const std::lock_guard<std::mutex> lock(access_);
+    for (auto& [_, installed_filter] : filters_) {
+        // Blocks already delivered but now unwound must be scanned again once replaced by the new canonical ones
+        if (installed_filter.type == FilterType::logs) {
+            installed_filter.logs.next_block = std::min(installed_filter.logs.next_block, block_number);
+            ++installed_filter.logs.unwind_generation;
+        } else if (installed_filter.type == FilterType::block) {
+            std::erase_if(installed_filter.block_hashes, [&](const auto& block_hash) { return block_hash.first >= block_number; });
+        }
+    }
+}
+
+std::size_t FilterRegistry::expire(Clock::time_point now) {
+    const std::lock_guard<std::mutex> lock(access_);
+    return expire_unlocked(now);
+}
+
+std::size_t FilterRegistry::size() const {
+    const std::lock_guard<std::mutex> lock(access_);
+    return filters_.size();
+}
+
+std::string FilterRegistry::add(InstalledFilter installed_filter) {
+    const auto now = Clock::now();
+    installed_filter.last_access = now;
+
+    const std::lock_guard<std::mutex> lock(access_);
+    expire_unlocked(now);
+    if (filters_.size() >= kMaxInstalledFilters) {
+        throw std::runtime_error{"too many installed filters"};
+    }
+    while (true) {
+        uint8_t id_bytes[16];
+        for (std::size_t i{0}; i < sizeof(id_bytes); i += sizeof(uint64_t)) {
+            const uint64_t random_word = id_generator_();
+            std::memcpy(id_bytes + i, &random_word, sizeof(uint64_t));
+        }
+        auto id = "0x" + silkworm::to_hex({id_bytes, sizeof(id_bytes)});
+        if (filters_.try_emplace(id, installed_filter).second) {
+            return id;
+        }
+    }
+}
+
+FilterRegistry::InstalledFilter* FilterRegistry::find(const std::string& id) {
+    auto it = filters_.find(id);
+    if (it == filters_.end()) {
+        return nullptr;
+    }
+    const auto now = Clock::now();
+    if (it->second.last_access + timeout_ < now) {
+        filters_.erase(it);
+        return nullptr;
+    }
+    it->second.last_access = now;
+    return &it->second;
+}
+
+std::size_t FilterRegistry::expire_unlocked(Clock::time_point now) {
+    return std::erase_if(filters_, [&](const auto& entry) { return entry.second.last_access + timeout_ < now; });
+}
+
+} // namespace silkrpc
@@ -0,0 +1,123 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+
+#include <silkworm/silkrpc/types/filter.hpp>
+
+namespace silkrpc {
+
+//! Filters not polled within this interval are uninstalled
+constexpr std::chrono::milliseconds kDefaultFilterTimeout{300'000};
+
+//! Max number of filters installed at the same time
+const std::size_t kMaxInstalledFilters = 4'096;
+
+//! Max number of block hashes kept for a block filter not yet polled, the oldest ones are dropped
+const std::size_t kMaxFilterBlockHashes = 1'024;
+
+enum class FilterType {
+    logs,
+    block,
+    pending_transaction,
+};
+
+//! The position of a logs filter: the blocks from next_block onwards have not been delivered yet
+struct LogsFilterCursor {
+    Filter filter;
+    uint64_t next_block{0};
+    uint64_t unwind_generation{0}; // incremented at each unwind, so that blocks read before it are not delivered
+};
+
+//! Filters installed by eth_newFilter and friends, shared among the execution contexts and kept in sync with the chain head
+class FilterRegistry {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FilterRegistry(std::chrono::milliseconds timeout = kDefaultFilterTimeout);
+
+    FilterRegistry(const FilterRegistry&) = delete;
+    FilterRegistry& operator=(const FilterRegistry&) = delete;
+
+    //! Install a logs filter whose first delivered block is next_block, returning its identifier
+    std::string add_logs_filter(const Filter& filter, uint64_t next_block);
+
+    //! Install a filter collecting the hashes of the new canonical blocks, returning its identifier
+    std::string add_block_filter();
+
+    //! Install a filter for pending transactions, returning its identifier
+    std::string add_pending_transaction_filter();
+
+    //! Uninstall the given filter: return false if not installed
+    bool remove(const std::string& id);
+
+    //! Return the type of the given filter if installed, refreshing its expiration
+    std::optional<FilterType> type(const std::string& id);
+
+    //! Return the hashes collected by the given block filter since the last call
+    std::optional<std::vector<evmc::bytes32>> take_block_hashes(const std::string& id);
+
+    //! Return the filter criteria and cursor of the given logs filter
+    std::optional<LogsFilterCursor> logs_cursor(const std::string& id);
+
+    //! Move the given cursor of the logs filter to new_next_block, unless it has been moved or unwound meanwhile
+    bool advance_logs_cursor(const std::string& id, const LogsFilterCursor& cursor, uint64_t new_next_block);
+
+    //! Notify that a new block has been added to the canonical chain
+    void on_new_block(uint64_t block_number, const evmc::bytes32& hash);
+
+    //! Notify that the given block and all its descendants have been removed from the canonical chain
+    void on_unwind(uint64_t block_number);
+
+    //! Uninstall the filters not accessed within the timeout before now, returning how many
+    std::size_t expire(Clock::time_point now);
+
+    std::size_t size() const;
+
+private:
+    struct InstalledFilter {
+        FilterType type{FilterType::logs};
+        Clock::time_point last_access{};
+        LogsFilterCursor logs{};
+        std::vector<std::pair<uint64_t, evmc::bytes32>> block_hashes{};
+    };
+
+    std::string add(InstalledFilter installed_filter);
+
+    InstalledFilter* find(const std::string& id);
+
+    std::size_t expire_unlocked(Clock::time_point now);
+
+    std::chrono::milliseconds timeout_;
+    mutable std::mutex access_;
+    std::map<std::string, InstalledFilter> filters_;
+    std::mt19937_64 id_generator_;
+};
+
+} // namespace silkrpc
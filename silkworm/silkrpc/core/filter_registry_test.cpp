@@ -0,0 +1,131 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "filter_registry.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+
+namespace silkrpc {
+
+using evmc::literals::operator""_bytes32;
+
+TEST_CASE("filter registry", "[silkrpc][core][filter_registry]") {
+    const auto hash1{0x3ac225168df54212a25c1c01fd35bebfea408fdac2e31ddd6f80a4bbf9a5f1cb_bytes32};
+    const auto hash2{0x1dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d49347_bytes32};
+    FilterRegistry registry;
+
+    SECTION("unique identifiers") {
+        const auto id1 = registry.add_block_filter();
+        const auto id2 = registry.add_block_filter();
+        CHECK(id1.starts_with("0x"));
+        CHECK(id1 != id2);
+        CHECK(registry.size() == 2);
+    }
+
+    SECTION("unknown filter") {
+        CHECK(!registry.type("0x1234"));
+        CHECK(!registry.take_block_hashes("0x1234"));
+        CHECK(!registry.logs_cursor("0x1234"));
+        CHECK(!registry.remove("0x1234"));
+    }
+
+    SECTION("block filter returns only the new hashes") {
+        const auto id = registry.add_block_filter();
+        CHECK(registry.type(id) == FilterType::block);
+        registry.on_new_block(10, hash1);
+        registry.on_new_block(11, hash2);
+        CHECK(registry.take_block_hashes(id) == std::vector<evmc::bytes32>{hash1, hash2});
+        CHECK(registry.take_block_hashes(id)->empty());
+        CHECK(!registry.logs_cursor(id));
+    }
+
+    SECTION("block filter drops unwound hashes") {
+        const auto id = registry.add_block_filter();
+        registry.on_new_block(10, hash1);
+        registry.on_new_block(11, hash2);
+        registry.on_unwind(11);
+        CHECK(registry.take_block_hashes(id) == std::vector<evmc::bytes32>{hash1});
+    }
+
+    SECTION("logs filter cursor") {
+        const auto id = registry.add_logs_filter(Filter{}, 100);
+        CHECK(registry.type(id) == FilterType::logs);
+        CHECK(registry.logs_cursor(id)->next_block == 100);
+        const auto cursor = *registry.logs_cursor(id);
+        CHECK(registry.advance_logs_cursor(id, cursor, 105));
+        CHECK(registry.logs_cursor(id)->next_block == 105);
+        CHECK(!registry.advance_logs_cursor(id, cursor, 110));
+        CHECK(!registry.take_block_hashes(id));
+    }
+
+    SECTION("logs filter rewound by unwind") {
+        const auto id = registry.add_logs_filter(Filter{}, 105);
+        registry.on_unwind(103);
+        CHECK(registry.logs_cursor(id)->next_block == 103);
+        registry.on_unwind(110);
+        CHECK(registry.logs_cursor(id)->next_block == 103);
+    }
+
+    SECTION("logs filter not advanced past blocks unwound while polling") {
+        const auto id = registry.add_logs_filter(Filter{}, 100);
+        // A poll reads the cursor and scans blocks 100-110, meanwhile blocks from 105 are unwound
+        const auto cursor = *registry.logs_cursor(id);
+        registry.on_unwind(105);
+        CHECK(registry.logs_cursor(id)->next_block == 100);
+        CHECK(!registry.advance_logs_cursor(id, cursor, 111));
+        CHECK(registry.logs_cursor(id)->next_block == 100);
+        // The next poll scans the blocks again and then moves on
+        const auto new_cursor = *registry.logs_cursor(id);
+        CHECK(registry.advance_logs_cursor(id, new_cursor, 111));
+        CHECK(registry.logs_cursor(id)->next_block == 111);
+    }
+
+    SECTION("pending transaction filter") {
+        const auto id = registry.add_pending_transaction_filter();
+        CHECK(registry.type(id) == FilterType::pending_transaction);
+        CHECK(registry.remove(id));
+        CHECK(!registry.type(id));
+    }
+
+    SECTION("expiration") {
+        registry.add_block_filter();
+        CHECK(registry.expire(FilterRegistry::Clock::now()) == 0);
+        CHECK(registry.expire(FilterRegistry::Clock::now() + kDefaultFilterTimeout + std::chrono::seconds{1}) == 1);
+        CHECK(registry.size() == 0);
+    }
+
+    SECTION("expired filter not found") {
+        FilterRegistry short_lived_registry{std::chrono::milliseconds{0}};
+        const auto id = short_lived_registry.add_block_filter();
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        CHECK(!short_lived_registry.type(id));
+        CHECK(short_lived_registry.size() == 0);
+    }
+
+    SECTION("too many filters") {
+        for (std::size_t i{0}; i < kMaxInstalledFilters; ++i) {
+            registry.add_block_filter();
+        }
+        CHECK_THROWS_AS(registry.add_block_filter(), std::runtime_error);
+    }
+}
+
+} // namespace silkrpc
@@ -35,12 +35,74 @@ struct PriceComparator {
     }
 };
 
+std::optional<BlockPriceSamples> GasPriceWindow::get(uint64_t block_number, const evmc::bytes32& hash) const {
+    const std::lock_guard<std::mutex> lock(access_);
+    const auto& slot = ring_[block_number % ring_.size()];
+    if (slot && slot->block_number == block_number && slot->hash == hash) {
+        return slot;
+    }
+    return std::nullopt;
+}
+
+void GasPriceWindow::insert(const BlockPriceSamples& samples) {
+    const std::lock_guard<std::mutex> lock(access_);
+    ring_[samples.block_number % ring_.size()] = samples;
+}
+
+std::optional<intx::uint256> GasPriceWindow::suggested_price(const evmc::bytes32& head_hash) const {
+    const std::lock_guard<std::mutex> lock(access_);
+    if (head_price_ && head_price_->first == head_hash) {
+        return head_price_->second;
+    }
+    return std::nullopt;
+}
+
+void GasPriceWindow::set_suggested_price(const evmc::bytes32& head_hash, const intx::uint256& price) {
+    const std::lock_guard<std::mutex> lock(access_);
+    head_price_ = std::make_pair(head_hash, price);
+}
+
+void GasPriceWindow::on_new_block(uint64_t block_number, const evmc::bytes32& hash) {
+    const std::lock_guard<std::mutex> lock(access_);
+    // Samples of a different block at the same height come from a fork that is no longer canonical
+    auto& slot = ring_[block_number % ring_.size()];
+    if (slot && slot->block_number == block_number && slot->hash != hash) {
+        slot.reset();
+    }
+}
+
+void GasPriceWindow::on_unwind(uint64_t block_number) {
+    const std::lock_guard<std::mutex> lock(access_);
+    for (auto& slot : ring_) {
+        if (slot && slot->block_number >= block_number) {
+            slot.reset();
+        }
+    }
+    head_price_.reset();
+}
+
 boost::asio::awaitable<intx::uint256> GasPriceOracle::suggested_price(uint64_t block_number) {
     SILKRPC_INFO << "GasPriceOracle::suggested_price starting block: " << block_number << "\n";
+
+    // The price for the current head is computed just once, then block samples are chained backwards by parent hash
+    evmc::bytes32 expected_hash{};
+    if (window_ != nullptr && block_number > 0) {
+        const auto head_block_with_hash = co_await block_provider_(block_number);
+        expected_hash = head_block_with_hash.hash;
+        const auto head_price = window_->suggested_price(expected_hash);
+        if (head_price) {
+            SILKRPC_INFO << "GasPriceOracle::suggested_price price: 0x" << intx::hex(*head_price) << " from window\n";
+            co_return *head_price;
+        }
+    }
+    const auto head_hash = expected_hash;
+
     std::vector<intx::uint256> tx_prices;
     tx_prices.reserve(kMaxSamples);
     while (tx_prices.size() < kMaxSamples && block_number > 0) {
-        co_await load_block_prices(block_number--, kSamples, tx_prices);
+        const auto block_prices = co_await load_block_prices(block_number--, expected_hash);
+        tx_prices.insert(tx_prices.end(), block_prices.prices.begin(), block_prices.prices.end());
+        expected_hash = block_prices.parent_hash;
     }
     SILKRPC_INFO << "GasPriceOracle::suggested_price ending block: " << block_number << "\n";
 
@@ -61,15 +123,35 @@ boost::asio::awaitable<intx::uint256> GasPriceOracle::suggested_price(uint64_t b
         price = silkrpc::kDefaultMaxPrice;
     }
 
+    if (window_ != nullptr && head_hash != evmc::bytes32{}) {
+        window_->set_suggested_price(head_hash, price);
+    }
+
     SILKRPC_INFO << "GasPriceOracle::suggested_price price: 0x" << intx::hex(price) << "\n";
 
     co_return price;
 }
 
-boost::asio::awaitable<void> GasPriceOracle::load_block_prices(uint64_t block_number, uint64_t limit, std::vector<intx::uint256>& tx_prices) {
+boost::asio::awaitable<BlockPriceSamples> GasPriceOracle::load_block_prices(uint64_t block_number, const evmc::bytes32& expected_hash) {
     SILKRPC_TRACE << "GasPriceOracle::load_block_prices processing block: " << block_number << "\n";
 
+    if (window_ != nullptr) {
+        auto cached_prices = window_->get(block_number, expected_hash);
+        if (cached_prices) {
+            co_return std::move(*cached_prices);
+        }
+    }
+
     const auto block_with_hash = co_await block_provider_(block_number);
+    auto block_prices = make_block_price_samples(block_with_hash, kSamples);
+    if (window_ != nullptr) {
+        window_->insert(block_prices);
+    }
+
+    co_return block_prices;
+}
+
+BlockPriceSamples make_block_price_samples(const silkworm::BlockWithHash& block_with_hash, uint64_t limit) {
     const auto &base_fee = block_with_hash.block.header.base_fee_per_gas.value_or(0);
     const auto &coinbase = block_with_hash.block.header.beneficiary;
 
@@ -100,13 +182,19 @@ boost::asio::awaitable<void> GasPriceOracle::load_block_prices(uint64_t block_nu
     }
 
     std::sort(block_prices.begin(), block_prices.end(), PriceComparator());
+    if (block_prices.size() > limit) {
+        block_prices.resize(limit);
+    }
 
-    for (int count = 0; const auto& priority_fee_per_gas  : block_prices) {
+    for (const auto& priority_fee_per_gas  : block_prices) {
         SILKRPC_TRACE << " priority_fee_per_gas : 0x" <<  intx::hex(priority_fee_per_gas ) << "\n";
-        tx_prices.push_back(priority_fee_per_gas );
-        if (++count >= limit) {
-            break;
-        }
     }
+
+    BlockPriceSamples samples;
+    samples.block_number = block_with_hash.block.header.number;
+    samples.hash = block_with_hash.hash;
+    samples.parent_hash = block_with_hash.block.header.parent_hash;
+    samples.prices = std::move(block_prices);
+    return samples;
 }
 } // namespace silkrpc
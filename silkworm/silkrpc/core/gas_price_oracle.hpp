@@ -17,7 +17,10 @@
 #pragma once
 
 #include <functional>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <silkworm/silkrpc/config.hpp> // NOLINT(build/include_order)
@@ -47,9 +50,51 @@ const std::uint8_t kPercentile = 60;
 
 typedef std::function<boost::asio::awaitable<silkworm::BlockWithHash>(uint64_t)> BlockProvider;
 
+//! The lowest priority fees of the transactions in one block, sorted in ascending order
+struct BlockPriceSamples {
+    uint64_t block_number{0};
+    evmc::bytes32 hash;
+    evmc::bytes32 parent_hash;
+    std::vector<intx::uint256> prices;
+};
+
+//! Extract the lowest priority fees paid in the given block, at most limit of them
+BlockPriceSamples make_block_price_samples(const silkworm::BlockWithHash& block_with_hash, uint64_t limit);
+
+//! Sliding window of per-block price samples shared among requests, kept in sync with the chain head
+class GasPriceWindow {
+public:
+    explicit GasPriceWindow(std::size_t capacity = kMaxSamples) : ring_(capacity == 0 ? 1 : capacity) {}
+
+    GasPriceWindow(const GasPriceWindow&) = delete;
+    GasPriceWindow& operator=(const GasPriceWindow&) = delete;
+
+    //! Return the samples of the block identified by number and hash, if present
+    std::optional<BlockPriceSamples> get(uint64_t block_number, const evmc::bytes32& hash) const;
+
+    void insert(const BlockPriceSamples& samples);
+
+    //! Return the suggested price already computed for the given chain head, if any
+    std::optional<intx::uint256> suggested_price(const evmc::bytes32& head_hash) const;
+
+    void set_suggested_price(const evmc::bytes32& head_hash, const intx::uint256& price);
+
+    //! Notify that a new block has been added to the canonical chain
+    void on_new_block(uint64_t block_number, const evmc::bytes32& hash);
+
+    //! Notify that the given block and all its descendants have been removed from the canonical chain
+    void on_unwind(uint64_t block_number);
+
+private:
+    mutable std::mutex access_;
+    std::vector<std::optional<BlockPriceSamples>> ring_;
+    std::optional<std::pair<evmc::bytes32, intx::uint256>> head_price_;
+};
+
 class GasPriceOracle {
 public:
-    explicit GasPriceOracle(const BlockProvider& block_provider) : block_provider_(block_provider) {}
+    explicit GasPriceOracle(const BlockProvider& block_provider, GasPriceWindow* window = nullptr)
+        : block_provider_(block_provider), window_(window) {}
     virtual ~GasPriceOracle() {}
 
     GasPriceOracle(const GasPriceOracle&) = delete;
@@ -58,9 +103,10 @@ public:
     boost::asio::awaitable<intx::uint256> suggested_price(uint64_t block_number);
 
 private:
-    boost::asio::awaitable<void> load_block_prices(uint64_t block_number, uint64_t limit, std::vector<intx::uint256>& tx_prices);
+    boost::asio::awaitable<BlockPriceSamples> load_block_prices(uint64_t block_number, const evmc::bytes32& expected_hash);
 
     const BlockProvider& block_provider_;
+    GasPriceWindow* window_;
 };
 
 } // namespace silkrpc
@@ -473,4 +473,112 @@ TEST_CASE("suggested price") {
     }
 }
 
+
+static void link_blocks(std::vector<silkworm::BlockWithHash>& blocks, uint8_t fork_id = 0) {
+    for (std::size_t idx = 0; idx < blocks.size(); idx++) {
+        blocks[idx].hash = evmc::bytes32{idx + 1};
+        blocks[idx].hash.bytes[0] = fork_id;
+        if (idx > 0) {
+            blocks[idx].block.header.parent_hash = blocks[idx - 1].hash;
+        }
+    }
+}
+
+TEST_CASE("gas price window") {
+    GasPriceWindow window{4};
+    BlockPriceSamples samples{10, evmc::bytes32{10}, evmc::bytes32{9}, {1, 2, 3}};
+    window.insert(samples);
+
+    SECTION("get by number and hash") {
+        CHECK(window.get(10, evmc::bytes32{10}));
+        CHECK(window.get(10, evmc::bytes32{10})->prices.size() == 3);
+        CHECK(!window.get(10, evmc::bytes32{11}));
+        CHECK(!window.get(14, evmc::bytes32{10}));
+    }
+
+    SECTION("oldest block overwritten when window slides") {
+        window.insert(BlockPriceSamples{14, evmc::bytes32{14}, evmc::bytes32{13}, {}});
+        CHECK(!window.get(10, evmc::bytes32{10}));
+        CHECK(window.get(14, evmc::bytes32{14}));
+    }
+
+    SECTION("new block at same height drops samples from fork") {
+        window.on_new_block(10, evmc::bytes32{10});
+        CHECK(window.get(10, evmc::bytes32{10}));
+        window.on_new_block(10, evmc::bytes32{0xff});
+        CHECK(!window.get(10, evmc::bytes32{10}));
+    }
+
+    SECTION("unwind drops samples and suggested price") {
+        window.set_suggested_price(evmc::bytes32{10}, intx::uint256{7});
+        CHECK(window.suggested_price(evmc::bytes32{10}) == intx::uint256{7});
+        CHECK(!window.suggested_price(evmc::bytes32{11}));
+        window.on_unwind(10);
+        CHECK(!window.get(10, evmc::bytes32{10}));
+        CHECK(!window.suggested_price(evmc::bytes32{10}));
+    }
+}
+
+TEST_CASE("suggested price with window") {
+    boost::asio::thread_pool pool{1};
+
+    std::vector<silkworm::BlockWithHash> blocks;
+    uint64_t provider_calls{0};
+    BlockProvider block_provider = [&](uint64_t block_number) -> boost::asio::awaitable<silkworm::BlockWithHash> {
+        ++provider_calls;
+        co_return blocks[block_number];
+    };
+    GasPriceWindow window;
+    GasPriceOracle gas_price_oracle{block_provider, &window};
+
+    FixedBlockData data = {0x7, 0x32, 0x32, 0x32, 0x32};
+    blocks.reserve(60);
+    fill_blocks_vector(blocks, kBeneficiary, data);
+    link_blocks(blocks);
+
+    SECTION("same price as without window") {
+        GasPriceOracle plain_oracle{block_provider};
+        const auto expected_price = boost::asio::co_spawn(pool, plain_oracle.suggested_price(59), boost::asio::use_future).get();
+        const auto price = boost::asio::co_spawn(pool, gas_price_oracle.suggested_price(59), boost::asio::use_future).get();
+        CHECK(price == expected_price);
+    }
+
+    SECTION("price memoized for same head") {
+        boost::asio::co_spawn(pool, gas_price_oracle.suggested_price(59), boost::asio::use_future).get();
+        provider_calls = 0;
+        boost::asio::co_spawn(pool, gas_price_oracle.suggested_price(59), boost::asio::use_future).get();
+        CHECK(provider_calls == 1);
+    }
+
+    SECTION("only new head block loaded when chain advances") {
+        blocks.pop_back();
+        boost::asio::co_spawn(pool, gas_price_oracle.suggested_price(58), boost::asio::use_future).get();
+        blocks.push_back(allocate_block(59, kBeneficiary, FixedBlockData{0x7, 0x40, 0x40, 0x40, 0x40}));
+        link_blocks(blocks);
+        provider_calls = 0;
+        boost::asio::co_spawn(pool, gas_price_oracle.suggested_price(59), boost::asio::use_future).get();
+        CHECK(provider_calls == 2);
+    }
+
+    SECTION("only head looked up when new block samples are notified") {
+        blocks.pop_back();
+        boost::asio::co_spawn(pool, gas_price_oracle.suggested_price(58), boost::asio::use_future).get();
+        blocks.push_back(allocate_block(59, kBeneficiary, FixedBlockData{0x7, 0x40, 0x40, 0x40, 0x40}));
+        link_blocks(blocks);
+        window.insert(make_block_price_samples(blocks[59], kSamples));
+        provider_calls = 0;
+        boost::asio::co_spawn(pool, gas_price_oracle.suggested_price(59), boost::asio::use_future).get();
+        CHECK(provider_calls == 1);
+    }
+
+    SECTION("samples from unwound fork are not used") {
+        boost::asio::co_spawn(pool, gas_price_oracle.suggested_price(59), boost::asio::use_future).get();
+        blocks.clear();
+        fill_blocks_vector(blocks, kBeneficiary, FixedBlockData{0x7, 0x40, 0x40, 0x40, 0x40});
+        link_blocks(blocks, 1);
+        const auto price = boost::asio::co_spawn(pool, gas_price_oracle.suggested_price(59), boost::asio::use_future).get();
+        CHECK(price == 0x39);  // priority fee is capped by max_fee_per_gas - base_fee
+    }
+}
+
 } // namespace silkrpc
@@ -0,0 +1,169 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "logs_extractor.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <boost/asio/compose.hpp>
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <silkworm/silkrpc/common/log.hpp>
+#include <silkworm/silkrpc/ethdb/cbor.hpp>
+
+namespace silkrpc {
+
+// Lanes are loaded concurrently only when there is enough work for each of them
+const uint64_t kMinBlocksPerLogsLane = 16;
+
+// Blocks per lane loaded at once when streaming, bounding the logs held in memory
+const uint64_t kMaxBlocksPerLogsLaneWindow = 64;
+
+std::vector<Logs> decode_block_logs(const std::vector<BlockLogChunks>& blocks_chunks, const LogsFilter& filter) {
+    std::vector<Logs> blocks_logs;
+    blocks_logs.reserve(blocks_chunks.size());
+    for (const auto& block_chunks : blocks_chunks) {
+        uint32_t log_index{0};
+        Logs block_logs;
+        for (const auto& chunk : block_chunks.chunks) {
+            Logs chunk_logs{};
+            if (!cbor_decode(chunk.data, chunk_logs)) {
+                SILKRPC_WARN << "invalid logs encoding in block: " << block_chunks.block_number << " tx_index: " << chunk.tx_index << "\n";
+                break;
+            }
+            for (auto& log : chunk_logs) {
+                log.index = log_index++;
+            }
+            filter.apply(chunk_logs);
+            for (auto& log : chunk_logs) {
+                log.block_number = block_chunks.block_number;
+                log.tx_index = chunk.tx_index;
+            }
+            std::move(chunk_logs.begin(), chunk_logs.end(), std::back_inserter(block_logs));
+        }
+        blocks_logs.push_back(std::move(block_logs));
+    }
+    return blocks_logs;
+}
+
+boost::asio::awaitable<std::vector<Logs>> async_decode_block_logs(boost::asio::io_context& io_context, boost::asio::thread_pool& workers,
+                                                                  const std::vector<BlockLogChunks>& blocks_chunks, const LogsFilter& filter) {
+    // The exception pointer passed to the completion is rethrown on the awaiting coroutine
+    auto blocks_logs = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(std::exception_ptr, std::vector<Logs>)>(
+        [&](auto&& self) {
+            boost::asio::post(workers, [&, self = std::move(self)]() mutable {
+                std::exception_ptr eptr;
+                std::vector<Logs> blocks_logs;
+                try {
+                    blocks_logs = decode_block_logs(blocks_chunks, filter);
+                } catch (...) {
+                    eptr = std::current_exception();
+                }
+                boost::asio::post(io_context, [eptr, blocks_logs = std::move(blocks_logs), self = std::move(self)]() mutable {
+                    self.complete(eptr, std::move(blocks_logs));
+                });
+            });
+        },
+        boost::asio::use_awaitable);
+    co_return blocks_logs;
+}
+
+std::vector<std::vector<uint64_t>> LogsExtractor::make_lanes(const roaring::Roaring& block_numbers) const {
+    const uint64_t block_count = block_numbers.cardinality();
+    const uint64_t max_lanes = std::max<uint64_t>(1, settings_.parallelism);
+    const uint64_t lane_count = std::clamp<uint64_t>(block_count / kMinBlocksPerLogsLane, 1, max_lanes);
+    const uint64_t lane_size = (block_count + lane_count - 1) / lane_count;
+
+    std::vector<std::vector<uint64_t>> lanes;
+    lanes.reserve(lane_count);
+    uint64_t position{0};
+    for (const auto block_number : block_numbers) {
+        if (position % lane_size == 0) {
+            lanes.emplace_back();
+            lanes.back().reserve(lane_size);
+        }
+        lanes.back().push_back(block_number);
+        ++position;
+    }
+    return lanes;
+}
+
+boost::asio::awaitable<Logs> LogsExtractor::extract(const roaring::Roaring& block_numbers) {
+    check_block_budget(block_numbers);
+    if (block_numbers.isEmpty()) {
+        co_return Logs{};
+    }
+
+    const auto lanes = make_lanes(block_numbers);
+    SILKRPC_DEBUG << "LogsExtractor::extract blocks: " << block_numbers.cardinality() << " lanes: " << lanes.size() << "\n";
+
+    co_return co_await load_lanes(lanes, 0, lanes.size());
+}
+
+boost::asio::awaitable<void> LogsExtractor::extract(const roaring::Roaring& block_numbers, const LogsConsumer& consumer) {
+    check_block_budget(block_numbers);
+
+    const uint64_t window_size = std::max<uint64_t>(1, settings_.parallelism) * kMaxBlocksPerLogsLaneWindow;
+    SILKRPC_DEBUG << "LogsExtractor::extract blocks: " << block_numbers.cardinality() << " window: " << window_size << "\n";
+
+    roaring::Roaring window;
+    uint64_t window_count{0};
+    for (const auto block_number : block_numbers) {
+        window.add(block_number);
+        if (++window_count == window_size) {
+            const auto lanes = make_lanes(window);
+            consumer(co_await load_lanes(lanes, 0, lanes.size()));
+            window = roaring::Roaring{};
+            window_count = 0;
+        }
+    }
+    if (!window.isEmpty()) {
+        const auto lanes = make_lanes(window);
+        consumer(co_await load_lanes(lanes, 0, lanes.size()));
+    }
+}
+
+void LogsExtractor::check_block_budget(const roaring::Roaring& block_numbers) const {
+    const uint64_t block_count = block_numbers.cardinality();
+    if (settings_.block_budget != 0 && block_count > settings_.block_budget) {
+        throw std::runtime_error{"too many blocks to scan for logs: " + std::to_string(block_count) +
+            " exceeds limit " + std::to_string(settings_.block_budget)};
+    }
+}
+
+boost::asio::awaitable<Logs> LogsExtractor::load_lanes(const std::vector<std::vector<uint64_t>>& lanes, std::size_t first, std::size_t count) {
+    using namespace boost::asio::experimental::awaitable_operators;
+
+    if (count == 1) {
+        co_return co_await lane_loader_(lanes[first]);
+    }
+
+    // Split in halves awaited together: the lane count is dynamic while the awaitable operators have fixed arity
+    const auto half = count / 2;
+    auto [logs, right_logs] = co_await (load_lanes(lanes, first, half) && load_lanes(lanes, first + half, count - half));
+    logs.reserve(logs.size() + right_logs.size());
+    std::move(right_logs.begin(), right_logs.end(), std::back_inserter(logs));
+    co_return logs;
+}
+
+} // namespace silkrpc
@@ -0,0 +1,101 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <silkworm/silkrpc/config.hpp> // NOLINT(build/include_order)
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <croaring/roaring.hh>
+#include <silkworm/core/common/base.hpp>
+
+#include <silkworm/silkrpc/core/logs_filter.hpp>
+#include <silkworm/silkrpc/types/log.hpp>
+
+namespace silkrpc {
+
+const std::size_t kDefaultLogsParallelism = 4;
+const uint64_t kDefaultLogsBlockBudget = 100'000;
+const uint64_t kDefaultLogsTipWindow = 128;
+
+//! Bounds on the block scan performed by a single logs request
+struct LogsSettings {
+    //! Max number of block lanes read concurrently, each one on its own transaction
+    std::size_t parallelism{kDefaultLogsParallelism};
+    //! Max number of matching blocks scanned by one request, zero means unlimited
+    uint64_t block_budget{kDefaultLogsBlockBudget};
+    //! Number of most recent blocks whose logs are indexed in memory, zero means disabled
+    uint64_t tip_window{kDefaultLogsTipWindow};
+};
+
+//! One CBOR-encoded chunk of logs stored for a transaction
+struct LogChunk {
+    uint32_t tx_index{0};
+    silkworm::Bytes data;
+};
+
+//! The log chunks stored for one block, in transaction order
+struct BlockLogChunks {
+    uint64_t block_number{0};
+    std::vector<LogChunk> chunks;
+};
+
+//! Decode the log chunks of each block assigning block-wide log indices, then keep the matching ones
+std::vector<Logs> decode_block_logs(const std::vector<BlockLogChunks>& blocks_chunks, const LogsFilter& filter);
+
+//! Same as decode_block_logs but performed on the worker threads, resuming on the I/O context
+boost::asio::awaitable<std::vector<Logs>> async_decode_block_logs(boost::asio::io_context& io_context, boost::asio::thread_pool& workers,
+                                                                  const std::vector<BlockLogChunks>& blocks_chunks, const LogsFilter& filter);
+
+//! Load the matching logs of the given ascending blocks, in block order
+typedef std::function<boost::asio::awaitable<Logs>(std::vector<uint64_t>)> LogsLaneLoader;
+
+//! Receive the matching logs of consecutive block windows, in block order
+typedef std::function<void(const Logs&)> LogsConsumer;
+
+class LogsExtractor {
+public:
+    explicit LogsExtractor(const LogsLaneLoader& lane_loader, const LogsSettings& settings = {})
+        : lane_loader_(lane_loader), settings_(settings) {}
+
+    LogsExtractor(const LogsExtractor&) = delete;
+    LogsExtractor& operator=(const LogsExtractor&) = delete;
+
+    //! Split the blocks into lanes loaded concurrently, then merge their logs in block order
+    boost::asio::awaitable<Logs> extract(const roaring::Roaring& block_numbers);
+
+    //! Same as extract but handing the logs over one block window at a time, so that memory is bounded by the window
+    boost::asio::awaitable<void> extract(const roaring::Roaring& block_numbers, const LogsConsumer& consumer);
+
+    //! Split the blocks into at most settings.parallelism contiguous lanes
+    std::vector<std::vector<uint64_t>> make_lanes(const roaring::Roaring& block_numbers) const;
+
+private:
+    void check_block_budget(const roaring::Roaring& block_numbers) const;
+
+    boost::asio::awaitable<Logs> load_lanes(const std::vector<std::vector<uint64_t>>& lanes, std::size_t first, std::size_t count);
+
+    const LogsLaneLoader& lane_loader_;
+    LogsSettings settings_;
+};
+
+} // namespace silkrpc
@@ -0,0 +1,162 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "logs_extractor.hpp"
+
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+#include <silkworm/core/common/util.hpp>
+
+namespace silkrpc {
+
+using evmc::literals::operator""_address;
+
+TEST_CASE("decode block logs", "[silkrpc][core][logs_extractor]") {
+    // Two logs from two different addresses, then one more log
+    const auto two_logs = *silkworm::from_hex(
+        "82"
+        "83540715a7794a1dc8e42615f059dd6e406a6594651a80f6"
+        "8354007fb8417eb9ad4d958b050fc3720d5b46a2c053805000110011001100110011001100110011");
+    const auto one_log = *silkworm::from_hex("818354ea674fdde714fd979de3edf0f56aa9716b898ec88043010043");
+    const std::vector<BlockLogChunks> blocks_chunks{
+        {10, {{0, two_logs}, {2, one_log}}},
+        {11, {}},
+        {12, {{1, one_log}}},
+    };
+
+    SECTION("all logs") {
+        const auto blocks_logs = decode_block_logs(blocks_chunks, LogsFilter{Filter{}});
+        CHECK(blocks_logs.size() == 3);
+        CHECK(blocks_logs[0].size() == 3);
+        CHECK(blocks_logs[0][2].address == 0xea674fdde714fd979de3edf0f56aa9716b898ec8_address);
+        CHECK(blocks_logs[0][2].index == 2);
+        CHECK(blocks_logs[0][2].tx_index == 2);
+        CHECK(blocks_logs[0][2].block_number == 10);
+        CHECK(blocks_logs[1].empty());
+        CHECK(blocks_logs[2].size() == 1);
+        CHECK(blocks_logs[2][0].index == 0);
+        CHECK(blocks_logs[2][0].tx_index == 1);
+        CHECK(blocks_logs[2][0].block_number == 12);
+    }
+
+    SECTION("filtered logs keep block-wide indices") {
+        Filter filter;
+        filter.addresses = FilterAddresses{0x007fb8417eb9ad4d958b050fc3720d5b46a2c053_address};
+        const auto blocks_logs = decode_block_logs(blocks_chunks, LogsFilter{filter});
+        CHECK(blocks_logs[0].size() == 1);
+        CHECK(blocks_logs[0][0].index == 1);
+        CHECK(blocks_logs[0][0].tx_index == 0);
+        CHECK(blocks_logs[2].empty());
+    }
+}
+
+TEST_CASE("logs extractor", "[silkrpc][core][logs_extractor]") {
+    boost::asio::thread_pool pool{2};
+
+    std::mutex lanes_mutex;
+    std::vector<std::vector<uint64_t>> loaded_lanes;
+    LogsLaneLoader lane_loader = [&](std::vector<uint64_t> block_numbers) -> boost::asio::awaitable<Logs> {
+        {
+            std::lock_guard lock{lanes_mutex};
+            loaded_lanes.push_back(block_numbers);
+        }
+        Logs logs;
+        for (const auto block_number : block_numbers) {
+            logs.push_back(Log{.block_number = block_number});
+        }
+        co_return logs;
+    };
+
+    SECTION("no blocks") {
+        LogsExtractor extractor{lane_loader};
+        const auto logs = boost::asio::co_spawn(pool, extractor.extract(roaring::Roaring{}), boost::asio::use_future).get();
+        CHECK(logs.empty());
+        CHECK(loaded_lanes.empty());
+    }
+
+    SECTION("few blocks use one lane") {
+        LogsExtractor extractor{lane_loader};
+        roaring::Roaring block_numbers;
+        block_numbers.addRange(100, 110);
+        const auto logs = boost::asio::co_spawn(pool, extractor.extract(block_numbers), boost::asio::use_future).get();
+        CHECK(logs.size() == 10);
+        CHECK(loaded_lanes.size() == 1);
+    }
+
+    SECTION("many blocks merged in block order") {
+        LogsExtractor extractor{lane_loader, LogsSettings{.parallelism = 3, .block_budget = 0}};
+        roaring::Roaring block_numbers;
+        block_numbers.addRange(0, 1000);
+        block_numbers.remove(500);
+        const auto lanes = extractor.make_lanes(block_numbers);
+        CHECK(lanes.size() == 3);
+        CHECK(lanes.front().front() == 0);
+        CHECK(lanes.back().back() == 999);
+
+        const auto logs = boost::asio::co_spawn(pool, extractor.extract(block_numbers), boost::asio::use_future).get();
+        CHECK(loaded_lanes.size() == 3);
+        REQUIRE(logs.size() == 999);
+        for (std::size_t i{1}; i < logs.size(); ++i) {
+            CHECK(logs[i - 1].block_number < logs[i].block_number);
+        }
+    }
+
+    SECTION("many blocks streamed by window in block order") {
+        LogsExtractor extractor{lane_loader, LogsSettings{.parallelism = 2, .block_budget = 0}};
+        roaring::Roaring block_numbers;
+        block_numbers.addRange(0, 300);
+        std::vector<std::size_t> window_sizes;
+        Logs logs;
+        const auto consumer = [&](const Logs& window_logs) {
+            window_sizes.push_back(window_logs.size());
+            logs.insert(logs.end(), window_logs.begin(), window_logs.end());
+        };
+        boost::asio::co_spawn(pool, extractor.extract(block_numbers, consumer), boost::asio::use_future).get();
+        CHECK(window_sizes == std::vector<std::size_t>{128, 128, 44});
+        REQUIRE(logs.size() == 300);
+        for (std::size_t i{1}; i < logs.size(); ++i) {
+            CHECK(logs[i - 1].block_number < logs[i].block_number);
+        }
+    }
+
+    SECTION("block budget exceeded") {
+        LogsExtractor extractor{lane_loader, LogsSettings{.parallelism = 2, .block_budget = 50}};
+        roaring::Roaring block_numbers;
+        block_numbers.addRange(0, 51);
+        CHECK_THROWS_AS(boost::asio::co_spawn(pool, extractor.extract(block_numbers), boost::asio::use_future).get(), std::runtime_error);
+        CHECK(loaded_lanes.empty());
+    }
+
+    SECTION("lane failure") {
+        LogsLaneLoader failing_loader = [](std::vector<uint64_t>) -> boost::asio::awaitable<Logs> {
+            throw std::runtime_error{"lane failure"};
+            co_return Logs{};
+        };
+        LogsExtractor extractor{failing_loader};
+        roaring::Roaring block_numbers;
+        block_numbers.addRange(0, 100);
+        CHECK_THROWS_AS(boost::asio::co_spawn(pool, extractor.extract(block_numbers), boost::asio::use_future).get(), std::runtime_error);
+    }
+}
+
+} // namespace silkrpc
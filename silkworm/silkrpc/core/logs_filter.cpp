@@ -0,0 +1,73 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "logs_filter.hpp"
+
+#include <algorithm>
+
+namespace silkrpc {
+
+// Below this size a linear scan over the contiguous array beats binary search
+const std::size_t kMaxLinearScanSize = 8;
+
+template <typename T>
+static std::vector<T> make_alternatives(const std::vector<T>& values) {
+    std::vector<T> alternatives{values};
+    std::sort(alternatives.begin(), alternatives.end());
+    alternatives.erase(std::unique(alternatives.begin(), alternatives.end()), alternatives.end());
+    return alternatives;
+}
+
+template <typename T>
+static bool contains(const std::vector<T>& alternatives, const T& value) {
+    if (alternatives.size() <= kMaxLinearScanSize) {
+        return std::find(alternatives.cbegin(), alternatives.cend(), value) != alternatives.cend();
+    }
+    return std::binary_search(alternatives.cbegin(), alternatives.cend(), value);
+}
+
+LogsFilter::LogsFilter(const Filter& filter) {
+    if (filter.addresses) {
+        addresses_ = make_alternatives(*filter.addresses);
+    }
+    if (filter.topics) {
+        topics_.reserve(filter.topics->size());
+        for (const auto& subtopics : *filter.topics) {
+            topics_.push_back(make_alternatives(subtopics));
+        }
+    }
+}
+
+bool LogsFilter::matches(const Log& log) const {
+    if (addresses_ && !contains(*addresses_, log.address)) {
+        return false;
+    }
+    if (topics_.size() > log.topics.size()) {
+        return false;
+    }
+    for (std::size_t i{0}; i < topics_.size(); ++i) {
+        if (!topics_[i].empty() && !contains(topics_[i], log.topics[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LogsFilter::apply(Logs& logs) const {
+    std::erase_if(logs, [&](const Log& log) { return !matches(log); });
+}
+
+} // namespace silkrpc
@@ -0,0 +1,51 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+
+#include <silkworm/silkrpc/types/filter.hpp>
+#include <silkworm/silkrpc/types/log.hpp>
+
+namespace silkrpc {
+
+//! Log filter compiled once per request: address and topic alternatives are kept in sorted flat arrays
+class LogsFilter {
+public:
+    explicit LogsFilter(const Filter& filter);
+
+    //! Match the log against the addresses and the positional topic alternatives (empty alternatives match any topic)
+    [[nodiscard]] bool matches(const Log& log) const;
+
+    //! Erase the logs not matching, without copying the matching ones
+    void apply(Logs& logs) const;
+
+    //! The sorted address alternatives, if any
+    const std::optional<std::vector<evmc::address>>& addresses() const noexcept { return addresses_; }
+
+    //! The sorted topic alternatives for each position
+    const std::vector<std::vector<evmc::bytes32>>& topics() const noexcept { return topics_; }
+
+private:
+    std::optional<std::vector<evmc::address>> addresses_;
+    std::vector<std::vector<evmc::bytes32>> topics_;
+};
+
+} // namespace silkrpc
@@ -0,0 +1,191 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "logs_filter.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+
+namespace silkrpc {
+
+using evmc::literals::operator""_address;
+using evmc::literals::operator""_bytes32;
+
+static const evmc::bytes32 kTransferTopic{0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef_bytes32};
+static const evmc::bytes32 kApprovalTopic{0x8c5be1e5ebec7d5bd14f71427d1e84f3dd0314c0f7b2291e5b200ac8c7c3b925_bytes32};
+
+static Log make_log(const evmc::address& address, const std::vector<evmc::bytes32>& topics) {
+    Log log;
+    log.address = address;
+    log.topics = topics;
+    return log;
+}
+
+//! Straightforward matching used as reference for the compiled filter
+static bool reference_matches(const Log& log, const Filter& filter) {
+    if (filter.addresses && std::find(filter.addresses->begin(), filter.addresses->end(), log.address) == filter.addresses->end()) {
+        return false;
+    }
+    if (filter.topics) {
+        if (filter.topics->size() > log.topics.size()) {
+            return false;
+        }
+        for (std::size_t i{0}; i < filter.topics->size(); ++i) {
+            const auto& subtopics = (*filter.topics)[i];
+            if (!subtopics.empty() && std::find(subtopics.begin(), subtopics.end(), log.topics[i]) == subtopics.end()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static evmc::address make_address(uint64_t n) {
+    evmc::address address;
+    std::memcpy(address.bytes, &n, sizeof(n));
+    return address;
+}
+
+static evmc::bytes32 make_topic(uint64_t n) {
+    evmc::bytes32 topic;
+    std::memcpy(topic.bytes + 24, &n, sizeof(n));
+    return topic;
+}
+
+//! Synthetic block range logs: few hot contracts emit most logs, mostly Transfer and Approval events
+static Logs make_logs_corpus(std::size_t log_count) {
+    std::mt19937_64 generator{42};
+    std::uniform_real_distribution<double> unit{0, 1};
+    const std::vector<evmc::bytes32> signatures{kTransferTopic, kApprovalTopic, make_topic(1), make_topic(2), make_topic(3)};
+
+    Logs logs;
+    logs.reserve(log_count);
+    for (std::size_t i{0}; i < log_count; ++i) {
+        const auto skew = unit(generator);
+        const auto contract = static_cast<uint64_t>(skew * skew * skew * 5000);
+        std::vector<evmc::bytes32> topics{signatures[static_cast<std::size_t>(skew * 10) % signatures.size()]};
+        const auto indexed_count = generator() % 3;
+        for (std::size_t j{0}; j < indexed_count; ++j) {
+            topics.push_back(make_topic(generator() % 100'000));
+        }
+        logs.push_back(make_log(make_address(contract), topics));
+    }
+    return logs;
+}
+
+static Filter make_corpus_filter(std::size_t address_count) {
+    Filter filter;
+    filter.addresses = FilterAddresses{};
+    for (uint64_t n{0}; n < address_count; ++n) {
+        filter.addresses->push_back(make_address(n * 7));
+    }
+    filter.topics = FilterTopics{{kTransferTopic, kApprovalTopic}};
+    return filter;
+}
+
+TEST_CASE("logs filter", "[silkrpc][core][logs_filter]") {
+    const auto address1{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+    const auto address2{0x007fb8417eb9ad4d958b050fc3720d5b46a2c053_address};
+
+    SECTION("empty filter matches any log") {
+        const LogsFilter logs_filter{Filter{}};
+        CHECK(logs_filter.matches(make_log(address1, {})));
+        CHECK(logs_filter.matches(make_log(address2, {kTransferTopic})));
+    }
+
+    SECTION("empty address list matches no log") {
+        Filter filter;
+        filter.addresses = FilterAddresses{};
+        CHECK(!LogsFilter{filter}.matches(make_log(address1, {})));
+    }
+
+    SECTION("address alternatives") {
+        Filter filter;
+        filter.addresses = FilterAddresses{address2, address1, address2};
+        const LogsFilter logs_filter{filter};
+        CHECK(logs_filter.matches(make_log(address1, {})));
+        CHECK(logs_filter.matches(make_log(address2, {})));
+        CHECK(!logs_filter.matches(make_log(0x0000000000000000000000000000000000000001_address, {})));
+    }
+
+    SECTION("positional topics with wildcards") {
+        Filter filter;
+        filter.topics = FilterTopics{{}, {kTransferTopic, kApprovalTopic}};
+        const LogsFilter logs_filter{filter};
+        CHECK(logs_filter.matches(make_log(address1, {make_topic(1), kApprovalTopic})));
+        CHECK(logs_filter.matches(make_log(address1, {make_topic(1), kTransferTopic, make_topic(2)})));
+        CHECK(!logs_filter.matches(make_log(address1, {kTransferTopic, make_topic(1)})));
+        CHECK(!logs_filter.matches(make_log(address1, {kTransferTopic})));
+    }
+
+    SECTION("apply keeps matching logs in order") {
+        Filter filter;
+        filter.topics = FilterTopics{{kTransferTopic}};
+        Logs logs{make_log(address1, {kTransferTopic}), make_log(address1, {kApprovalTopic}), make_log(address2, {kTransferTopic})};
+        LogsFilter{filter}.apply(logs);
+        REQUIRE(logs.size() == 2);
+        CHECK(logs[0].address == address1);
+        CHECK(logs[1].address == address2);
+    }
+
+    SECTION("same matches as reference on corpus") {
+        const auto corpus = make_logs_corpus(5'000);
+        for (const auto address_count : {std::size_t{4}, std::size_t{64}}) {
+            const auto filter = make_corpus_filter(address_count);
+            const LogsFilter logs_filter{filter};
+            for (const auto& log : corpus) {
+                CHECK(logs_filter.matches(log) == reference_matches(log, filter));
+            }
+        }
+    }
+}
+
+TEST_CASE("logs filter benchmark", "[.][silkrpc][core][logs_filter][benchmark]") {
+    const auto corpus = make_logs_corpus(50'000);
+
+    for (const auto address_count : {std::size_t{4}, std::size_t{64}}) {
+        const auto filter = make_corpus_filter(address_count);
+        const LogsFilter logs_filter{filter};
+
+        BENCHMARK_ADVANCED("reference filter #addresses: " + std::to_string(address_count))(Catch::Benchmark::Chronometer meter) {
+            std::vector<Logs> inputs(static_cast<std::size_t>(meter.runs()), corpus);
+            meter.measure([&](int i) {
+                Logs filtered_logs;
+                for (auto log : inputs[static_cast<std::size_t>(i)]) {
+                    if (reference_matches(log, filter)) {
+                        filtered_logs.push_back(log);
+                    }
+                }
+                return filtered_logs.size();
+            });
+        };
+        BENCHMARK_ADVANCED("compiled filter #addresses: " + std::to_string(address_count))(Catch::Benchmark::Chronometer meter) {
+            std::vector<Logs> inputs(static_cast<std::size_t>(meter.runs()), corpus);
+            meter.measure([&](int i) {
+                logs_filter.apply(inputs[static_cast<std::size_t>(i)]);
+                return inputs[static_cast<std::size_t>(i)].size();
+            });
+        };
+    }
+}
+
+} // namespace silkrpc
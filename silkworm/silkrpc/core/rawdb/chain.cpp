@@ -292,22 +292,36 @@ boost::asio::awaitable<Receipts> read_raw_receipts(const DatabaseReader& reader,
     co_return receipts;
 }
 
-boost::asio::awaitable<Receipts> read_receipts(const DatabaseReader& reader, const silkworm::BlockWithHash& block_with_hash) {
-    const evmc::bytes32 block_hash = block_with_hash.hash;
-    uint64_t block_number = block_with_hash.block.header.number;
-    auto receipts = co_await read_raw_receipts(reader, block_hash, block_number);
+boost::asio::awaitable<Receipts> read_receipts(const DatabaseReader& reader, const silkworm::BlockWithHash& block_with_hash,
+                                               const std::vector<evmc::bytes32>* transaction_hashes) {
+    auto receipts = co_await read_raw_receipts(reader, block_with_hash.hash, block_with_hash.block.header.number);
+    if (receipts.empty()) {
+        co_return receipts; // receipts not stored (e.g. pruned)
+    }
 
     // Add derived fields to the receipts
-    auto transactions = block_with_hash.block.transactions;
     SILKRPC_DEBUG << "#transactions=" << block_with_hash.block.transactions.size() << " #receipts=" << receipts.size() << "\n";
-    if (transactions.size() != receipts.size()) {
+    if (block_with_hash.block.transactions.size() != receipts.size()) {
         throw std::runtime_error{"#transactions and #receipts do not match in read_receipts"};
     }
+    derive_receipts_fields(receipts, block_with_hash, transaction_hashes);
+
+    co_return receipts;
+}
+
+void derive_receipts_fields(Receipts& receipts, const silkworm::BlockWithHash& block_with_hash, const std::vector<evmc::bytes32>* transaction_hashes) {
+    const evmc::bytes32 block_hash = block_with_hash.hash;
+    uint64_t block_number = block_with_hash.block.header.number;
+    const auto& transactions = block_with_hash.block.transactions;
     size_t log_index{0};
     for (size_t i{0}; i < receipts.size(); i++) {
         // The tx hash can be calculated by the tx content itself
-        auto tx_hash{hash_of_transaction(transactions[i])};
-        receipts[i].tx_hash = silkworm::to_bytes32(full_view(tx_hash.bytes));
+        if (transaction_hashes != nullptr) {
+            receipts[i].tx_hash = (*transaction_hashes)[i];
+        } else {
+            auto tx_hash{hash_of_transaction(transactions[i])};
+            receipts[i].tx_hash = silkworm::to_bytes32(full_view(tx_hash.bytes));
+        }
         receipts[i].tx_index = uint32_t(i);
 
         receipts[i].block_hash = block_hash;
@@ -339,8 +353,6 @@ boost::asio::awaitable<Receipts> read_receipts(const DatabaseReader& reader, con
             receipts[i].logs[j].removed = false;
         }
     }
-
-    co_return receipts;
 }
 
 boost::asio::awaitable<Transactions> read_canonical_transactions(const DatabaseReader& reader, uint64_t base_txn_id, uint64_t txn_count) {
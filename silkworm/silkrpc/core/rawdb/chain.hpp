@@ -77,7 +77,12 @@ boost::asio::awaitable<Addresses> read_senders(const DatabaseReader& reader, con
 
 boost::asio::awaitable<Receipts> read_raw_receipts(const DatabaseReader& reader, const evmc::bytes32& block_hash, uint64_t block_number);
 
-boost::asio::awaitable<Receipts> read_receipts(const DatabaseReader& reader, const silkworm::BlockWithHash& block_with_hash);
+//! Read the block receipts, optionally taking the transaction hashes if already known
+boost::asio::awaitable<Receipts> read_receipts(const DatabaseReader& reader, const silkworm::BlockWithHash& block_with_hash,
+                                               const std::vector<evmc::bytes32>* transaction_hashes = nullptr);
+
+//! Fill the receipt fields derived from the block and its transactions, given the raw receipts of all transactions
+void derive_receipts_fields(Receipts& receipts, const silkworm::BlockWithHash& block_with_hash, const std::vector<evmc::bytes32>* transaction_hashes = nullptr);
 
 boost::asio::awaitable<Transactions> read_canonical_transactions(const DatabaseReader& reader, uint64_t base_txn_id, uint64_t txn_count);
 
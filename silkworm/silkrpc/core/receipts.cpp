@@ -16,22 +16,156 @@
 
 #include "receipts.hpp"
 
+#include <exception>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <boost/asio/compose.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/system_error.hpp>
+
 #include <silkworm/silkrpc/common/log.hpp>
+#include <silkworm/silkrpc/common/util.hpp>
+#include <silkworm/silkrpc/core/evm_executor.hpp>
 #include <silkworm/silkrpc/core/rawdb/chain.hpp>
+#include <silkworm/silkrpc/core/remote_state.hpp>
 
 namespace silkrpc::core {
 
-boost::asio::awaitable<Receipts> get_receipts(const core::rawdb::DatabaseReader& db_reader, const silkworm::BlockWithHash& block_with_hash) {
-    const auto cached_receipts = co_await core::rawdb::read_receipts(db_reader, block_with_hash);
-    if (!cached_receipts.empty()) {
-        co_return cached_receipts;
+boost::asio::awaitable<Receipts> ReceiptsGenerator::generate(const rawdb::DatabaseReader& db_reader, const silkworm::BlockWithHash& block_with_hash) {
+    const auto& block = block_with_hash.block;
+    const auto block_number = block.header.number;
+    SILKRPC_DEBUG << "ReceiptsGenerator::generate block_number: " << block_number << " #txns: " << block.transactions.size() << "\n";
+
+    Receipts receipts;
+    if (block.transactions.empty()) {
+        co_return receipts;
+    }
+
+    const auto chain_id = co_await rawdb::read_chain_id(db_reader);
+    const auto chain_config_ptr = lookup_chain_config(chain_id);
+
+    state::RemoteState remote_state{io_context_, db_reader, block_number - 1};
+    EVMExecutor executor{io_context_, db_reader, *chain_config_ptr, workers_, block_number - 1, remote_state};
+
+    receipts.reserve(block.transactions.size());
+    uint64_t cumulative_gas_used{0};
+    for (const auto& block_transaction : block.transactions) {
+        silkworm::Transaction transaction{block_transaction};
+        if (!transaction.from) {
+            transaction.recover_sender();
+        }
+
+        const auto execution_result = co_await executor.call(block, transaction);
+        if (execution_result.pre_check_error) {
+            throw std::runtime_error{"cannot regenerate receipts for block " + std::to_string(block_number) + ": " + *execution_result.pre_check_error};
+        }
+
+        Receipt receipt;
+        receipt.success = execution_result.error_code == evmc_status_code::EVMC_SUCCESS;
+        cumulative_gas_used += transaction.gas_limit - execution_result.gas_left;
+        receipt.cumulative_gas_used = cumulative_gas_used;
+        for (const auto& log : executor.logs()) {
+            receipt.logs.push_back(Log{log.address, log.topics, log.data});
+        }
+        receipt.bloom = bloom_from_logs(receipt.logs);
+        receipts.push_back(std::move(receipt));
+
+        executor.reset();
     }
 
-    // If not already present, retrieve receipts by executing transactions
-    //auto block = co_await core::rawdb::read_block(db_reader, hash, number);
-    // TODO(canepat): implement
-    SILKRPC_WARN << "retrieve receipts by executing transactions NOT YET IMPLEMENTED\n";
-    co_return Receipts{};
+    co_return receipts;
+}
+
+boost::asio::awaitable<std::shared_ptr<const Receipts>> ReceiptsGenerator::wait_for(ReceiptsCache& receipts_cache, const evmc::bytes32& block_hash) {
+    using ReceiptsPtr = std::shared_ptr<const Receipts>;
+    const auto receipts = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(std::exception_ptr, ReceiptsPtr)>(
+        [this, &receipts_cache, &block_hash](auto&& self) {
+            auto shared_self = std::make_shared<std::decay_t<decltype(self)>>(std::move(self));
+            const bool waiting = receipts_cache.wait_regeneration(block_hash, [this, shared_self](std::exception_ptr error, ReceiptsPtr receipts) {
+                boost::asio::post(io_context_, [shared_self, error, receipts = std::move(receipts)]() mutable {
+                    shared_self->complete(error, std::move(receipts));
+                });
+            });
+            if (!waiting) {
+                boost::asio::post(io_context_, [shared_self]() mutable {
+                    shared_self->complete(nullptr, nullptr);
+                });
+            }
+        },
+        boost::asio::use_awaitable);
+    co_return receipts;
+}
+
+boost::asio::awaitable<Receipts> get_receipts(const core::rawdb::DatabaseReader& db_reader, const silkworm::BlockWithHash& block_with_hash,
+                                              BlockCache* block_cache, ReceiptsCache* receipts_cache, ReceiptsGenerator* receipts_generator) {
+    if (receipts_cache != nullptr) {
+        const auto cached_block_receipts = receipts_cache->get(block_with_hash.hash);
+        if (cached_block_receipts) {
+            co_return *cached_block_receipts;
+        }
+    }
+
+    std::shared_ptr<const TransactionHashes> transaction_hashes;
+    if (block_cache != nullptr) {
+        transaction_hashes = block_cache->transaction_hashes(block_with_hash);
+    }
+    const auto stored_receipts = co_await core::rawdb::read_receipts(db_reader, block_with_hash, transaction_hashes.get());
+    if (!stored_receipts.empty() || block_with_hash.block.transactions.empty()) {
+        if (receipts_cache != nullptr && !stored_receipts.empty()) {
+            receipts_cache->insert(block_with_hash.hash, std::make_shared<const Receipts>(stored_receipts));
+        }
+        co_return stored_receipts;
+    }
+
+    // If not stored, retrieve receipts by executing transactions
+    if (receipts_generator == nullptr) {
+        SILKRPC_WARN << "receipts not stored for block " << block_with_hash.block.header.number << " and cannot be regenerated\n";
+        co_return Receipts{};
+    }
+    if (receipts_cache == nullptr) {
+        auto receipts = co_await receipts_generator->generate(db_reader, block_with_hash);
+        core::rawdb::derive_receipts_fields(receipts, block_with_hash, transaction_hashes.get());
+        co_return receipts;
+    }
+
+    // Concurrent requests for the same block are coalesced into one single execution
+    while (true) {
+        if (receipts_cache->start_regeneration(block_with_hash.hash)) {
+            std::shared_ptr<const Receipts> receipts;
+            std::exception_ptr error;
+            bool cancelled{false};
+            try {
+                auto generated_receipts = co_await receipts_generator->generate(db_reader, block_with_hash);
+                core::rawdb::derive_receipts_fields(generated_receipts, block_with_hash, transaction_hashes.get());
+                receipts = std::make_shared<const Receipts>(std::move(generated_receipts));
+            } catch (const boost::system::system_error& se) {
+                error = std::current_exception();
+                cancelled = se.code() == boost::asio::error::operation_aborted;
+            } catch (...) {
+                error = std::current_exception();
+            }
+            // Cancellation concerns only this request: the waiters are woken up empty-handed and one of them takes over
+            receipts_cache->finish_regeneration(block_with_hash.hash, receipts, cancelled ? nullptr : error);
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            co_return *receipts;
+        }
+        const auto receipts = co_await receipts_generator->wait_for(*receipts_cache, block_with_hash.hash);
+        if (receipts) {
+            co_return *receipts;
+        }
+        // Regeneration completed in the meantime: look again into the cache before trying to regenerate
+        const auto cached_block_receipts = receipts_cache->get(block_with_hash.hash);
+        if (cached_block_receipts) {
+            co_return *cached_block_receipts;
+        }
+    }
 }
 
 } // namespace silkrpc::core
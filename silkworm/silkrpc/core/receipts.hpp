@@ -19,8 +19,12 @@
 #include <silkworm/silkrpc/config.hpp>
 
 #include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <evmc/evmc.hpp>
 
+#include <silkworm/silkrpc/common/block_cache.hpp>
+#include <silkworm/silkrpc/common/receipts_cache.hpp>
 #include <silkworm/silkrpc/core/rawdb/accessors.hpp>
 #include <silkworm/silkrpc/types/receipt.hpp>
 
@@ -28,7 +32,30 @@
 
 namespace silkrpc::core {
 
-boost::asio::awaitable<Receipts> get_receipts(const rawdb::DatabaseReader& db_reader, const silkworm::BlockWithHash& block_with_hash);
+//! Regenerate the receipts of blocks whose receipts are not stored by re-executing their transactions
+class ReceiptsGenerator {
+public:
+    explicit ReceiptsGenerator(boost::asio::io_context& io_context, boost::asio::thread_pool& workers)
+        : io_context_(io_context), workers_(workers) {}
+
+    ReceiptsGenerator(const ReceiptsGenerator&) = delete;
+    ReceiptsGenerator& operator=(const ReceiptsGenerator&) = delete;
+
+    //! Execute the block transactions on top of the parent state and collect their raw receipts
+    boost::asio::awaitable<Receipts> generate(const rawdb::DatabaseReader& db_reader, const silkworm::BlockWithHash& block_with_hash);
+
+    //! Wait for the regeneration in progress for the given block: return null if it already completed
+    boost::asio::awaitable<std::shared_ptr<const Receipts>> wait_for(ReceiptsCache& receipts_cache, const evmc::bytes32& block_hash);
+
+private:
+    boost::asio::io_context& io_context_;
+    boost::asio::thread_pool& workers_;
+};
+
+//! Get the block receipts, regenerating them by block re-execution if not stored and a generator is provided
+boost::asio::awaitable<Receipts> get_receipts(const rawdb::DatabaseReader& db_reader, const silkworm::BlockWithHash& block_with_hash,
+                                              BlockCache* block_cache = nullptr, ReceiptsCache* receipts_cache = nullptr,
+                                              ReceiptsGenerator* receipts_generator = nullptr);
 
 } // namespace silkrpc::core
 
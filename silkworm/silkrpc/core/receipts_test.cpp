@@ -16,11 +16,196 @@
 
 #include "receipts.hpp"
 
+#include <atomic>
+#include <future>
+#include <string>
+
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+#include <boost/system/system_error.hpp>
 #include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+#include <silkworm/core/common/util.hpp>
+
+#include <silkworm/silkrpc/common/log.hpp>
+#include <silkworm/silkrpc/common/util.hpp>
+#include <silkworm/silkrpc/ethdb/tables.hpp>
 
 namespace silkrpc {
 
 using Catch::Matchers::Message;
+using evmc::literals::operator""_address, evmc::literals::operator""_bytes32;
 
-} // namespace silkrpc
+static silkworm::Bytes kZeroHeader{*silkworm::from_hex("bf7e331f7f7c1dd2e05159666b3bf8bc7a8a3a9eb1d518969eab529dd9b88c1a")};
+static silkworm::Bytes kConfigValue{*silkworm::from_hex(
+    "7b22436861696e4e616d65223a22676f65726c69222c22636861696e4964223a352c22636f6e73656e737573223a22636c69717565222c2268"
+    "6f6d657374656164426c6f636b223a302c2264616f466f726b537570706f7274223a747275652c22656970313530426c6f636b223a302c2265"
+    "697031353048617368223a22307830303030303030303030303030303030303030303030303030303030303030303030303030303030303030"
+    "303030303030303030303030303030303030303030222c22656970313535426c6f636b223a302c22656970313538426c6f636b223a302c2262"
+    "797a616e7469756d426c6f636b223a302c22636f6e7374616e74696e6f706c65426c6f636b223a302c2270657465727362757267426c6f636b"
+    "223a302c22697374616e62756c426c6f636b223a313536313635312c226265726c696e426c6f636b223a343436303634342c226c6f6e646f6e"
+    "426c6f636b223a353036323630352c22636c69717565223a7b22706572696f64223a31352c2265706f6368223a33303030307d7d")};
+
+// Goerli database with empty state and no stored receipts: every block execution reads the chain config once
+class NoReceiptsDatabase : public core::rawdb::DatabaseReader {
+public:
+    boost::asio::awaitable<KeyValue> get(const std::string& table, const silkworm::ByteView& key) const override {
+        co_return KeyValue{};
+    }
+    boost::asio::awaitable<silkworm::Bytes> get_one(const std::string& table, const silkworm::ByteView& key) const override {
+        if (table == db::table::kCanonicalHashes) {
+            co_return kZeroHeader;
+        }
+        if (table == db::table::kConfig) {
+            ++config_reads;
+            co_return kConfigValue;
+        }
+        if (table == db::table::kBlockReceipts) {
+            ++receipts_reads;
+        }
+        co_return silkworm::Bytes{};
+    }
+    boost::asio::awaitable<std::optional<silkworm::Bytes>> get_both_range(const std::string& table, const silkworm::ByteView& key, const silkworm::ByteView& subkey) const override {
+        co_return std::nullopt;
+    }
+    boost::asio::awaitable<void> walk(const std::string& table, const silkworm::ByteView& start_key, uint32_t fixed_bits, core::rawdb::Walker w) const override {
+        co_return;
+    }
+    boost::asio::awaitable<void> for_prefix(const std::string& table, const silkworm::ByteView& prefix, core::rawdb::Walker w) const override {
+        co_return;
+    }
+
+    mutable std::atomic<int> config_reads{0};
+    mutable std::atomic<int> receipts_reads{0};
+};
+
+static silkworm::BlockWithHash make_block_with_transfer() {
+    silkworm::BlockWithHash block_with_hash;
+    block_with_hash.hash = 0x2c7b25e8ea0ec64ba30e1c2f1e8e0ce51b7fe4e83e5e14fb4c5f0b6ad0e7d1f3_bytes32;
+    block_with_hash.block.header.number = 1'000;
+    block_with_hash.block.header.gas_limit = 8'000'000;
+
+    silkworm::Transaction transaction;
+    transaction.type = silkworm::Transaction::Type::kLegacy;
+    transaction.from = 0xa872626373628737383927236382161739290870_address;
+    transaction.to = 0x0715a7794a1dc8e42615f059dd6e406a6594651a_address;
+    transaction.gas_limit = 21'000;
+    block_with_hash.block.transactions.push_back(transaction);
+
+    return block_with_hash;
+}
+
+TEST_CASE("get_receipts regenerates receipts", "[silkrpc][core][receipts]") {
+    SILKRPC_LOG_STREAMS(null_stream(), null_stream());
+    SILKRPC_LOG_VERBOSITY(LogLevel::None);
 
+    NoReceiptsDatabase db_reader;
+    boost::asio::io_context io_context;
+    boost::asio::thread_pool workers{2};
+    core::ReceiptsGenerator receipts_generator{io_context, workers};
+    const auto block_with_hash = make_block_with_transfer();
+    const auto tx_hash_bytes = hash_of_transaction(block_with_hash.block.transactions[0]);
+    const auto tx_hash = silkworm::to_bytes32({tx_hash_bytes.bytes, silkworm::kHashLength});
+
+    SECTION("generated receipts have only raw fields") {
+        auto result = boost::asio::co_spawn(io_context, receipts_generator.generate(db_reader, block_with_hash), boost::asio::use_future);
+        io_context.run();
+        const auto receipts = result.get();
+        REQUIRE(receipts.size() == 1);
+        CHECK(receipts[0].success);
+        CHECK(receipts[0].cumulative_gas_used == 21'000);
+        CHECK(receipts[0].logs.empty());
+        CHECK(receipts[0].tx_hash == evmc::bytes32{});
+        CHECK(receipts[0].block_hash == evmc::bytes32{});
+        CHECK(!receipts[0].from);
+    }
+
+    SECTION("missing receipts are not regenerated without generator") {
+        auto result = boost::asio::co_spawn(io_context, core::get_receipts(db_reader, block_with_hash), boost::asio::use_future);
+        io_context.run();
+        CHECK(result.get().empty());
+        CHECK(db_reader.config_reads == 0);
+    }
+
+    SECTION("missing receipts are regenerated with derived fields") {
+        BlockCache block_cache;
+        auto result = boost::asio::co_spawn(io_context,
+            core::get_receipts(db_reader, block_with_hash, &block_cache, nullptr, &receipts_generator), boost::asio::use_future);
+        io_context.run();
+        const auto receipts = result.get();
+        REQUIRE(receipts.size() == 1);
+        CHECK(receipts[0].success);
+        CHECK(receipts[0].cumulative_gas_used == 21'000);
+        CHECK(receipts[0].gas_used == 21'000);
+        CHECK(receipts[0].tx_hash == tx_hash);
+        CHECK(receipts[0].tx_index == 0);
+        CHECK(receipts[0].block_hash == block_with_hash.hash);
+        CHECK(receipts[0].block_number == 1'000);
+        CHECK(receipts[0].from == block_with_hash.block.transactions[0].from);
+        CHECK(receipts[0].to == block_with_hash.block.transactions[0].to);
+        CHECK(db_reader.receipts_reads == 1);
+        CHECK(db_reader.config_reads == 1);
+    }
+
+    SECTION("concurrent requests share one regeneration") {
+        ReceiptsCache receipts_cache;
+        auto result1 = boost::asio::co_spawn(io_context,
+            core::get_receipts(db_reader, block_with_hash, nullptr, &receipts_cache, &receipts_generator), boost::asio::use_future);
+        auto result2 = boost::asio::co_spawn(io_context,
+            core::get_receipts(db_reader, block_with_hash, nullptr, &receipts_cache, &receipts_generator), boost::asio::use_future);
+        io_context.run();
+        const auto receipts1 = result1.get();
+        const auto receipts2 = result2.get();
+        REQUIRE(receipts1.size() == 1);
+        REQUIRE(receipts2.size() == 1);
+        CHECK(receipts1[0].tx_hash == tx_hash);
+        CHECK(receipts2[0].tx_hash == tx_hash);
+        CHECK(receipts2[0].cumulative_gas_used == receipts1[0].cumulative_gas_used);
+        CHECK(db_reader.receipts_reads == 2);
+        CHECK(db_reader.config_reads == 1);
+
+        SECTION("regenerated receipts are then served by the cache") {
+            io_context.restart();
+            auto result3 = boost::asio::co_spawn(io_context,
+                core::get_receipts(db_reader, block_with_hash, nullptr, &receipts_cache, &receipts_generator), boost::asio::use_future);
+            io_context.run();
+            CHECK(result3.get().size() == 1);
+            CHECK(db_reader.receipts_reads == 2);
+            CHECK(db_reader.config_reads == 1);
+        }
+    }
+
+    SECTION("waiting request takes over cancelled regeneration") {
+        // Keep the workers busy until the first request is cancelled, so that its execution never starts
+        std::promise<void> workers_gate;
+        std::shared_future<void> workers_released{workers_gate.get_future()};
+        for (int i{0}; i < 2; ++i) {
+            boost::asio::post(workers, [workers_released]() { workers_released.wait(); });
+        }
+        ReceiptsCache receipts_cache;
+        boost::asio::cancellation_signal cancellation_signal;
+        auto result1 = boost::asio::co_spawn(io_context,
+            core::get_receipts(db_reader, block_with_hash, nullptr, &receipts_cache, &receipts_generator),
+            boost::asio::bind_cancellation_slot(cancellation_signal.slot(), boost::asio::use_future));
+        auto result2 = boost::asio::co_spawn(io_context,
+            core::get_receipts(db_reader, block_with_hash, nullptr, &receipts_cache, &receipts_generator), boost::asio::use_future);
+        boost::asio::post(io_context, [&]() {
+            cancellation_signal.emit(boost::asio::cancellation_type::all);
+            workers_gate.set_value();
+        });
+        io_context.run();
+        CHECK_THROWS_AS(result1.get(), boost::system::system_error);
+        const auto receipts2 = result2.get();
+        REQUIRE(receipts2.size() == 1);
+        CHECK(receipts2[0].tx_hash == tx_hash);
+        CHECK(db_reader.config_reads == 2);
+        CHECK(receipts_cache.get(block_with_hash.hash));
+    }
+}
+
+} // namespace silkrpc
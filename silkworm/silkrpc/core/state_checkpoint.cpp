@@ -0,0 +1,167 @@
+/*
+   Copyright 2020 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_checkpoint.hpp"
+
+#include <algorithm>
+
+#include <silkworm/silkrpc/common/log.hpp>
+#include <silkworm/silkrpc/core/rawdb/util.hpp>
+
+namespace silkrpc::state {
+
+// Rough per-entry overhead of the std::map red-black tree nodes
+constexpr std::size_t kMapNodeOverhead{32};
+
+std::size_t StateCheckpoint::size_bytes() const noexcept {
+    std::size_t size{0};
+    size += accounts.size() * (sizeof(evmc::address) + sizeof(std::optional<silkworm::Account>) + kMapNodeOverhead);
+    for (const auto& [key, _] : storage) {
+        size += key.size() + sizeof(evmc::bytes32) + kMapNodeOverhead;
+    }
+    for (const auto& [_, bytecode] : code) {
+        size += sizeof(evmc::bytes32) + bytecode.size() + kMapNodeOverhead;
+    }
+    size += incarnations.size() * (sizeof(evmc::address) + sizeof(uint64_t) + kMapNodeOverhead);
+    return size;
+}
+
+std::optional<silkworm::Account> CheckpointState::read_account(const evmc::address& address) const noexcept {
+    const auto it = delta_.accounts.find(address);
+    if (it != delta_.accounts.end()) {
+        return it->second;
+    }
+    return base_.read_account(address);
+}
+
+silkworm::ByteView CheckpointState::read_code(const evmc::bytes32& code_hash) const noexcept {
+    const auto it = delta_.code.find(code_hash);
+    if (it != delta_.code.end()) {
+        return it->second;
+    }
+    return base_.read_code(code_hash);
+}
+
+evmc::bytes32 CheckpointState::read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept {
+    const auto it = delta_.storage.find(composite_storage_key(address, incarnation, location.bytes));
+    if (it != delta_.storage.end()) {
+        return it->second;
+    }
+    return base_.read_storage(address, incarnation, location);
+}
+
+uint64_t CheckpointState::previous_incarnation(const evmc::address& address) const noexcept {
+    const auto base_incarnation = base_.previous_incarnation(address);
+    const auto it = delta_.incarnations.find(address);
+    if (it != delta_.incarnations.end()) {
+        return std::max(base_incarnation, it->second);
+    }
+    return base_incarnation;
+}
+
+void CheckpointState::update_account(const evmc::address& address, std::optional<silkworm::Account> initial, std::optional<silkworm::Account> current) {
+    if (!current && initial && initial->incarnation > 0) {
+        auto& incarnation = delta_.incarnations[address];
+        incarnation = std::max(incarnation, initial->incarnation);
+    }
+    delta_.accounts.insert_or_assign(address, current);
+}
+
+void CheckpointState::update_account_code(const evmc::address& /*address*/, uint64_t /*incarnation*/, const evmc::bytes32& code_hash, silkworm::ByteView code) {
+    delta_.code.insert_or_assign(code_hash, silkworm::Bytes{code});
+}
+
+void CheckpointState::update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+    const evmc::bytes32& /*initial*/, const evmc::bytes32& current) {
+    delta_.storage.insert_or_assign(composite_storage_key(address, incarnation, location.bytes), current);
+}
+
+std::optional<std::pair<uint32_t, std::shared_ptr<const StateCheckpoint>>> StateCheckpointCache::find(const evmc::bytes32& block_hash, uint32_t txn_index) {
+    const std::lock_guard<std::mutex> lock(access_);
+    const auto block_it = blocks_.find(block_hash);
+    if (block_it == blocks_.end()) {
+        ++miss_count_;
+        return std::nullopt;
+    }
+    auto& block_checkpoints = block_it->second;
+    auto it = block_checkpoints.checkpoints.upper_bound(txn_index);
+    if (it == block_checkpoints.checkpoints.begin()) {
+        ++miss_count_;
+        return std::nullopt;
+    }
+    --it;
+    ++hit_count_;
+    lru_list_.splice(lru_list_.begin(), lru_list_, block_checkpoints.lru_position);
+    return std::make_pair(it->first, it->second);
+}
+
+void StateCheckpointCache::insert(const evmc::bytes32& block_hash, uint32_t txn_index, std::shared_ptr<const StateCheckpoint> checkpoint) {
+    const auto checkpoint_size = checkpoint->size_bytes();
+    if (checkpoint_size > max_bytes_) {
+        SILKRPC_DEBUG << "StateCheckpointCache::insert checkpoint too big: " << checkpoint_size << "\n";
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(access_);
+    auto block_it = blocks_.find(block_hash);
+    if (block_it == blocks_.end()) {
+        lru_list_.push_front(block_hash);
+        block_it = blocks_.emplace(block_hash, BlockCheckpoints{lru_list_.begin()}).first;
+    } else {
+        lru_list_.splice(lru_list_.begin(), lru_list_, block_it->second.lru_position);
+    }
+    auto& block_checkpoints = block_it->second;
+    const auto [it, inserted] = block_checkpoints.checkpoints.emplace(txn_index, std::move(checkpoint));
+    if (!inserted) {
+        return;
+    }
+    block_checkpoints.size_bytes += checkpoint_size;
+    size_bytes_ += checkpoint_size;
+
+    evict_if_needed();
+}
+
+void StateCheckpointCache::evict_if_needed() {
+    while (size_bytes_ > max_bytes_ && !lru_list_.empty()) {
+        const auto block_it = blocks_.find(lru_list_.back());
+        size_bytes_ -= block_it->second.size_bytes;
+        eviction_count_ += block_it->second.checkpoints.size();
+        blocks_.erase(block_it);
+        lru_list_.pop_back();
+    }
+}
+
+uint64_t StateCheckpointCache::hit_count() const {
+    const std::lock_guard<std::mutex> lock(access_);
+    return hit_count_;
+}
+
+uint64_t StateCheckpointCache::miss_count() const {
+    const std::lock_guard<std::mutex> lock(access_);
+    return miss_count_;
+}
+
+uint64_t StateCheckpointCache::eviction_count() const {
+    const std::lock_guard<std::mutex> lock(access_);
+    return eviction_count_;
+}
+
+std::size_t StateCheckpointCache::size_bytes() const {
+    const std::lock_guard<std::mutex> lock(access_);
+    return size_bytes_;
+}
+
+} // namespace silkrpc::state
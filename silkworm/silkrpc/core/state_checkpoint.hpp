@@ -0,0 +1,171 @@
+/*
+   Copyright 2020 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <silkworm/silkrpc/config.hpp> // NOLINT(build/include_order)
+
+#include <evmc/evmc.hpp>
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/state/state.hpp>
+#include <silkworm/core/types/account.hpp>
+
+namespace silkrpc::state {
+
+//! State delta accumulated by executing the first N transactions of a block on top of its parent state
+struct StateCheckpoint {
+    std::map<evmc::address, std::optional<silkworm::Account>> accounts;
+    std::map<silkworm::Bytes, evmc::bytes32> storage; // keyed by composite storage key
+    std::map<evmc::bytes32, silkworm::Bytes> code;
+    std::map<evmc::address, uint64_t> incarnations;
+
+    //! Approximate memory footprint of this checkpoint
+    std::size_t size_bytes() const noexcept;
+};
+
+//! State overlay serving reads from an in-memory delta first and falling back to the base state
+class CheckpointState : public silkworm::State {
+public:
+    explicit CheckpointState(silkworm::State& base) : base_(base) {}
+
+    //! Replace the current delta with the content of the given checkpoint
+    void restore(const StateCheckpoint& checkpoint) { delta_ = checkpoint; }
+
+    //! Take a snapshot of the current delta
+    std::shared_ptr<const StateCheckpoint> checkpoint() const { return std::make_shared<const StateCheckpoint>(delta_); }
+
+    std::optional<silkworm::Account> read_account(const evmc::address& address) const noexcept override;
+
+    silkworm::ByteView read_code(const evmc::bytes32& code_hash) const noexcept override;
+
+    evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept override;
+
+    uint64_t previous_incarnation(const evmc::address& address) const noexcept override;
+
+    std::optional<silkworm::BlockHeader> read_header(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override {
+        return base_.read_header(block_number, block_hash);
+    }
+
+    bool read_body(uint64_t block_number, const evmc::bytes32& block_hash, silkworm::BlockBody& out) const noexcept override {
+        return base_.read_body(block_number, block_hash, out);
+    }
+
+    std::optional<intx::uint256> total_difficulty(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override {
+        return base_.total_difficulty(block_number, block_hash);
+    }
+
+    evmc::bytes32 state_root_hash() const override { return base_.state_root_hash(); }
+
+    uint64_t current_canonical_block() const override { return base_.current_canonical_block(); }
+
+    std::optional<evmc::bytes32> canonical_hash(uint64_t block_number) const override { return base_.canonical_hash(block_number); }
+
+    void insert_block(const silkworm::Block& block, const evmc::bytes32& hash) override {}
+
+    void canonize_block(uint64_t block_number, const evmc::bytes32& block_hash) override {}
+
+    void decanonize_block(uint64_t block_number) override {}
+
+    void insert_receipts(uint64_t block_number, const std::vector<silkworm::Receipt>& receipts) override {}
+
+    void begin_block(uint64_t block_number) override {}
+
+    void update_account(
+        const evmc::address& address,
+        std::optional<silkworm::Account> initial,
+        std::optional<silkworm::Account> current) override;
+
+    void update_account_code(
+        const evmc::address& address,
+        uint64_t incarnation,
+        const evmc::bytes32& code_hash,
+        silkworm::ByteView code) override;
+
+    void update_storage(
+        const evmc::address& address,
+        uint64_t incarnation,
+        const evmc::bytes32& location,
+        const evmc::bytes32& initial,
+        const evmc::bytes32& current) override;
+
+    void unwind_state_changes(uint64_t block_number) override {}
+
+private:
+    silkworm::State& base_;
+    StateCheckpoint delta_;
+};
+
+const uint64_t kDefaultStateCheckpointCacheSize = 128; // MiB
+
+constexpr std::size_t kDefaultCheckpointCacheMaxBytes{kDefaultStateCheckpointCacheSize * 1024 * 1024};
+constexpr uint32_t kDefaultCheckpointInterval{16};
+
+//! LRU cache of intra-block state checkpoints keyed by block hash and number of executed transactions
+class StateCheckpointCache {
+public:
+    explicit StateCheckpointCache(std::size_t max_bytes = kDefaultCheckpointCacheMaxBytes, uint32_t interval = kDefaultCheckpointInterval)
+        : max_bytes_(max_bytes), interval_(interval == 0 ? 1 : interval) {}
+
+    StateCheckpointCache(const StateCheckpointCache&) = delete;
+    StateCheckpointCache& operator=(const StateCheckpointCache&) = delete;
+
+    //! Find the checkpoint with the highest number of executed transactions not greater than txn_index
+    std::optional<std::pair<uint32_t, std::shared_ptr<const StateCheckpoint>>> find(const evmc::bytes32& block_hash, uint32_t txn_index);
+
+    //! Store the checkpoint taken after executing txn_index transactions in the given block
+    void insert(const evmc::bytes32& block_hash, uint32_t txn_index, std::shared_ptr<const StateCheckpoint> checkpoint);
+
+    //! Checkpoints are taken every interval transactions and right before the traced one
+    bool should_checkpoint(uint32_t txn_index, uint32_t target_index) const noexcept {
+        return txn_index == target_index || txn_index % interval_ == 0;
+    }
+
+    uint64_t hit_count() const;
+    uint64_t miss_count() const;
+    uint64_t eviction_count() const;
+    std::size_t size_bytes() const;
+
+private:
+    struct BlockCheckpoints {
+        std::list<evmc::bytes32>::iterator lru_position;
+        std::map<uint32_t, std::shared_ptr<const StateCheckpoint>> checkpoints;
+        std::size_t size_bytes{0};
+    };
+
+    void evict_if_needed();
+
+    std::size_t max_bytes_;
+    uint32_t interval_;
+    mutable std::mutex access_;
+    std::list<evmc::bytes32> lru_list_;
+    std::map<evmc::bytes32, BlockCheckpoints> blocks_;
+    std::size_t size_bytes_{0};
+    uint64_t hit_count_{0};
+    uint64_t miss_count_{0};
+    uint64_t eviction_count_{0};
+};
+
+} // namespace silkrpc::state
@@ -0,0 +1,145 @@
+/*
+   Copyright 2020 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_checkpoint.hpp"
+
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+#include <silkworm/core/state/in_memory_state.hpp>
+
+namespace silkrpc::state {
+
+using evmc::literals::operator""_address, evmc::literals::operator""_bytes32;
+
+static const auto kAddress{0xe0a2bd4258d2768837baa26a28fe71dc079f84c7_address};
+static const auto kLocation{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+static const auto kBlockHash{0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+
+static std::shared_ptr<const StateCheckpoint> make_checkpoint(std::size_t num_storage_slots) {
+    auto checkpoint = std::make_shared<StateCheckpoint>();
+    for (std::size_t i{0}; i < num_storage_slots; ++i) {
+        checkpoint->storage.emplace(silkworm::Bytes(60, static_cast<uint8_t>(i)), evmc::bytes32{});
+    }
+    return checkpoint;
+}
+
+TEST_CASE("CheckpointState", "[silkrpc][core][state_checkpoint]") {
+    silkworm::InMemoryState base;
+    silkworm::Account base_account{.nonce = 1, .balance = 100, .incarnation = 1};
+    base.update_account(kAddress, std::nullopt, base_account);
+
+    SECTION("read from base state when delta is empty") {
+        CheckpointState state{base};
+        const auto account = state.read_account(kAddress);
+        CHECK(account == base_account);
+        CHECK(state.read_storage(kAddress, 1, kLocation) == evmc::bytes32{});
+    }
+
+    SECTION("read from delta first") {
+        CheckpointState state{base};
+        silkworm::Account updated_account{.nonce = 2, .balance = 50, .incarnation = 1};
+        const auto value{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32};
+        state.update_account(kAddress, base_account, updated_account);
+        state.update_storage(kAddress, 1, kLocation, evmc::bytes32{}, value);
+
+        CHECK(state.read_account(kAddress) == updated_account);
+        CHECK(state.read_storage(kAddress, 1, kLocation) == value);
+        CHECK(base.read_account(kAddress) == base_account);
+        CHECK(base.read_storage(kAddress, 1, kLocation) == evmc::bytes32{});
+    }
+
+    SECTION("restore checkpoint into another state") {
+        CheckpointState state{base};
+        const auto code_hash{0x1111111111111111111111111111111111111111111111111111111111111111_bytes32};
+        const silkworm::Bytes code{0x60, 0x00};
+        state.update_account_code(kAddress, 1, code_hash, code);
+        const auto checkpoint = state.checkpoint();
+
+        CheckpointState restored_state{base};
+        restored_state.restore(*checkpoint);
+        CHECK(restored_state.read_code(code_hash) == silkworm::ByteView{code});
+    }
+
+    SECTION("deleted account bumps previous incarnation") {
+        CheckpointState state{base};
+        CHECK(state.previous_incarnation(kAddress) == 0);
+        state.update_account(kAddress, base_account, std::nullopt);
+        CHECK(state.read_account(kAddress) == std::nullopt);
+        CHECK(state.previous_incarnation(kAddress) == 1);
+    }
+}
+
+TEST_CASE("StateCheckpointCache", "[silkrpc][core][state_checkpoint]") {
+    SECTION("find in empty cache") {
+        StateCheckpointCache cache;
+        CHECK(!cache.find(kBlockHash, 10));
+        CHECK(cache.miss_count() == 1);
+        CHECK(cache.hit_count() == 0);
+    }
+
+    SECTION("find nearest checkpoint before index") {
+        StateCheckpointCache cache;
+        cache.insert(kBlockHash, 16, make_checkpoint(1));
+        cache.insert(kBlockHash, 32, make_checkpoint(2));
+
+        CHECK(!cache.find(kBlockHash, 15));
+        const auto checkpoint16 = cache.find(kBlockHash, 20);
+        CHECK(checkpoint16);
+        CHECK(checkpoint16->first == 16);
+        const auto checkpoint32 = cache.find(kBlockHash, 32);
+        CHECK(checkpoint32);
+        CHECK(checkpoint32->first == 32);
+        CHECK(checkpoint32->second->storage.size() == 2);
+        CHECK(cache.hit_count() == 2);
+        CHECK(cache.miss_count() == 1);
+    }
+
+    SECTION("evict least recently used block") {
+        const auto checkpoint = make_checkpoint(10);
+        StateCheckpointCache cache{checkpoint->size_bytes() * 2};
+        const auto block_hash1{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+        const auto block_hash2{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32};
+        const auto block_hash3{0x0000000000000000000000000000000000000000000000000000000000000003_bytes32};
+        cache.insert(block_hash1, 1, checkpoint);
+        cache.insert(block_hash2, 1, checkpoint);
+        CHECK(cache.find(block_hash1, 1));
+        cache.insert(block_hash3, 1, checkpoint);
+
+        CHECK(cache.eviction_count() == 1);
+        CHECK(cache.size_bytes() == checkpoint->size_bytes() * 2);
+        CHECK(cache.find(block_hash1, 1));
+        CHECK(!cache.find(block_hash2, 1));
+        CHECK(cache.find(block_hash3, 1));
+    }
+
+    SECTION("skip checkpoint bigger than capacity") {
+        const auto checkpoint = make_checkpoint(10);
+        StateCheckpointCache cache{checkpoint->size_bytes() - 1};
+        cache.insert(kBlockHash, 1, checkpoint);
+        CHECK(cache.size_bytes() == 0);
+        CHECK(!cache.find(kBlockHash, 1));
+    }
+
+    SECTION("checkpoint at interval and at target index") {
+        StateCheckpointCache cache{kDefaultCheckpointCacheMaxBytes, 4};
+        CHECK(cache.should_checkpoint(4, 10));
+        CHECK(cache.should_checkpoint(8, 10));
+        CHECK(cache.should_checkpoint(10, 10));
+        CHECK(!cache.should_checkpoint(5, 10));
+    }
+}
+
+} // namespace silkrpc::state
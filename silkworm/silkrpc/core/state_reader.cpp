@@ -19,7 +19,6 @@
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/core/types/account.hpp>
 #include <silkworm/node/db/access_layer.hpp>
-#include <silkworm/node/db/bitmap.hpp>
 #include <silkworm/node/db/util.hpp>
 #include <silkworm/node/common/decoding_exception.hpp>
 
@@ -95,10 +94,12 @@ boost::asio::awaitable<std::optional<silkworm::Bytes>> StateReader::read_histori
     if (kv_pair.value.empty()) {
         co_return std::nullopt;
     }
-    const auto bitmap{silkworm::db::bitmap::parse(kv_pair.value)};
-    SILKRPC_DEBUG << "StateReader::read_historical_account bitmap: " << bitmap.toString() << "\n";
+    const auto bitmap{HistoryChunkCache::instance().get_or_decode(db::table::kAccountHistory, kv_pair.key, kv_pair.value, [&]() {
+        return silkworm::db::bitmap::parse(kv_pair.value);
+    })};
+    SILKRPC_DEBUG << "StateReader::read_historical_account bitmap: " << bitmap->toString() << "\n";
 
-    const auto change_block{silkworm::db::bitmap::seek(bitmap, block_number)};
+    const auto change_block{silkworm::db::bitmap::seek(*bitmap, block_number)};
     if (!change_block) {
         co_return std::nullopt;
     }
@@ -125,10 +126,12 @@ boost::asio::awaitable<std::optional<silkworm::Bytes>> StateReader::read_histori
         co_return std::nullopt;
     }
 
-    const auto bitmap{silkworm::db::bitmap::parse(kv_pair.value)};
-    SILKRPC_DEBUG << "StateReader::read_historical_storage bitmap: " << bitmap.toString() << "\n";
+    const auto bitmap{HistoryChunkCache::instance().get_or_decode(db::table::kStorageHistory, kv_pair.key, kv_pair.value, [&]() {
+        return silkworm::db::bitmap::parse(kv_pair.value);
+    })};
+    SILKRPC_DEBUG << "StateReader::read_historical_storage bitmap: " << bitmap->toString() << "\n";
 
-    const auto change_block{silkworm::db::bitmap::seek(bitmap, block_number)};
+    const auto change_block{silkworm::db::bitmap::seek(*bitmap, block_number)};
     if (!change_block) {
         co_return std::nullopt;
     }
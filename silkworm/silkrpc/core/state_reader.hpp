@@ -24,12 +24,17 @@
 #include <evmc/evmc.hpp>
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/core/types/account.hpp>
+#include <silkworm/node/db/bitmap.hpp>
 
 #include <silkworm/silkrpc/common/util.hpp>
 #include <silkworm/silkrpc/core/rawdb/accessors.hpp>
+#include <silkworm/silkrpc/ethdb/bitmap_cache.hpp>
 
 namespace silkrpc {
 
+//! Shared cache of the decoded chunks of account and storage history tables
+using HistoryChunkCache = ethdb::bitmap::ChunkCache<decltype(silkworm::db::bitmap::parse(silkworm::Bytes{}))>;
+
 class StateReader {
 public:
     explicit StateReader(const core::rawdb::DatabaseReader& db_reader) : db_reader_(db_reader) {}
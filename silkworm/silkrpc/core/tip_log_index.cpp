@@ -0,0 +1,141 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "tip_log_index.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace silkrpc {
+
+// Positions of the logs having any of the given keys, in ascending order
+template <typename Key>
+static std::vector<uint32_t> positions_of(const std::map<Key, std::vector<uint32_t>>& positions_by_key, const std::vector<Key>& keys) {
+    std::vector<uint32_t> positions;
+    for (const auto& key : keys) {
+        const auto it = positions_by_key.find(key);
+        if (it != positions_by_key.end()) {
+            positions.insert(positions.end(), it->second.begin(), it->second.end());
+        }
+    }
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+    return positions;
+}
+
+static void intersect(std::optional<std::vector<uint32_t>>& candidates, std::vector<uint32_t>&& positions) {
+    if (!candidates) {
+        candidates = std::move(positions);
+        return;
+    }
+    std::vector<uint32_t> intersection;
+    std::set_intersection(candidates->begin(), candidates->end(), positions.begin(), positions.end(), std::back_inserter(intersection));
+    candidates = std::move(intersection);
+}
+
+void TipLogIndex::on_new_block(uint64_t block_number, const evmc::bytes32& hash) {
+    const std::lock_guard<std::mutex> lock(access_);
+    // Blocks at greater height, or at the same height with another hash, come from a fork that is no longer canonical
+    blocks_.erase(blocks_.upper_bound(block_number), blocks_.end());
+    auto& block = blocks_[block_number];
+    if (block.hash != hash) {
+        block = IndexedBlock{hash, {}, {}, {}};
+    }
+    if (block_number >= window_) {
+        blocks_.erase(blocks_.begin(), blocks_.lower_bound(block_number - window_ + 1));
+    }
+}
+
+void TipLogIndex::on_unwind(uint64_t block_number) {
+    const std::lock_guard<std::mutex> lock(access_);
+    blocks_.erase(blocks_.lower_bound(block_number), blocks_.end());
+}
+
+bool TipLogIndex::insert(uint64_t block_number, const evmc::bytes32& hash, Logs logs) {
+    IndexedBlock indexed_block{hash, {}, {}, {}};
+    for (uint32_t position{0}; position < logs.size(); ++position) {
+        const auto& log = logs[position];
+        indexed_block.positions_by_address[log.address].push_back(position);
+        for (std::size_t i{0}; i < std::min(log.topics.size(), kMaxTopics); ++i) {
+            auto& topic_positions = indexed_block.positions_by_topic[i][log.topics[i]];
+            if (topic_positions.empty() || topic_positions.back() != position) {
+                topic_positions.push_back(position);
+            }
+        }
+    }
+    indexed_block.logs = std::move(logs);
+
+    const std::lock_guard<std::mutex> lock(access_);
+    const auto it = blocks_.find(block_number);
+    if (it == blocks_.end() || it->second.hash != hash) {
+        return false;
+    }
+    it->second = std::move(indexed_block);
+    return true;
+}
+
+std::optional<Logs> TipLogIndex::find(uint64_t start, uint64_t end, const LogsFilter& filter) const {
+    if (start > end) {
+        return std::nullopt;
+    }
+    const std::lock_guard<std::mutex> lock(access_);
+    auto it = blocks_.find(start);
+    if (it == blocks_.end() || end - start >= blocks_.size()) {
+        return std::nullopt;
+    }
+    Logs matching_logs;
+    for (auto block_number = start; block_number <= end; ++block_number, ++it) {
+        if (it == blocks_.end() || it->first != block_number || !it->second.logs) {
+            return std::nullopt;
+        }
+        match(it->second, filter, matching_logs);
+    }
+    return matching_logs;
+}
+
+std::size_t TipLogIndex::size() const {
+    const std::lock_guard<std::mutex> lock(access_);
+    return std::count_if(blocks_.begin(), blocks_.end(), [](const auto& entry) { return entry.second.logs.has_value(); });
+}
+
+void TipLogIndex::match(const IndexedBlock& block, const LogsFilter& filter, Logs& matching_logs) const {
+    const auto& logs = *block.logs;
+
+    // Narrow the candidates by the address and topic indices, then check them against the whole filter
+    std::optional<std::vector<uint32_t>> candidates;
+    if (filter.addresses()) {
+        intersect(candidates, positions_of(block.positions_by_address, *filter.addresses()));
+    }
+    const auto& topics = filter.topics();
+    for (std::size_t i{0}; i < std::min(topics.size(), kMaxTopics); ++i) {
+        if (!topics[i].empty()) {
+            intersect(candidates, positions_of(block.positions_by_topic[i], topics[i]));
+        }
+    }
+
+    if (!candidates) {
+        std::copy_if(logs.begin(), logs.end(), std::back_inserter(matching_logs), [&](const auto& log) { return filter.matches(log); });
+        return;
+    }
+    for (const auto position : *candidates) {
+        if (filter.matches(logs[position])) {
+            matching_logs.push_back(logs[position]);
+        }
+    }
+}
+
+} // namespace silkrpc
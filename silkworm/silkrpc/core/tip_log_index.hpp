@@ -0,0 +1,75 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+
+#include <silkworm/silkrpc/core/logs_filter.hpp>
+#include <silkworm/silkrpc/types/log.hpp>
+
+namespace silkrpc {
+
+//! Logs of the most recent canonical blocks indexed by address and topic position, kept in sync with the chain head
+class TipLogIndex {
+public:
+    explicit TipLogIndex(uint64_t window) : window_(window == 0 ? 1 : window) {}
+
+    TipLogIndex(const TipLogIndex&) = delete;
+    TipLogIndex& operator=(const TipLogIndex&) = delete;
+
+    //! Notify that a new block has been added to the canonical chain, its logs will be provided by insert
+    void on_new_block(uint64_t block_number, const evmc::bytes32& hash);
+
+    //! Notify that the given block and all its descendants have been removed from the canonical chain
+    void on_unwind(uint64_t block_number);
+
+    //! Index the logs of the given block: return false if not canonical anymore or out of the window
+    bool insert(uint64_t block_number, const evmc::bytes32& hash, Logs logs);
+
+    //! Return the logs matching the filter in the given block range, if all these blocks are indexed
+    std::optional<Logs> find(uint64_t start, uint64_t end, const LogsFilter& filter) const;
+
+    //! Return the number of blocks whose logs are indexed
+    std::size_t size() const;
+
+private:
+    //! Max number of topics in one log
+    static constexpr std::size_t kMaxTopics{4};
+
+    struct IndexedBlock {
+        evmc::bytes32 hash;
+        std::optional<Logs> logs;
+        std::map<evmc::address, std::vector<uint32_t>> positions_by_address;
+        std::array<std::map<evmc::bytes32, std::vector<uint32_t>>, kMaxTopics> positions_by_topic;
+    };
+
+    void match(const IndexedBlock& block, const LogsFilter& filter, Logs& matching_logs) const;
+
+    uint64_t window_;
+    mutable std::mutex access_;
+    std::map<uint64_t, IndexedBlock> blocks_;
+};
+
+} // namespace silkrpc
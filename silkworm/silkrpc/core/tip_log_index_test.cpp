@@ -0,0 +1,113 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "tip_log_index.hpp"
+
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+
+namespace silkrpc {
+
+using evmc::literals::operator""_address;
+using evmc::literals::operator""_bytes32;
+
+TEST_CASE("tip log index", "[silkrpc][core][tip_log_index]") {
+    const auto address1{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+    const auto address2{0x007fb8417eb9ad4d958b050fc3720d5b46a2c053_address};
+    const auto topic1{0x3ac225168df54212a25c1c01fd35bebfea408fdac2e31ddd6f80a4bbf9a5f1cb_bytes32};
+    const auto topic2{0x1dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d49347_bytes32};
+    const auto make_hash = [](uint64_t block_number) {
+        evmc::bytes32 hash;
+        hash.bytes[31] = static_cast<uint8_t>(block_number);
+        return hash;
+    };
+    const auto make_logs = [&](uint64_t block_number) {
+        Logs logs(2);
+        logs[0].address = address1;
+        logs[0].topics = {topic1, topic2};
+        logs[0].block_number = block_number;
+        logs[1].address = address2;
+        logs[1].topics = {topic2};
+        logs[1].block_number = block_number;
+        return logs;
+    };
+    const LogsFilter all_logs{Filter{}};
+
+    TipLogIndex index{3};
+    for (uint64_t block_number{10}; block_number < 15; ++block_number) {
+        index.on_new_block(block_number, make_hash(block_number));
+    }
+
+    SECTION("blocks not indexed yet") {
+        CHECK(!index.find(12, 14, all_logs));
+        CHECK(index.size() == 0);
+    }
+
+    for (uint64_t block_number{12}; block_number < 15; ++block_number) {
+        REQUIRE(index.insert(block_number, make_hash(block_number), make_logs(block_number)));
+    }
+
+    SECTION("insert rejected out of window or not canonical") {
+        CHECK(!index.insert(11, make_hash(11), make_logs(11)));
+        CHECK(!index.insert(14, make_hash(99), make_logs(14)));
+        CHECK(index.size() == 3);
+    }
+
+    SECTION("all logs in range") {
+        const auto logs = index.find(12, 14, all_logs);
+        REQUIRE(logs);
+        CHECK(logs->size() == 6);
+        CHECK(logs->front().block_number == 12);
+        CHECK(logs->back().block_number == 14);
+    }
+
+    SECTION("logs by address") {
+        Filter filter;
+        filter.addresses = FilterAddresses{address2};
+        CHECK(index.find(12, 14, LogsFilter{filter})->size() == 3);
+        filter.addresses = FilterAddresses{};
+        CHECK(index.find(12, 14, LogsFilter{filter})->empty());
+    }
+
+    SECTION("logs by topic position") {
+        Filter filter;
+        filter.topics = FilterTopics{{}, {topic2}};
+        CHECK(index.find(13, 14, LogsFilter{filter})->size() == 2);
+        filter.topics = FilterTopics{{topic2}};
+        filter.addresses = FilterAddresses{address1};
+        CHECK(index.find(12, 14, LogsFilter{filter})->empty());
+    }
+
+    SECTION("range not fully indexed") {
+        CHECK(!index.find(11, 14, all_logs));
+        CHECK(!index.find(12, 15, all_logs));
+        CHECK(!index.find(14, 12, all_logs));
+    }
+
+    SECTION("unwind") {
+        index.on_unwind(14);
+        CHECK(!index.find(12, 14, all_logs));
+        CHECK(index.find(12, 13, all_logs)->size() == 4);
+    }
+
+    SECTION("reorg without unwind") {
+        index.on_new_block(13, make_hash(50));
+        CHECK(!index.find(12, 13, all_logs));
+        CHECK(index.size() == 1);
+    }
+}
+
+} // namespace silkrpc
@@ -20,12 +20,18 @@
 #include <cxxabi.h>
 #endif
 
+#include <chrono>
 #include <filesystem>
 #include <stdexcept>
+#include <utility>
 
 #include <boost/asio/signal_set.hpp>
 #include <boost/process/environment.hpp>
 #include <grpcpp/grpcpp.h>
+#include <silkworm/silkrpc/concurrency/io_backend.hpp>
+#include <silkworm/silkrpc/core/code_analysis_cache.hpp>
+#include <silkworm/silkrpc/core/state_reader.hpp>
+#include <silkworm/silkrpc/ethdb/bitmap.hpp>
 #include <silkworm/silkrpc/http/jwt.hpp>
 
 namespace silkrpc {
@@ -90,6 +96,12 @@ int Daemon::run(const DaemonSettings& settings, const DaemonInfo& info) {
                         << " contexts, " << settings.num_workers << " workers\n";
         }
 
+        SILKRPC_LOG << "Silkrpc I/O backend: " << io_backend_name() << "\n";
+        if (io_backend_is_io_uring() && !io_uring_supported()) {
+            SILKRPC_CRIT << "Kernel does not support io_uring, build with SILKRPC_USE_IO_URING=OFF to use epoll\n";
+            return -1;
+        }
+
         std::string jwt_secret;
         if (!load_jwt_token(settings.jwt_secret_filename, jwt_secret)) {
             SILKRPC_CRIT << "JWT token has wrong size: " << jwt_secret.length() << "\n";
@@ -181,6 +193,42 @@ bool Daemon::validate_settings(const DaemonSettings& settings) {
         return false;
     }
 
+    if (settings.logs_parallelism == 0) {
+        SILKRPC_ERROR << "Parameter logs_parallelism is invalid: [" << settings.logs_parallelism << "]\n";
+        SILKRPC_ERROR << "Use --logs_parallelism flag to specify the number of concurrent block lanes scanned by one logs request\n";
+        return false;
+    }
+
+    if (settings.engine_latency_slo == 0) {
+        SILKRPC_ERROR << "Parameter engine_latency_slo is invalid: [" << settings.engine_latency_slo << "]\n";
+        SILKRPC_ERROR << "Use --engine_latency_slo flag to specify the target latency of Engine API calls in milliseconds\n";
+        return false;
+    }
+
+    try {
+        http::RequestTimeouts{std::chrono::milliseconds{settings.request_timeout}, settings.method_timeouts};
+    } catch (const std::invalid_argument& ia) {
+        SILKRPC_ERROR << "Parameter method_timeouts is invalid: [" << settings.method_timeouts << "] " << ia.what() << "\n";
+        SILKRPC_ERROR << "Use --method_timeouts flag to specify the request deadlines as comma-separated list of <method>:<milliseconds>\n";
+        return false;
+    }
+
+    try {
+        parse_cpu_list(settings.context_cpus);
+    } catch (const std::invalid_argument& ia) {
+        SILKRPC_ERROR << "Parameter context_cpus is invalid: [" << settings.context_cpus << "] " << ia.what() << "\n";
+        SILKRPC_ERROR << "Use --context_cpus flag to specify the CPUs of the I/O contexts as comma-separated list of <cpu> or <cpu>-<cpu>\n";
+        return false;
+    }
+
+    try {
+        parse_cpu_list(settings.worker_cpus);
+    } catch (const std::invalid_argument& ia) {
+        SILKRPC_ERROR << "Parameter worker_cpus is invalid: [" << settings.worker_cpus << "] " << ia.what() << "\n";
+        SILKRPC_ERROR << "Use --worker_cpus flag to specify the CPUs of the worker threads as comma-separated list of <cpu> or <cpu>-<cpu>\n";
+        return false;
+    }
+
     const auto api_spec = settings.api_spec;
     if (api_spec.empty()) {
         SILKRPC_ERROR << "Parameter api_spec is invalid: [" << api_spec << "]\n";
@@ -205,10 +253,26 @@ ChannelFactory Daemon::make_channel_factory(const DaemonSettings& settings) {
 Daemon::Daemon(const DaemonSettings& settings, const std::string& jwt_secret)
     : settings_(settings),
       create_channel_{make_channel_factory(settings_)},
-      context_pool_{settings_.num_contexts, create_channel_, settings.datadir, settings_.wait_mode},
+      context_pool_{settings_.num_contexts, create_channel_, settings.datadir, settings_.wait_mode,
+                    LogsSettings{settings_.logs_parallelism, settings_.logs_block_budget, settings_.logs_tip_window}, /*reserve_context=*/true,
+                    ContextAffinity{parse_cpu_list(settings_.context_cpus), settings_.pair_context_cpus},
+                    settings_.state_checkpoint_cache_size * 1024 * 1024},
       worker_pool_{settings_.num_workers},
+      engine_worker_pool_{1},
+      cost_class_limiter_{CostClassSettings{settings_.light_concurrency, settings_.evm_concurrency, settings_.trace_concurrency}},
+      admission_controller_{AdmissionSettings{settings_.max_connections, settings_.max_connections_per_ip, settings_.max_in_flight_requests,
+                                              settings_.max_queued_requests, settings_.max_resident_memory}, &cost_class_limiter_},
+      request_timeouts_{std::chrono::milliseconds{settings_.request_timeout}, settings_.method_timeouts},
+      request_dispatcher_{context_pool_, worker_pool_},
+      engine_latency_monitor_{settings_.engine_latency_slo * 1'000'000},
       jwt_secret_{jwt_secret},
       kv_stub_{remote::KV::NewStub(create_channel_())} {
+    // Size the shared bitmap chunk caches before any request uses them
+    ethdb::bitmap::shared_chunk_cache_capacity = settings_.index_chunk_cache_size;
+
+    // Pin the workers to their CPUs before any task is scheduled, so that their memory is allocated on the local NUMA node
+    pin_thread_pool(worker_pool_, settings_.num_workers, parse_cpu_list(settings_.worker_cpus));
+
     // Create the unique KV state-changes stream feeding the state cache
     auto& context = context_pool_.next_context();
     state_changes_stream_ = std::make_unique<ethdb::kv::StateChangesStream>(context, kv_stub_.get());
@@ -234,14 +298,26 @@ DaemonChecklist Daemon::run_checklist() {
 }
 
 void Daemon::start() {
+    // Requests are moved across the contexts only when there is more than one
+    auto request_dispatcher = settings_.dispatch_requests && settings_.num_contexts > 1 ? &request_dispatcher_ : nullptr;
+    for (std::size_t i{0}; i < context_pool_.size(); ++i) {
+        admission_controller_.add_context(*context_pool_.context(i).io_context());
+    }
+    admission_controller_.start(*context_pool_.context(0).io_context());
     for (int i = 0; i < settings_.num_contexts; ++i) {
         auto& context = context_pool_.next_context();
         rpc_services_.emplace_back(
-            std::make_unique<http::Server>(settings_.http_port, settings_.api_spec, context, worker_pool_, std::nullopt /* no jwt_secret_file */));
-        rpc_services_.emplace_back(
-            std::make_unique<http::Server>(settings_.engine_port, kDefaultEth2ApiSpec, context, worker_pool_, jwt_secret_));
+            std::make_unique<http::Server>(settings_.http_port, settings_.api_spec, context, worker_pool_, std::nullopt /* no jwt_secret_file */,
+                                           http::RequestPolicy{.cost_class_limiter = &cost_class_limiter_, .admission_controller = &admission_controller_,
+                                                               .request_timeouts = &request_timeouts_, .request_dispatcher = request_dispatcher}));
     }
 
+    // Engine API runs on its own context (thread, channel and backend stub) and worker, so public API load cannot delay it
+    auto& engine_context = context_pool_.reserved_context();
+    rpc_services_.emplace_back(
+        std::make_unique<http::Server>(settings_.engine_port, kDefaultEth2ApiSpec, engine_context, engine_worker_pool_, jwt_secret_,
+                                       http::RequestPolicy{.latency_monitor = &engine_latency_monitor_}));
+
     for (auto& service : rpc_services_) {
         service->start();
     }
@@ -261,6 +337,42 @@ void Daemon::stop() {
     for (auto& service : rpc_services_) {
         service->stop();
     }
+
+    for (std::size_t i{0}; i < context_pool_.size(); ++i) {
+        const auto* wait_strategy = context_pool_.context(i).adaptive_wait_strategy();
+        if (wait_strategy == nullptr) {
+            continue;
+        }
+        using State = AdaptiveWaitStrategy::State;
+        SILKRPC_LOG << "Context[" << i << "] wait state: " << wait_strategy->state() << " transitions: " << wait_strategy->transitions()
+                    << " spinning: " << wait_strategy->time_in_state(State::spinning).count() << "ns yielding: "
+                    << wait_strategy->time_in_state(State::yielding).count() << "ns sleeping: "
+                    << wait_strategy->time_in_state(State::sleeping).count() << "ns\n";
+    }
+    if (const auto& checkpoint_cache = context_pool_.context(0).state_checkpoint_cache()) {
+        SILKRPC_LOG << "State checkpoint cache hits: " << checkpoint_cache->hit_count() << " misses: " << checkpoint_cache->miss_count()
+                    << " evictions: " << checkpoint_cache->eviction_count() << " size: " << checkpoint_cache->size_bytes() << " bytes\n";
+    }
+    const auto& index_chunk_cache = ethdb::bitmap::IndexChunkCache::instance();
+    SILKRPC_LOG << "Index chunk cache hits: " << index_chunk_cache.hit_count() << " misses: " << index_chunk_cache.miss_count()
+                << " size: " << index_chunk_cache.size() << "\n";
+    const auto& history_chunk_cache = HistoryChunkCache::instance();
+    SILKRPC_LOG << "History chunk cache hits: " << history_chunk_cache.hit_count() << " misses: " << history_chunk_cache.miss_count()
+                << " size: " << history_chunk_cache.size() << "\n";
+    const auto& code_analysis_cache = CodeAnalysisCache::instance();
+    SILKRPC_LOG << "Code analysis cache hits: " << code_analysis_cache.hit_count() << " misses: " << code_analysis_cache.miss_count()
+                << " size: " << code_analysis_cache.size() << "\n";
+    const std::pair<CostClass, const char*> cost_classes[]{{CostClass::light, "light"}, {CostClass::evm, "evm"}, {CostClass::trace, "trace"}};
+    for (const auto& [cost_class, name] : cost_classes) {
+        SILKRPC_LOG << "Cost class " << name << " queued requests: " << cost_class_limiter_.queued_count(cost_class)
+                    << " queue depth: " << cost_class_limiter_.queue_depth(cost_class)
+                    << " max queue depth: " << cost_class_limiter_.max_queue_depth(cost_class) << "\n";
+    }
+    SILKRPC_LOG << "Requests dispatched to other contexts: " << request_dispatcher_.dispatched_count() << "\n";
+    SILKRPC_LOG << "Rejected connections: " << admission_controller_.rejected_connections()
+                << " rejected requests: " << admission_controller_.rejected_requests() << "\n";
+    SILKRPC_LOG << "Engine API calls: " << engine_latency_monitor_.count() << " SLO violations: " << engine_latency_monitor_.slo_violations()
+                << " mean latency: " << engine_latency_monitor_.mean_latency_ns() << "ns max latency: " << engine_latency_monitor_.max_latency_ns() << "ns\n";
 }
 
 void Daemon::join() {
@@ -23,9 +23,16 @@
 #include <boost/asio/thread_pool.hpp>
 
 #include <silkworm/silkrpc/common/constants.hpp>
+#include <silkworm/silkrpc/common/latency_monitor.hpp>
 #include <silkworm/silkrpc/common/log.hpp>
+#include <silkworm/silkrpc/concurrency/admission_controller.hpp>
 #include <silkworm/silkrpc/concurrency/context_pool.hpp>
+#include <silkworm/silkrpc/concurrency/cost_class_limiter.hpp>
+#include <silkworm/silkrpc/concurrency/cpu_affinity.hpp>
+#include <silkworm/silkrpc/ethdb/bitmap_cache.hpp>
 #include <silkworm/silkrpc/ethdb/kv/state_changes_stream.hpp>
+#include <silkworm/silkrpc/http/request_dispatcher.hpp>
+#include <silkworm/silkrpc/http/request_timeouts.hpp>
 #include <silkworm/silkrpc/http/server.hpp>
 #include <silkworm/silkrpc/protocol/version.hpp>
 
@@ -42,6 +49,26 @@ struct DaemonSettings {
     LogLevel log_verbosity;
     WaitMode wait_mode;
     std::string jwt_secret_filename;
+    uint32_t logs_parallelism;
+    uint64_t logs_block_budget;
+    uint64_t logs_tip_window;
+    uint64_t state_checkpoint_cache_size; // MiB
+    uint64_t index_chunk_cache_size; // chunks
+    uint32_t light_concurrency;
+    uint32_t evm_concurrency;
+    uint32_t trace_concurrency;
+    uint64_t engine_latency_slo; // milliseconds
+    uint32_t max_connections;
+    uint32_t max_connections_per_ip;
+    uint32_t max_in_flight_requests;
+    uint32_t max_queued_requests;
+    uint64_t max_resident_memory; // MiB
+    uint32_t request_timeout; // milliseconds
+    std::string method_timeouts; // comma-separated list of <method>:<milliseconds>
+    bool dispatch_requests;
+    std::string context_cpus; // CPU list like 0-3,8
+    bool pair_context_cpus;
+    std::string worker_cpus; // CPU list like 0-3,8
 };
 
 struct DaemonInfo {
@@ -81,12 +108,30 @@ class Daemon {
     //! The factory of gRPC client-side channels.
     ChannelFactory create_channel_;
 
-    //! The execution contexts capturing the asynchronous scheduling model.
+    //! The execution contexts capturing the asynchronous scheduling model, plus the one reserved to Engine API.
     ContextPool context_pool_;
 
     //! The pool of workers for long-running tasks.
     boost::asio::thread_pool worker_pool_;
 
+    //! The worker reserved to Engine API, isolated from the long-running tasks of the public API.
+    boost::asio::thread_pool engine_worker_pool_;
+
+    //! The limiter of concurrent requests by method cost class, shared among the RPC services.
+    CostClassLimiter cost_class_limiter_;
+
+    //! The admission control of connections and requests, shared among the RPC services.
+    AdmissionController admission_controller_;
+
+    //! The deadlines of the requests by method, shared among the RPC services.
+    http::RequestTimeouts request_timeouts_;
+
+    //! The distribution of the requests across the execution contexts, shared among the RPC services.
+    http::RequestDispatcher request_dispatcher_;
+
+    //! The latency statistics of Engine API calls against their SLO.
+    LatencyMonitor engine_latency_monitor_;
+
     std::vector<std::unique_ptr<http::Server>> rpc_services_;
 
     //! The gRPC KV interface client stub.
@@ -31,7 +31,7 @@ namespace silkrpc::ethdb::bitmap {
 using roaring_bitmap_t = roaring::api::roaring_bitmap_t;
 using Roaring = roaring::Roaring;
 
-static Roaring fast_or(size_t n, const std::vector<std::unique_ptr<Roaring>>& inputs) {
+static Roaring fast_or(size_t n, const std::vector<std::shared_ptr<const Roaring>>& inputs) {
     const roaring_bitmap_t **x = (const roaring_bitmap_t **)malloc(n * sizeof(roaring_bitmap_t *));
     if (x == NULL) {
         throw std::runtime_error("failed memory alloc in fast_or");
@@ -50,8 +50,8 @@ static Roaring fast_or(size_t n, const std::vector<std::unique_ptr<Roaring>>& in
     return ans;
 }
 
-boost::asio::awaitable<Roaring> get(core::rawdb::DatabaseReader& db_reader, const std::string& table, silkworm::Bytes& key, uint32_t from_block, uint32_t to_block) {
-    std::vector<std::unique_ptr<Roaring>> chuncks;
+boost::asio::awaitable<Roaring> get(const core::rawdb::DatabaseReader& db_reader, const std::string& table, const silkworm::Bytes& key, uint32_t from_block, uint32_t to_block) {
+    std::vector<std::shared_ptr<const Roaring>> chuncks;
 
     silkworm::Bytes from_key{key.begin(), key.end()};
     from_key.resize(key.size() + sizeof(uint32_t));
@@ -61,7 +61,9 @@ boost::asio::awaitable<Roaring> get(core::rawdb::DatabaseReader& db_reader, cons
     Roaring chunck{};
     core::rawdb::Walker walker = [&](const silkworm::Bytes& k, const silkworm::Bytes& v) {
         SILKRPC_TRACE << "k: " << k << " v: " << v << "\n";
-        auto chunck = std::make_unique<Roaring>(Roaring::readSafe(reinterpret_cast<const char*>(v.data()), v.size()));
+        auto chunck = IndexChunkCache::instance().get_or_decode(table, k, v, [&]() {
+            return Roaring::readSafe(reinterpret_cast<const char*>(v.data()), v.size());
+        });
         SILKRPC_TRACE << "chunck: " << chunck->toString() << "\n";
         chuncks.push_back(std::move(chunck));
         auto block = boost::endian::load_big_u32(&k[k.size() - sizeof(uint32_t)]);
@@ -26,10 +26,14 @@
 
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/silkrpc/core/rawdb/accessors.hpp>
+#include <silkworm/silkrpc/ethdb/bitmap_cache.hpp>
 
 namespace silkrpc::ethdb::bitmap {
 
-boost::asio::awaitable<roaring::Roaring> get(core::rawdb::DatabaseReader& db_reader, const std::string& table, silkworm::Bytes& key, uint32_t from_block, uint32_t to_block);
+//! Shared cache of the decoded chunks of log and call index tables
+using IndexChunkCache = ChunkCache<roaring::Roaring>;
+
+boost::asio::awaitable<roaring::Roaring> get(const core::rawdb::DatabaseReader& db_reader, const std::string& table, const silkworm::Bytes& key, uint32_t from_block, uint32_t to_block);
 
 } // silkrpc::ethdb::bitmap
 
@@ -0,0 +1,116 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <boost/compute/detail/lru_cache.hpp>
+#include <silkworm/core/common/base.hpp>
+
+namespace silkrpc::ethdb::bitmap {
+
+// Index chunks are split at about 2KB, so the capacity in chunks also bounds the memory used
+const std::size_t kDefaultChunkCacheCapacity = 8'192;
+
+//! Capacity in chunks of the shared chunk caches, effective only if set before their first use (0 means disabled)
+inline std::atomic_size_t shared_chunk_cache_capacity{kDefaultChunkCacheCapacity};
+
+//! Decoded bitmap chunks shared among requests, keyed by table and chunk key (i.e. indexed key plus chunk end block). The chunk
+//! content is validated by size and hash on each lookup: the open chunk growing with new blocks and the chunks rewritten by unwinds
+//! are decoded again instead of being returned stale
+template <typename Bitmap>
+class ChunkCache {
+public:
+    //! The unique instance shared by all the execution contexts
+    static ChunkCache& instance() {
+        static ChunkCache chunk_cache{shared_chunk_cache_capacity};
+        return chunk_cache;
+    }
+
+    explicit ChunkCache(std::size_t capacity = kDefaultChunkCacheCapacity) : capacity_{capacity}, chunks_(capacity > 0 ? capacity : 1) {}
+
+    ChunkCache(const ChunkCache&) = delete;
+    ChunkCache& operator=(const ChunkCache&) = delete;
+
+    //! Return the cached bitmap if the chunk is unchanged, otherwise decode it and cache the result
+    template <typename Decoder>
+    std::shared_ptr<const Bitmap> get_or_decode(std::string_view table, silkworm::ByteView chunk_key, silkworm::ByteView chunk_value,
+                                                Decoder&& decode) {
+        if (capacity_ == 0) {
+            return std::make_shared<const Bitmap>(decode());
+        }
+
+        // Table names contain no NUL, so the separator is enough to keep the chunk keys of different tables apart
+        std::string key;
+        key.reserve(table.size() + 1 + chunk_key.size());
+        key.append(table).push_back('\0');
+        key.append(reinterpret_cast<const char*>(chunk_key.data()), chunk_key.size());
+        const auto value_hash = std::hash<std::string_view>{}({reinterpret_cast<const char*>(chunk_value.data()), chunk_value.size()});
+        std::shared_ptr<Chunk> cached_chunk;
+        {
+            const std::lock_guard<std::mutex> lock(access_);
+            const auto cached_entry = chunks_.get(key);
+            if (cached_entry) {
+                cached_chunk = *cached_entry;
+                if (cached_chunk->value_size == chunk_value.size() && cached_chunk->value_hash == value_hash) {
+                    ++hit_count_;
+                    return cached_chunk->bitmap;
+                }
+            }
+        }
+        ++miss_count_;
+
+        std::shared_ptr<const Bitmap> bitmap = std::make_shared<const Bitmap>(decode());
+        const std::lock_guard<std::mutex> lock(access_);
+        if (cached_chunk) {
+            // The LRU cache does not replace existing entries, so the stale chunk is updated in place
+            *cached_chunk = Chunk{chunk_value.size(), value_hash, bitmap};
+        } else {
+            chunks_.insert(key, std::make_shared<Chunk>(Chunk{chunk_value.size(), value_hash, bitmap}));
+        }
+        return bitmap;
+    }
+
+    std::size_t size() const {
+        const std::lock_guard<std::mutex> lock(access_);
+        return chunks_.size();
+    }
+    uint64_t hit_count() const noexcept { return hit_count_; }
+    uint64_t miss_count() const noexcept { return miss_count_; }
+
+private:
+    struct Chunk {
+        std::size_t value_size;
+        std::size_t value_hash;
+        std::shared_ptr<const Bitmap> bitmap;
+    };
+
+    const std::size_t capacity_;
+    mutable std::mutex access_;
+    boost::compute::detail::lru_cache<std::string, std::shared_ptr<Chunk>> chunks_;
+    std::atomic_uint64_t hit_count_{0};
+    std::atomic_uint64_t miss_count_{0};
+};
+
+} // namespace silkrpc::ethdb::bitmap
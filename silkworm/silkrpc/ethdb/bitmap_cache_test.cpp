@@ -0,0 +1,147 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "bitmap_cache.hpp"
+
+#include <stdexcept>
+
+#include <catch2/catch.hpp>
+#include <croaring/roaring.hh>
+#include <silkworm/core/common/util.hpp>
+
+namespace silkrpc::ethdb::bitmap {
+
+using roaring::Roaring;
+
+static silkworm::Bytes encode(const Roaring& bitmap) {
+    silkworm::Bytes encoded(bitmap.getSizeInBytes(), '\0');
+    bitmap.write(reinterpret_cast<char*>(encoded.data()));
+    return encoded;
+}
+
+TEST_CASE("chunk cache", "[silkrpc][ethdb][bitmap]") {
+    ChunkCache<Roaring> cache{2};
+    int decode_count{0};
+    const auto decode_with = [&](const silkworm::Bytes& value) {
+        return [&, value]() {
+            ++decode_count;
+            return Roaring::readSafe(reinterpret_cast<const char*>(value.data()), value.size());
+        };
+    };
+
+    const auto key = *silkworm::from_hex("0x0715a7794a1dc8e42615f059dd6e406a6594651aFFFFFFFF");
+    const auto value = encode(Roaring::bitmapOf(3, 1, 2, 3));
+
+    SECTION("unchanged chunk decoded once") {
+        const auto bitmap = cache.get_or_decode("LogAddressIndex", key, value, decode_with(value));
+        const auto cached_bitmap = cache.get_or_decode("LogAddressIndex", key, value, decode_with(value));
+        CHECK(*bitmap == Roaring::bitmapOf(3, 1, 2, 3));
+        CHECK(cached_bitmap == bitmap);
+        CHECK(decode_count == 1);
+        CHECK(cache.hit_count() == 1);
+        CHECK(cache.miss_count() == 1);
+        CHECK(cache.size() == 1);
+    }
+
+    SECTION("changed chunk decoded again") {
+        const auto grown_value = encode(Roaring::bitmapOf(4, 1, 2, 3, 4));
+        cache.get_or_decode("LogAddressIndex", key, value, decode_with(value));
+        const auto bitmap = cache.get_or_decode("LogAddressIndex", key, grown_value, decode_with(grown_value));
+        CHECK(*bitmap == Roaring::bitmapOf(4, 1, 2, 3, 4));
+        CHECK(decode_count == 2);
+        CHECK(cache.hit_count() == 0);
+        CHECK(cache.size() == 1);
+    }
+
+    SECTION("changed chunk replaces the stale one") {
+        const auto grown_value = encode(Roaring::bitmapOf(4, 1, 2, 3, 4));
+        cache.get_or_decode("LogAddressIndex", key, value, decode_with(value));
+        cache.get_or_decode("LogAddressIndex", key, grown_value, decode_with(grown_value));
+        const auto bitmap = cache.get_or_decode("LogAddressIndex", key, grown_value, decode_with(grown_value));
+        CHECK(*bitmap == Roaring::bitmapOf(4, 1, 2, 3, 4));
+        CHECK(decode_count == 2);
+        CHECK(cache.hit_count() == 1);
+        CHECK(cache.size() == 1);
+    }
+
+    SECTION("chunk with same size but different content decoded again") {
+        const auto other_value = encode(Roaring::bitmapOf(3, 1, 2, 4));
+        REQUIRE(other_value.size() == value.size());
+        cache.get_or_decode("LogAddressIndex", key, value, decode_with(value));
+        const auto bitmap = cache.get_or_decode("LogAddressIndex", key, other_value, decode_with(other_value));
+        CHECK(*bitmap == Roaring::bitmapOf(3, 1, 2, 4));
+        CHECK(decode_count == 2);
+    }
+
+    SECTION("long chunk keys are kept apart") {
+        const silkworm::Bytes long_key(300, 0x01);
+        silkworm::Bytes other_long_key(300, 0x01);
+        other_long_key.back() = 0x02;
+        const auto other_value = encode(Roaring::bitmapOf(1, 5));
+        cache.get_or_decode("LogAddressIndex", long_key, value, decode_with(value));
+        const auto bitmap = cache.get_or_decode("LogAddressIndex", other_long_key, other_value, decode_with(other_value));
+        CHECK(*bitmap == Roaring::bitmapOf(1, 5));
+        CHECK(decode_count == 2);
+        CHECK(cache.size() == 2);
+    }
+
+    SECTION("tables are kept apart") {
+        cache.get_or_decode("LogAddressIndex", key, value, decode_with(value));
+        cache.get_or_decode("LogTopicIndex", key, value, decode_with(value));
+        CHECK(decode_count == 2);
+        CHECK(cache.size() == 2);
+    }
+
+    SECTION("least recently used chunk evicted") {
+        const auto other_key = *silkworm::from_hex("0x0715a7794a1dc8e42615f059dd6e406a6594651a00000005");
+        const auto third_key = *silkworm::from_hex("0x0715a7794a1dc8e42615f059dd6e406a6594651a00000006");
+        cache.get_or_decode("LogAddressIndex", key, value, decode_with(value));
+        cache.get_or_decode("LogAddressIndex", other_key, value, decode_with(value));
+        cache.get_or_decode("LogAddressIndex", key, value, decode_with(value));
+        cache.get_or_decode("LogAddressIndex", third_key, value, decode_with(value));
+        CHECK(cache.size() == 2);
+        cache.get_or_decode("LogAddressIndex", key, value, decode_with(value));
+        CHECK(decode_count == 3);
+        cache.get_or_decode("LogAddressIndex", other_key, value, decode_with(value));
+        CHECK(decode_count == 4);
+    }
+
+    SECTION("decoding failure not cached") {
+        const auto failing_decode = []() -> Roaring { throw std::runtime_error{"invalid chunk"}; };
+        CHECK_THROWS_AS(cache.get_or_decode("LogAddressIndex", key, value, failing_decode), std::runtime_error);
+        CHECK(cache.size() == 0);
+        cache.get_or_decode("LogAddressIndex", key, value, decode_with(value));
+        CHECK(decode_count == 1);
+    }
+}
+
+TEST_CASE("disabled chunk cache", "[silkrpc][ethdb][bitmap]") {
+    ChunkCache<Roaring> cache{0};
+    const auto key = *silkworm::from_hex("0x0715a7794a1dc8e42615f059dd6e406a6594651aFFFFFFFF");
+    const auto value = encode(Roaring::bitmapOf(3, 1, 2, 3));
+    int decode_count{0};
+    const auto decode = [&]() {
+        ++decode_count;
+        return Roaring::readSafe(reinterpret_cast<const char*>(value.data()), value.size());
+    };
+    cache.get_or_decode("LogAddressIndex", key, value, decode);
+    const auto bitmap = cache.get_or_decode("LogAddressIndex", key, value, decode);
+    CHECK(*bitmap == Roaring::bitmapOf(3, 1, 2, 3));
+    CHECK(decode_count == 2);
+    CHECK(cache.size() == 0);
+}
+
+} // namespace silkrpc::ethdb::bitmap
@@ -16,41 +16,268 @@
 
 #include "cbor.hpp"
 
-#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 #include <silkworm/silkrpc/common/log.hpp>
-#include <silkworm/silkrpc/json/types.hpp>
 
 namespace silkrpc {
 
-bool cbor_decode(const silkworm::Bytes& bytes, std::vector<Log>& logs) {
-    if (bytes.size() == 0) {
+//! Minimal streaming CBOR reader covering the items stored in Logs and Receipts tables
+class CborReader {
+public:
+    explicit CborReader(silkworm::ByteView bytes) : bytes_{bytes} {}
+
+    [[nodiscard]] bool at_end() const { return position_ == bytes_.size(); }
+
+    //! Return true and consume it if next item is the break stop code of an indefinite-length item
+    bool read_break() {
+        if (peek() == kBreakCode) {
+            ++position_;
+            return true;
+        }
         return false;
     }
-    auto json = nlohmann::json::from_cbor(bytes);
-    SILKRPC_TRACE << "cbor_decode<std::vector<Log>> json: " << json.dump() << "\n";
-    if (json.is_array()) {
-        logs = json.get<std::vector<Log>>();
-        return true;
-    } else {
-        SILKRPC_ERROR << "cbor_decode<std::vector<Log>> unexpected json: " << json.dump() << "\n";
+
+    //! Return true if next item is an array, without consuming it
+    [[nodiscard]] bool is_array() { return peek() >> 5 == kArrayType; }
+
+    //! Read the array header returning the number of entries, empty for indefinite-length arrays
+    std::optional<uint64_t> read_array(const char* context, const char* reason) {
+        const auto [type, info] = read_initial_byte();
+        if (type != kArrayType) {
+            throw_invalid(context, reason);
+        }
+        if (info == kIndefiniteLength) {
+            return std::nullopt;
+        }
+        // Each entry takes at least one byte, so reject sizes that would only trigger huge allocations
+        const auto size = read_argument(info);
+        if (size > bytes_.size() - position_) {
+            throw_invalid(context, "array size exceeds input");
+        }
+        return size;
+    }
+
+    uint64_t read_unsigned(const char* context, const char* reason) {
+        const auto [type, info] = read_initial_byte();
+        if (type != kUnsignedType) {
+            throw_invalid(context, reason);
+        }
+        return read_argument(info);
+    }
+
+    //! Read a byte string, either definite or indefinite-length, appending its content
+    void read_bytes(const char* context, const char* reason, silkworm::Bytes& out) {
+        const auto [type, info] = read_initial_byte();
+        if (type != kBytesType) {
+            throw_invalid(context, reason);
+        }
+        if (info != kIndefiniteLength) {
+            out.append(read_span(read_argument(info)));
+            return;
+        }
+        while (!read_break()) {
+            read_bytes(context, reason, out);
+        }
+    }
+
+    //! Read a definite-length byte string without copying it
+    silkworm::ByteView read_bytes_view(const char* context, const char* reason) {
+        const auto [type, info] = read_initial_byte();
+        if (type != kBytesType || info == kIndefiniteLength) {
+            throw_invalid(context, reason);
+        }
+        return read_span(read_argument(info));
+    }
+
+    //! Return true and consume it if next item is null
+    bool read_null() {
+        if (peek() == kNullCode) {
+            ++position_;
+            return true;
+        }
         return false;
     }
-}
 
-bool cbor_decode(const silkworm::Bytes& bytes, std::vector<Receipt>& receipts) {
-    if (bytes.size() == 0) {
+    //! Skip the next item, whatever its type
+    void skip() {
+        const auto [type, info] = read_initial_byte();
+        if (type == kSimpleType) {
+            if (info >= 24 && info <= 27) {
+                read_span(std::size_t{1} << (info - 24));
+            }
+            return;
+        }
+        if (info == kIndefiniteLength) {
+            while (!read_break()) {
+                skip();
+            }
+            return;
+        }
+        const auto argument = read_argument(info);
+        if (type == kBytesType || type == kTextType) {
+            read_span(argument);
+        } else if (type == kArrayType) {
+            for (uint64_t i{0}; i < argument; ++i) {
+                skip();
+            }
+        } else if (type == kMapType) {
+            for (uint64_t i{0}; i < 2 * argument; ++i) {
+                skip();
+            }
+        } else if (type == kTagType) {
+            skip();
+        }
+    }
+
+    [[noreturn]] static void throw_invalid(const char* context, const char* reason) {
+        throw std::system_error{std::make_error_code(std::errc::invalid_argument), std::string{context} + ": " + reason};
+    }
+
+private:
+    static constexpr uint8_t kUnsignedType{0};
+    static constexpr uint8_t kBytesType{2};
+    static constexpr uint8_t kTextType{3};
+    static constexpr uint8_t kArrayType{4};
+    static constexpr uint8_t kMapType{5};
+    static constexpr uint8_t kTagType{6};
+    static constexpr uint8_t kSimpleType{7};
+    static constexpr uint8_t kIndefiniteLength{31};
+    static constexpr uint8_t kNullCode{0xf6};
+    static constexpr uint8_t kBreakCode{0xff};
+
+    uint8_t peek() {
+        if (at_end()) {
+            throw_invalid("CBOR", "unexpected end of input");
+        }
+        return bytes_[position_];
+    }
+
+    std::pair<uint8_t, uint8_t> read_initial_byte() {
+        const uint8_t initial_byte = peek();
+        ++position_;
+        return {static_cast<uint8_t>(initial_byte >> 5), static_cast<uint8_t>(initial_byte & 0x1f)};
+    }
+
+    uint64_t read_argument(uint8_t info) {
+        if (info < 24) {
+            return info;
+        }
+        if (info > 27) {
+            throw_invalid("CBOR", "unsupported additional information");
+        }
+        uint64_t argument{0};
+        for (const auto byte : read_span(std::size_t{1} << (info - 24))) {
+            argument = (argument << 8) | byte;
+        }
+        return argument;
+    }
+
+    silkworm::ByteView read_span(uint64_t length) {
+        if (length > bytes_.size() - position_) {
+            throw_invalid("CBOR", "unexpected end of input");
+        }
+        const auto span = bytes_.substr(position_, length);
+        position_ += length;
+        return span;
+    }
+
+    silkworm::ByteView bytes_;
+    std::size_t position_{0};
+};
+
+//! Decode the entries of a top-level CBOR array one by one, returning false if the input is not an array
+template <typename T, typename Decoder>
+static bool decode_array(const silkworm::Bytes& bytes, std::vector<T>& items, Decoder decode_item) {
+    if (bytes.empty()) {
         return false;
     }
-    auto json = nlohmann::json::from_cbor(bytes);
-    SILKRPC_TRACE << "cbor_decode<std::vector<Receipt>> json: " << json.dump() << "\n";
-    if (json.is_array()) {
-        receipts = json.get<std::vector<Receipt>>();
-        return true;
-    } else {
-        SILKRPC_ERROR << "cbor_decode<std::vector<Receipt>> unexpected json: " << json.dump() << "\n";
+    CborReader reader{bytes};
+    if (!reader.is_array()) {
+        SILKRPC_ERROR << "cbor_decode unexpected item: " << silkworm::to_hex(bytes) << "\n";
         return false;
     }
+    const auto size = reader.read_array("CBOR", "array expected");
+    items.clear();
+    if (size) {
+        items.resize(*size);
+        for (auto& item : items) {
+            decode_item(reader, item);
+        }
+    } else {
+        while (!reader.read_break()) {
+            decode_item(reader, items.emplace_back());
+        }
+    }
+    if (!reader.at_end()) {
+        CborReader::throw_invalid("CBOR", "expected end of input");
+    }
+    return true;
+}
+
+//! Read the entries of a fixed-layout record, checking that at least min_entries are present
+static uint64_t read_record(CborReader& reader, const char* context, uint64_t min_entries) {
+    const auto size = reader.read_array(context, "array expected");
+    if (!size) {
+        CborReader::throw_invalid(context, "definite-length array expected");
+    }
+    if (*size < min_entries) {
+        CborReader::throw_invalid(context, "missing entries");
+    }
+    return *size;
+}
+
+static void decode_log(CborReader& reader, Log& log) {
+    const auto size = read_record(reader, "Log CBOR", 3);
+
+    log.address = silkworm::to_evmc_address(reader.read_bytes_view("Log CBOR", "binary expected in [0]"));
+
+    const auto topic_count = reader.read_array("Log CBOR", "array expected in [1]");
+    if (topic_count) {
+        log.topics.resize(*topic_count);
+        for (auto& topic : log.topics) {
+            topic = silkworm::to_bytes32(reader.read_bytes_view("Log CBOR", "binary expected in [1]"));
+        }
+    } else {
+        while (!reader.read_break()) {
+            log.topics.push_back(silkworm::to_bytes32(reader.read_bytes_view("Log CBOR", "binary expected in [1]")));
+        }
+    }
+
+    if (!reader.read_null()) {
+        reader.read_bytes("Log CBOR", "binary or null expected in [2]", log.data);
+    }
+
+    for (uint64_t i{3}; i < size; ++i) {
+        reader.skip();
+    }
+}
+
+static void decode_receipt(CborReader& reader, Receipt& receipt) {
+    const auto size = read_record(reader, "Receipt CBOR", 4);
+
+    receipt.type = static_cast<uint8_t>(reader.read_unsigned("Receipt CBOR", "number expected in [0]"));
+    if (!reader.read_null()) {
+        CborReader::throw_invalid("Receipt CBOR", "null expected in [1]");
+    }
+    receipt.success = reader.read_unsigned("Receipt CBOR", "number expected in [2]") == 1u;
+    receipt.cumulative_gas_used = reader.read_unsigned("Receipt CBOR", "number expected in [3]");
+
+    for (uint64_t i{4}; i < size; ++i) {
+        reader.skip();
+    }
+}
+
+bool cbor_decode(const silkworm::Bytes& bytes, std::vector<Log>& logs) {
+    return decode_array(bytes, logs, decode_log);
+}
+
+bool cbor_decode(const silkworm::Bytes& bytes, std::vector<Receipt>& receipts) {
+    return decode_array(bytes, receipts, decode_receipt);
 }
 
 } // namespace silkrpc
@@ -20,8 +20,10 @@
 
 #include <catch2/catch.hpp>
 #include <evmc/evmc.hpp>
+#include <nlohmann/json.hpp>
 #include <silkworm/core/common/util.hpp>
 
+#include <silkworm/silkrpc/json/types.hpp>
 #include <silkworm/silkrpc/types/log.hpp>
 #include <silkworm/silkrpc/types/receipt.hpp>
 
@@ -104,12 +106,39 @@ TEST_CASE("decode logs from CBOR 4", "[silkrpc][ethdb][cbor]") {
     CHECK(silkworm::to_hex(logs[0].data) == "000000000000000000000000000000000000000000084595161401484a000000");
 }
 
+TEST_CASE("decode logs from indefinite-length CBOR", "[silkrpc][ethdb][cbor]") {
+    Logs logs{};
+    CHECK(cbor_decode(*silkworm::from_hex("9f83540715a7794a1dc8e42615f059dd6e406a6594651a9fff5f420011410aff8354ea674fdde714fd979de3edf0f56aa9716b898ec880f6ff"), logs));
+    CHECK(logs.size() == 2);
+    CHECK(logs[0].address == 0x0715a7794a1dc8e42615f059dd6e406a6594651a_address);
+    CHECK(logs[0].topics.empty());
+    CHECK(silkworm::to_hex(logs[0].data) == "00110a");
+    CHECK(logs[1].address == 0xea674fdde714fd979de3edf0f56aa9716b898ec8_address);
+    CHECK(logs[1].data.empty());
+}
+
+TEST_CASE("decode logs from non-array bytes", "[silkrpc][ethdb][cbor]") {
+    Logs logs{};
+    CHECK(!cbor_decode(*silkworm::from_hex("a0"), logs));
+    CHECK(logs.empty());
+}
+
 TEST_CASE("decode logs from incorrect bytes", "[silkrpc][ethdb][cbor]") {
     Logs logs{};
     const auto b1 = *silkworm::from_hex("81");
     CHECK_THROWS(cbor_decode(b1, logs));
     const auto b2 = *silkworm::from_hex("83808040");
     CHECK_THROWS_MATCHES(cbor_decode(b2, logs), std::system_error, Message("Log CBOR: missing entries: "s + invalidArgumentMessage));
+    const auto b3 = *silkworm::from_hex("818354ea674fdde714fd979de3edf0f56aa9716b898ec88043010043ff");
+    CHECK_THROWS_MATCHES(cbor_decode(b3, logs), std::system_error, Message("CBOR: expected end of input: "s + invalidArgumentMessage));
+    const auto b4 = *silkworm::from_hex("9b00000000ffffffff");
+    CHECK_THROWS_AS(cbor_decode(b4, logs), std::system_error);
+    const auto b5 = *silkworm::from_hex("8183018040");
+    CHECK_THROWS_MATCHES(cbor_decode(b5, logs), std::system_error, Message("Log CBOR: binary expected in [0]: "s + invalidArgumentMessage));
+    const auto b6 = *silkworm::from_hex("818341000140");
+    CHECK_THROWS_MATCHES(cbor_decode(b6, logs), std::system_error, Message("Log CBOR: array expected in [1]: "s + invalidArgumentMessage));
+    const auto b7 = *silkworm::from_hex("818341008001");
+    CHECK_THROWS_MATCHES(cbor_decode(b7, logs), std::system_error, Message("Log CBOR: binary or null expected in [2]: "s + invalidArgumentMessage));
 }
 
 TEST_CASE("decode receipts from empty bytes", "[silkrpc][ethdb][cbor]") {
@@ -167,6 +196,49 @@ TEST_CASE("decode receipts from incorrect bytes", "[silkrpc][ethdb][cbor]") {
     CHECK_THROWS(cbor_decode(b1, receipts));
     const auto b2 = *silkworm::from_hex("83808040");
     CHECK_THROWS_MATCHES(cbor_decode(b2, receipts), std::system_error, Message("Receipt CBOR: missing entries: "s + invalidArgumentMessage));
+    const auto b3 = *silkworm::from_hex("8184f6f60101");
+    CHECK_THROWS_MATCHES(cbor_decode(b3, receipts), std::system_error, Message("Receipt CBOR: number expected in [0]: "s + invalidArgumentMessage));
+    const auto b4 = *silkworm::from_hex("818400000101");
+    CHECK_THROWS_MATCHES(cbor_decode(b4, receipts), std::system_error, Message("Receipt CBOR: null expected in [1]: "s + invalidArgumentMessage));
+    const auto b5 = *silkworm::from_hex("818400f6f601");
+    CHECK_THROWS_MATCHES(cbor_decode(b5, receipts), std::system_error, Message("Receipt CBOR: number expected in [2]: "s + invalidArgumentMessage));
+    const auto b6 = *silkworm::from_hex("818400f601f6");
+    CHECK_THROWS_MATCHES(cbor_decode(b6, receipts), std::system_error, Message("Receipt CBOR: number expected in [3]: "s + invalidArgumentMessage));
+}
+
+TEST_CASE("decode logs benchmark", "[.][silkrpc][ethdb][cbor][benchmark]") {
+    // Typical ERC20 transfer log chunk: one transaction emitting three logs with three topics and 32 bytes of data
+    const auto log_item = silkworm::from_hex(
+        "835456c0369e002852c2570ca0cc3442e26df98e01a2835820ddf252ad1be2c89b69c2b068fc37"
+        "8daa952ba7f163c4a11628f55a4df523b3ef5820000000000000000000000000a2e1ffe3aa9cbcde"
+        "1955b04d22e2cc092c3738785820000000000000000000000000520d849db6e4bf7e0c58a45fc513"
+        "a6d633baf77e5820000000000000000000000000000000000000000000084595161401484a000000");
+    silkworm::Bytes chunk{*silkworm::from_hex("83")};
+    for (int i{0}; i < 3; ++i) {
+        chunk += *log_item;
+    }
+
+    BENCHMARK("JSON DOM decode") {
+        return nlohmann::json::from_cbor(chunk).get<Logs>().size();
+    };
+    BENCHMARK("direct decode") {
+        Logs logs{};
+        const bool decoding_ok{cbor_decode(chunk, logs)};
+        return decoding_ok ? logs.size() : 0;
+    };
+}
+
+TEST_CASE("decode receipts benchmark", "[.][silkrpc][ethdb][cbor][benchmark]") {
+    const auto receipts_bytes = *silkworm::from_hex("838400f601196d398400f6011a00371b0b8400f6011a003947f4");
+
+    BENCHMARK("JSON DOM decode") {
+        return nlohmann::json::from_cbor(receipts_bytes).get<Receipts>().size();
+    };
+    BENCHMARK("direct decode") {
+        Receipts receipts{};
+        const bool decoding_ok{cbor_decode(receipts_bytes, receipts)};
+        return decoding_ok ? receipts.size() : 0;
+    };
 }
 
 } // namespace silkrpc
@@ -20,6 +20,7 @@
 
 #include <silkworm/silkrpc/config.hpp>
 
+#include <boost/asio/this_coro.hpp>
 #include <grpcpp/grpcpp.h>
 
 #include <silkworm/silkrpc/common/log.hpp>
@@ -46,6 +47,8 @@ boost::asio::awaitable<std::shared_ptr<CursorDupSort>> RemoteTransaction::cursor
 }
 
 boost::asio::awaitable<void> RemoteTransaction::close() {
+    // The request may have been cancelled (e.g. client disconnected, deadline expired): the remote transaction must be closed anyway
+    co_await boost::asio::this_coro::reset_cancellation_state();
     co_await tx_rpc_.writes_done_and_finish();
     cursors_.clear();
     tx_id_ = 0;
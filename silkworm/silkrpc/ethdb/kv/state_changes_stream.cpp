@@ -16,8 +16,11 @@
 
 #include "state_changes_stream.hpp"
 
+#include <exception>
 #include <ostream>
+#include <utility>
 
+#include <boost/asio/detached.hpp>
 #include <boost/asio/experimental/as_tuple.hpp>
 #include <boost/asio/this_coro.hpp>
 #include <boost/asio/use_future.hpp>
@@ -25,7 +28,11 @@
 #include <grpc/grpc.h>
 
 #include <silkworm/silkrpc/common/log.hpp>
+#include <silkworm/silkrpc/core/cached_chain.hpp>
+#include <silkworm/silkrpc/core/receipts.hpp>
+#include <silkworm/silkrpc/ethdb/transaction_database.hpp>
 #include <silkworm/silkrpc/grpc/util.hpp>
+#include <silkworm/node/rpc/common/conversion.hpp>
 
 namespace silkrpc::ethdb::kv {
 
@@ -42,6 +49,12 @@ StateChangesStream::StateChangesStream(Context& context, remote::KV::StubInterfa
     : scheduler_(*context.io_context()),
       grpc_context_(*context.grpc_context()),
       cache_(context.state_cache().get()),
+      gas_price_window_(context.gas_price_window().get()),
+      filter_registry_(context.filter_registry().get()),
+      tip_log_index_(context.tip_log_index().get()),
+      database_(context.database().get()),
+      block_cache_(context.block_cache().get()),
+      receipts_cache_(context.receipts_cache().get()),
       stub_(stub),
       retry_timer_{scheduler_} {}
 
@@ -98,6 +111,7 @@ boost::asio::awaitable<void> StateChangesStream::run() {
             if (!read_ec) {
                 SILKRPC_INFO << "State changes batch received: " << reply << "\n";
                 cache_->on_new_block(reply);
+                notify_block_changes(reply);
             } else {
                 if (read_ec.value() == grpc::StatusCode::CANCELLED) {
                     cancelled = true;
@@ -118,4 +132,68 @@ boost::asio::awaitable<void> StateChangesStream::run() {
     SILKRPC_TRACE << "StateChangesStream::run state stream END\n";
 }
 
+void StateChangesStream::notify_block_changes(const remote::StateChangeBatch& batch) {
+    for (const auto& state_change : batch.changebatch()) {
+        const auto block_hash = silkworm::rpc::bytes32_from_H256(state_change.blockhash());
+        if (state_change.direction() == remote::Direction::UNWIND) {
+            if (gas_price_window_ != nullptr) {
+                gas_price_window_->on_unwind(state_change.blockheight());
+            }
+            if (filter_registry_ != nullptr) {
+                filter_registry_->on_unwind(state_change.blockheight());
+            }
+            if (tip_log_index_ != nullptr) {
+                tip_log_index_->on_unwind(state_change.blockheight());
+            }
+        } else {
+            if (gas_price_window_ != nullptr) {
+                gas_price_window_->on_new_block(state_change.blockheight(), block_hash);
+            }
+            if (filter_registry_ != nullptr) {
+                filter_registry_->on_new_block(state_change.blockheight(), block_hash);
+            }
+            if (tip_log_index_ != nullptr) {
+                tip_log_index_->on_new_block(state_change.blockheight(), block_hash);
+            }
+            if (gas_price_window_ != nullptr || tip_log_index_ != nullptr) {
+                boost::asio::co_spawn(scheduler_, process_new_block(state_change.blockheight(), block_hash), boost::asio::detached);
+            }
+        }
+    }
+}
+
+boost::asio::awaitable<void> StateChangesStream::process_new_block(uint64_t block_number, evmc::bytes32 block_hash) {
+    try {
+        auto tx = co_await database_->begin();
+        std::exception_ptr eptr;
+        try {
+            TransactionDatabase tx_database{*tx};
+            const auto block_with_hash = co_await core::read_block_by_hash(*block_cache_, tx_database, block_hash);
+            if (gas_price_window_ != nullptr) {
+                gas_price_window_->insert(make_block_price_samples(block_with_hash, kSamples));
+            }
+            if (tip_log_index_ != nullptr) {
+                const auto receipts = co_await core::get_receipts(tx_database, block_with_hash, block_cache_, receipts_cache_);
+                // Receipts not stored cannot be regenerated here, so such blocks are just left out of the index
+                if (receipts.size() == block_with_hash.block.transactions.size()) {
+                    Logs logs;
+                    for (const auto& receipt : receipts) {
+                        logs.insert(logs.end(), receipt.logs.begin(), receipt.logs.end());
+                    }
+                    const auto indexed = tip_log_index_->insert(block_number, block_hash, std::move(logs));
+                    SILKRPC_DEBUG << "Tip log index block: " << block_number << " indexed: " << indexed << "\n";
+                }
+            }
+        } catch (...) {
+            eptr = std::current_exception();
+        }
+        co_await tx->close(); // RAII not (yet) available with coroutines
+        if (eptr) {
+            std::rethrow_exception(eptr);
+        }
+    } catch (const std::exception& e) {
+        SILKRPC_WARN << "New block: " << block_number << " not processed: " << e.what() << "\n";
+    }
+}
+
 } // namespace silkrpc::ethdb::kv
@@ -73,6 +73,12 @@ public:
     boost::asio::awaitable<void> run();
 
 private:
+    //! Notify the block-level listeners about the new canonical blocks or the unwound ones
+    void notify_block_changes(const remote::StateChangeBatch& batch);
+
+    //! Read the given new canonical block once, adding its price samples to the gas price window and its logs to the tip log index
+    boost::asio::awaitable<void> process_new_block(uint64_t block_number, evmc::bytes32 block_hash);
+
     //! The retry interval between successive registration attempts
     static boost::posix_time::milliseconds registration_interval_;
 
@@ -88,6 +94,20 @@ private:
     //! The local state cache where the received state changes will be applied
     StateCache* cache_;
 
+    //! The gas price window to keep in sync with the chain head (optional)
+    GasPriceWindow* gas_price_window_;
+
+    //! The installed filters to keep in sync with the chain head (optional)
+    FilterRegistry* filter_registry_;
+
+    //! The in-memory index of the logs at the chain head (optional)
+    TipLogIndex* tip_log_index_;
+
+    //! The database, block cache and receipts cache used to read the new blocks and their logs
+    ethdb::Database* database_;
+    BlockCache* block_cache_;
+    ReceiptsCache* receipts_cache_;
+
     //! The signal used to cancel the register-and-receive stream loop
     boost::asio::cancellation_signal cancellation_signal_;
 
@@ -19,8 +19,11 @@
 #include <climits>
 #include <exception>
 
+#include <boost/asio/this_coro.hpp>
+
 #include <silkworm/silkrpc/common/log.hpp>
 #include <silkworm/silkrpc/common/util.hpp>
+#include <silkworm/silkrpc/concurrency/cancellation.hpp>
 
 namespace silkrpc::ethdb {
 
@@ -75,6 +78,8 @@ boost::asio::awaitable<void> TransactionDatabase::walk(const std::string& table,
         if (!go_on) {
             break;
         }
+        // Local cursors never suspend, so the request cancellation must be checked explicitly
+        throw_if_cancelled(co_await boost::asio::this_coro::cancellation_state);
         kv_pair = co_await cursor->next();
         k = kv_pair.key;
         v = kv_pair.value;
@@ -95,6 +100,8 @@ boost::asio::awaitable<void> TransactionDatabase::for_prefix(const std::string&
         if (!go_on) {
             break;
         }
+        // Local cursors never suspend, so the request cancellation must be checked explicitly
+        throw_if_cancelled(co_await boost::asio::this_coro::cancellation_state);
         kv_pair = co_await cursor->next();
         k = kv_pair.key;
         v = kv_pair.value;
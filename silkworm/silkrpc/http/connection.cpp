@@ -39,8 +39,10 @@
 
 namespace silkrpc::http {
 
-Connection::Connection(Context& context, boost::asio::thread_pool& workers, commands::RpcApiTable& handler_table, std::optional<std::string> jwt_secret)
-        : socket_{*context.io_context()}, request_handler_{context, workers, socket_, handler_table, jwt_secret} {
+Connection::Connection(Context& context, boost::asio::thread_pool& workers, commands::RpcApiTable& handler_table, std::optional<std::string> jwt_secret,
+                       const RequestPolicy& policy)
+        : socket_{*context.io_context()},
+          request_handler_{context, workers, socket_, handler_table, jwt_secret, policy} {
     request_.content.reserve(kRequestContentInitialCapacity);
     request_.headers.reserve(kRequestHeadersInitialCapacity);
     request_.method.reserve(kRequestMethodInitialCapacity);
@@ -57,6 +59,17 @@ boost::asio::awaitable<void> Connection::start() {
     co_await do_read();
 }
 
+boost::asio::awaitable<void> Connection::reject() {
+    try {
+        reply_ = Reply::stock_reply(StatusType::service_unavailable);
+        co_await do_write();
+    } catch (const boost::system::system_error& se) {
+        SILKRPC_DEBUG << "Connection::reject system_error: " << se.what() << "\n" << std::flush;
+    }
+    boost::system::error_code ec;
+    socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+}
+
 boost::asio::awaitable<void> Connection::do_read() {
     try {
         SILKRPC_DEBUG << "Connection::do_read going to read...\n" << std::flush;
@@ -84,6 +97,8 @@ boost::asio::awaitable<void> Connection::do_read() {
     } catch (const boost::system::system_error& se) {
         if (se.code() == boost::asio::error::eof || se.code() == boost::asio::error::connection_reset || se.code() == boost::asio::error::broken_pipe) {
             SILKRPC_DEBUG << "Connection::do_read close from client with code: " << se.code() << "\n" << std::flush;
+        } else if (se.code() == boost::asio::error::timed_out) {
+            SILKRPC_DEBUG << "Connection::do_read close on streamed request deadline\n" << std::flush;
         } else if (se.code() != boost::asio::error::operation_aborted) {
             SILKRPC_ERROR << "Connection::do_read system_error: " << se.what() << "\n" << std::flush;
             std::rethrow_exception(std::make_exception_ptr(se));
@@ -33,6 +33,7 @@
 
 #include <silkworm/silkrpc/commands/rpc_api_table.hpp>
 #include <silkworm/silkrpc/common/constants.hpp>
+#include <silkworm/silkrpc/concurrency/admission_controller.hpp>
 #include <silkworm/silkrpc/concurrency/context_pool.hpp>
 #include <silkworm/silkrpc/http/reply.hpp>
 #include <silkworm/silkrpc/http/request.hpp>
@@ -48,7 +49,8 @@ public:
     Connection& operator=(const Connection&) = delete;
 
     /// Construct a connection running within the given execution context.
-    Connection(Context& context, boost::asio::thread_pool& workers, commands::RpcApiTable& handler_table, std::optional<std::string> jwt_secret);
+    Connection(Context& context, boost::asio::thread_pool& workers, commands::RpcApiTable& handler_table, std::optional<std::string> jwt_secret,
+               const RequestPolicy& policy = {});
 
     ~Connection();
 
@@ -57,6 +59,9 @@ public:
     /// Start the first asynchronous operation for the connection.
     boost::asio::awaitable<void> start();
 
+    /// Answer the connection as service unavailable, then close it.
+    boost::asio::awaitable<void> reject();
+
 private:
     // reset connection data
     void clean();
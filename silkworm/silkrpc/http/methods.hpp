@@ -40,6 +40,8 @@ constexpr const char* k_eth_chainId{"eth_chainId"};
 constexpr const char* k_eth_protocolVersion{"eth_protocolVersion"};
 constexpr const char* k_eth_syncing{"eth_syncing"};
 constexpr const char* k_eth_gasPrice{"eth_gasPrice"};
+constexpr const char* k_eth_maxPriorityFeePerGas{"eth_maxPriorityFeePerGas"};
+constexpr const char* k_eth_feeHistory{"eth_feeHistory"};
 constexpr const char* k_eth_getUncleByBlockHashAndIndex{"eth_getUncleByBlockHashAndIndex"};
 constexpr const char* k_eth_getUncleByBlockNumberAndIndex{"eth_getUncleByBlockNumberAndIndex"};
 constexpr const char* k_eth_getUncleCountByBlockHash{"eth_getUncleCountByBlockHash"};
@@ -0,0 +1,67 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "request_dispatcher.hpp"
+
+#include <stdexcept>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+namespace silkrpc::http {
+
+RequestDispatcher::RequestDispatcher(ContextPool& context_pool, boost::asio::thread_pool& workers) : load_{context_pool.size()} {
+    contexts_.reserve(context_pool.size());
+    rpc_apis_.reserve(context_pool.size());
+    for (std::size_t i{0}; i < context_pool.size(); ++i) {
+        auto& context = context_pool.context(i);
+        contexts_.push_back(&context);
+        rpc_apis_.push_back(std::make_unique<commands::RpcApi>(context, workers));
+    }
+}
+
+boost::asio::awaitable<void> RequestDispatcher::dispatch(commands::RpcApiTable::HandleMethod handler, const nlohmann::json& request_json,
+                                                         nlohmann::json& reply_json, const boost::asio::io_context& local_io_context) {
+    const auto local_index = index_of(local_io_context);
+    const auto index = load_.select(local_index);
+    auto& rpc_api = *rpc_apis_[index];
+
+    load_.increment(index);
+    try {
+        if (index == local_index) {
+            co_await (rpc_api.*handler)(request_json, reply_json);
+        } else {
+            // The request and reply are not touched by the local context until the remote execution completes
+            ++dispatched_count_;
+            co_await boost::asio::co_spawn(*contexts_[index]->io_context(), (rpc_api.*handler)(request_json, reply_json), boost::asio::use_awaitable);
+        }
+    } catch (...) {
+        load_.decrement(index);
+        throw;
+    }
+    load_.decrement(index);
+}
+
+std::size_t RequestDispatcher::index_of(const boost::asio::io_context& io_context) const {
+    for (std::size_t i{0}; i < contexts_.size(); ++i) {
+        if (contexts_[i]->io_context() == &io_context) {
+            return i;
+        }
+    }
+    throw std::logic_error{"RequestDispatcher::index_of unknown io_context"};
+}
+
+} // namespace silkrpc::http
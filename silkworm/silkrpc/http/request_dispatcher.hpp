@@ -0,0 +1,64 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <silkworm/silkrpc/config.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <nlohmann/json.hpp>
+
+#include <silkworm/silkrpc/commands/rpc_api.hpp>
+#include <silkworm/silkrpc/commands/rpc_api_table.hpp>
+#include <silkworm/silkrpc/concurrency/context_load.hpp>
+#include <silkworm/silkrpc/concurrency/context_pool.hpp>
+
+namespace silkrpc::http {
+
+//! Distribution of the JSON requests across the execution contexts: each request runs on the least-loaded context
+//! while the socket I/O of its connection stays on the connection context
+class RequestDispatcher {
+public:
+    explicit RequestDispatcher(ContextPool& context_pool, boost::asio::thread_pool& workers);
+
+    RequestDispatcher(const RequestDispatcher&) = delete;
+    RequestDispatcher& operator=(const RequestDispatcher&) = delete;
+
+    //! Run the handler on the least-loaded context using the RPC API bound to it, then resume on the local context
+    boost::asio::awaitable<void> dispatch(commands::RpcApiTable::HandleMethod handler, const nlohmann::json& request_json,
+                                          nlohmann::json& reply_json, const boost::asio::io_context& local_io_context);
+
+    const ContextLoad& load() const noexcept { return load_; }
+    uint64_t dispatched_count() const noexcept { return dispatched_count_; }
+
+private:
+    std::size_t index_of(const boost::asio::io_context& io_context) const;
+
+    std::vector<Context*> contexts_;
+    std::vector<std::unique_ptr<commands::RpcApi>> rpc_apis_;
+    ContextLoad load_;
+    std::atomic_uint64_t dispatched_count_{0};
+};
+
+} // namespace silkrpc::http
@@ -22,11 +22,14 @@
 
 #include "request_handler.hpp"
 
+#include <array>
 #include <iostream>
 #include <utility>
 #include <vector>
 
 #include <jwt-cpp/jwt.h>
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/write.hpp>
 #include <nlohmann/json.hpp>
 
@@ -114,25 +117,42 @@ boost::asio::awaitable<void> RequestHandler::handle_request(const nlohmann::json
         co_return;
     }
     const auto json_handler_opt = rpc_api_table_.find_json_handler(method);
-    if (json_handler_opt) {
-        const auto json_handler = json_handler_opt.value();
-
-        co_await handle_request(json_handler, request_json, reply);
-
+    const auto stream_handler_opt = json_handler_opt ? std::nullopt : rpc_api_table_.find_stream_handler(method);
+    if (!json_handler_opt && !stream_handler_opt) {
+        reply.content = make_json_error(request_id, -32601, "the method " + method + " does not exist/is not available").dump();
+        reply.status = http::StatusType::not_implemented;
         co_return;
     }
 
-    const auto stream_handler_opt = rpc_api_table_.find_stream_handler(method);
-    if (stream_handler_opt) {
-        const auto stream_handler = stream_handler_opt.value();
+    const auto start = clock_time::now();
+    const auto cost_class = commands::RpcApiTable::find_cost_class(method);
 
-        co_await handle_request(stream_handler, request_json);
+    // Under overload the low-priority requests fail fast, so that the admitted ones keep being served quickly
+    std::optional<AdmissionTicket> admission_ticket;
+    if (policy_.admission_controller != nullptr) {
+        if (!policy_.admission_controller->try_admit_request(cost_class, io_context_)) {
+            reply.content = make_json_error(request_id, -32005, "server busy").dump();
+            reply.status = http::StatusType::service_unavailable;
+            co_return;
+        }
+        admission_ticket.emplace(*policy_.admission_controller, io_context_);
+    }
 
-        co_return;
+    // Heavy requests and the ones having a deadline are abandoned as soon as nobody is waiting for their outcome, even if still queued
+    const auto timeout = policy_.request_timeouts != nullptr ? policy_.request_timeouts->timeout(method) : std::chrono::milliseconds{0};
+    if (cost_class != CostClass::light || timeout.count() > 0) {
+        co_await handle_cancellable_request(cost_class, json_handler_opt, stream_handler_opt, request_json, reply, timeout);
+    } else {
+        co_await handle_limited_request(cost_class, json_handler_opt, stream_handler_opt, request_json, reply);
     }
 
-    reply.content = make_json_error(request_id, -32601, "the method " + method + " does not exist/is not available").dump();
-    reply.status = http::StatusType::not_implemented;
+    if (policy_.latency_monitor != nullptr) {
+        const auto latency = clock_time::since(start);
+        if (!policy_.latency_monitor->record(latency)) {
+            SILKRPC_WARN << "method " << method << " latency t=" << latency << "ns exceeds SLO t=" << policy_.latency_monitor->slo_ns() << "ns"
+                         << " [violations: " << policy_.latency_monitor->slo_violations() << "/" << policy_.latency_monitor->count() << "]\n";
+        }
+    }
 
     co_return;
 }
@@ -141,7 +161,11 @@ boost::asio::awaitable<void> RequestHandler::handle_request(silkrpc::commands::R
     auto request_id = request_json["id"].get<uint32_t>();
     try {
         nlohmann::json reply_json;
-        co_await (rpc_api_.*handler)(request_json, reply_json);
+        if (policy_.request_dispatcher != nullptr) {
+            co_await policy_.request_dispatcher->dispatch(handler, request_json, reply_json, io_context_);
+        } else {
+            co_await (rpc_api_.*handler)(request_json, reply_json);
+        }
 
         reply.content = reply_json.dump(
             /*indent=*/-1, /*indent_char=*/' ', /*ensure_ascii=*/false, nlohmann::json::error_handler_t::replace);
@@ -178,6 +202,79 @@ boost::asio::awaitable<void> RequestHandler::handle_request(silkrpc::commands::R
     co_return;
 }
 
+boost::asio::awaitable<void> RequestHandler::handle_limited_request(CostClass cost_class,
+                                                                    std::optional<silkrpc::commands::RpcApiTable::HandleMethod> json_handler,
+                                                                    std::optional<silkrpc::commands::RpcApiTable::HandleStream> stream_handler,
+                                                                    const nlohmann::json& request_json, http::Reply& reply) {
+    // Requests wait for a free slot in the cost class of their method, so that heavy traffic degrades only itself
+    std::optional<CostClassPermit> cost_class_permit;
+    if (policy_.cost_class_limiter != nullptr) {
+        co_await policy_.cost_class_limiter->acquire(cost_class, io_context_);
+        cost_class_permit.emplace(*policy_.cost_class_limiter, cost_class);
+    }
+
+    if (json_handler) {
+        co_await handle_request(*json_handler, request_json, reply);
+    } else {
+        co_await handle_request(*stream_handler, request_json);
+    }
+}
+
+boost::asio::awaitable<void> RequestHandler::handle_cancellable_request(CostClass cost_class,
+                                                                        std::optional<silkrpc::commands::RpcApiTable::HandleMethod> json_handler,
+                                                                        std::optional<silkrpc::commands::RpcApiTable::HandleStream> stream_handler,
+                                                                        const nlohmann::json& request_json, http::Reply& reply, std::chrono::milliseconds timeout) {
+    using namespace boost::asio::experimental::awaitable_operators;
+
+    // The losing branches are cancelled: a queued request leaves its cost class queue, a running handler stops at its next asynchronous
+    // operation or cancellation check. The outcome is available only when all branches have completed, so a cancelled handler still
+    // delays the reply until its running step ends
+    auto handling = handle_limited_request(cost_class, json_handler, stream_handler, request_json, reply);
+    const auto outcome = co_await (std::move(handling) || wait_for_disconnection() || wait_for_deadline(timeout));
+    if (outcome.index() == 1) {
+        SILKRPC_DEBUG << "RequestHandler::handle_cancellable_request client disconnected, request cancelled\n";
+        throw boost::system::system_error{boost::asio::error::eof};
+    }
+    if (outcome.index() == 2) {
+        SILKRPC_WARN << "RequestHandler::handle_cancellable_request deadline t=" << timeout.count() << "ms expired, request cancelled\n";
+        if (stream_handler) {
+            // The reply has been partially written already, so the connection cannot be used anymore
+            throw boost::system::system_error{boost::asio::error::timed_out};
+        }
+        const auto request_id = request_json["id"].get<uint32_t>();
+        reply.content = make_json_error(request_id, -32002, "request timed out").dump();
+        reply.status = http::StatusType::service_unavailable;
+    }
+}
+
+boost::asio::awaitable<void> RequestHandler::wait_for_disconnection() {
+    while (true) {
+        co_await socket_.async_wait(boost::asio::ip::tcp::socket::wait_read, boost::asio::use_awaitable);
+
+        std::array<char, 1> data;
+        boost::system::error_code ec;
+        const auto bytes_peeked = socket_.receive(boost::asio::buffer(data), boost::asio::ip::tcp::socket::message_peek, ec);
+        if (ec == boost::asio::error::would_block || ec == boost::asio::error::try_again) {
+            continue;
+        }
+        if (bytes_peeked > 0 && !ec) {
+            // The next pipelined request has arrived: the disconnection will be detected when reading it
+            co_await wait_for_deadline(std::chrono::milliseconds{0});
+        }
+        co_return;
+    }
+}
+
+boost::asio::awaitable<void> RequestHandler::wait_for_deadline(std::chrono::milliseconds timeout) {
+    boost::asio::steady_timer timer{io_context_};
+    if (timeout.count() > 0) {
+        timer.expires_after(timeout);
+    } else {
+        timer.expires_at(boost::asio::steady_timer::time_point::max());
+    }
+    co_await timer.async_wait(boost::asio::use_awaitable);
+}
+
 boost::asio::awaitable<std::optional<std::string>> RequestHandler::is_request_authorized(uint32_t request_id, const http::Request& request) {
     if (!jwt_secret_.has_value()) {
         co_return std::nullopt;
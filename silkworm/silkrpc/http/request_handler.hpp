@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <string>
@@ -29,17 +30,37 @@
 #include <silkworm/silkrpc/concurrency/context_pool.hpp>
 #include <silkworm/silkrpc/commands/rpc_api.hpp>
 #include <silkworm/silkrpc/commands/rpc_api_table.hpp>
+#include <silkworm/silkrpc/common/latency_monitor.hpp>
+#include <silkworm/silkrpc/concurrency/admission_controller.hpp>
+#include <silkworm/silkrpc/concurrency/cost_class_limiter.hpp>
 #include <silkworm/silkrpc/http/reply.hpp>
 #include <silkworm/silkrpc/http/request.hpp>
+#include <silkworm/silkrpc/http/request_dispatcher.hpp>
+#include <silkworm/silkrpc/http/request_timeouts.hpp>
 
 namespace silkrpc::http {
 
+//! The policies applied to the requests, each one optional and shared among servers
+struct RequestPolicy {
+    //! The limiter of concurrent requests by cost class
+    CostClassLimiter* cost_class_limiter{nullptr};
+    //! The latency statistics of the served calls
+    LatencyMonitor* latency_monitor{nullptr};
+    //! The admission control of connections and requests
+    AdmissionController* admission_controller{nullptr};
+    //! The deadlines of the requests by method
+    const RequestTimeouts* request_timeouts{nullptr};
+    //! The distribution of the requests across the contexts
+    RequestDispatcher* request_dispatcher{nullptr};
+};
+
 class RequestHandler {
 public:
     RequestHandler(Context& context, boost::asio::thread_pool& workers,
         boost::asio::ip::tcp::socket& socket, const commands::RpcApiTable& rpc_api_table,
-        std::optional<std::string> jwt_secret)
-        : rpc_api_{context, workers}, io_context_{*context.io_context()}, socket_{socket}, rpc_api_table_(rpc_api_table), jwt_secret_(jwt_secret)  {}
+        std::optional<std::string> jwt_secret, const RequestPolicy& policy = {})
+        : rpc_api_{context, workers}, io_context_{*context.io_context()}, socket_{socket}, rpc_api_table_(rpc_api_table), jwt_secret_(jwt_secret),
+          policy_(policy) {}
 
     RequestHandler(const RequestHandler&) = delete;
     RequestHandler& operator=(const RequestHandler&) = delete;
@@ -53,6 +74,22 @@ private:
     boost::asio::awaitable<void> handle_request(silkrpc::commands::RpcApiTable::HandleMethod handler, const nlohmann::json& request_json, http::Reply& reply);
     boost::asio::awaitable<void> handle_request(silkrpc::commands::RpcApiTable::HandleStream handler, const nlohmann::json& request_json);
 
+    //! Handle the request as soon as a free slot in its cost class is available
+    boost::asio::awaitable<void> handle_limited_request(CostClass cost_class, std::optional<silkrpc::commands::RpcApiTable::HandleMethod> json_handler,
+                                                        std::optional<silkrpc::commands::RpcApiTable::HandleStream> stream_handler,
+                                                        const nlohmann::json& request_json, http::Reply& reply);
+
+    //! Handle the request until completion, client disconnection or deadline expiration, whichever comes first
+    boost::asio::awaitable<void> handle_cancellable_request(CostClass cost_class, std::optional<silkrpc::commands::RpcApiTable::HandleMethod> json_handler,
+                                                            std::optional<silkrpc::commands::RpcApiTable::HandleStream> stream_handler,
+                                                            const nlohmann::json& request_json, http::Reply& reply, std::chrono::milliseconds timeout);
+
+    //! Wait until the client closes the connection
+    boost::asio::awaitable<void> wait_for_disconnection();
+
+    //! Wait until the timeout expires, forever if zero
+    boost::asio::awaitable<void> wait_for_deadline(std::chrono::milliseconds timeout);
+
     boost::asio::awaitable<void> do_write(http::Reply& reply);
     boost::asio::awaitable<void> write_headers();
 
@@ -61,6 +98,7 @@ private:
     boost::asio::ip::tcp::socket& socket_;
     const commands::RpcApiTable& rpc_api_table_;
     const std::optional<std::string> jwt_secret_;
+    const RequestPolicy policy_;
 };
 
 } // namespace silkrpc::http
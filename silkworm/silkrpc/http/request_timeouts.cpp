@@ -0,0 +1,50 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "request_timeouts.hpp"
+
+#include <stdexcept>
+
+namespace silkrpc::http {
+
+RequestTimeouts::RequestTimeouts(std::chrono::milliseconds default_timeout, const std::string& method_timeouts)
+    : default_timeout_(default_timeout) {
+    std::size_t start{0};
+    while (start < method_timeouts.size()) {
+        auto end = method_timeouts.find(',', start);
+        if (end == std::string::npos) {
+            end = method_timeouts.size();
+        }
+        const auto method_timeout = method_timeouts.substr(start, end - start);
+        const auto separator = method_timeout.find(':');
+        if (separator == 0 || separator == std::string::npos || separator + 1 == method_timeout.size()) {
+            throw std::invalid_argument{"invalid method timeout: " + method_timeout};
+        }
+        const auto milliseconds = method_timeout.substr(separator + 1);
+        if (milliseconds.find_first_not_of("0123456789") != std::string::npos) {
+            throw std::invalid_argument{"invalid method timeout: " + method_timeout};
+        }
+        method_timeouts_[method_timeout.substr(0, separator)] = std::chrono::milliseconds{std::stoull(milliseconds)};
+        start = end + 1;
+    }
+}
+
+std::chrono::milliseconds RequestTimeouts::timeout(const std::string& method) const {
+    const auto it = method_timeouts_.find(method);
+    return it != method_timeouts_.end() ? it->second : default_timeout_;
+}
+
+} // namespace silkrpc::http
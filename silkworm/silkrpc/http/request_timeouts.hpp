@@ -0,0 +1,39 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <string>
+
+namespace silkrpc::http {
+
+//! The deadlines of the requests by method, zero means no deadline. A deadline does not bound the latency of EVM execution: the expired
+//! request is answered only after its handler has stopped, and a transaction running on a worker cannot be interrupted
+class RequestTimeouts {
+public:
+    //! Build from the default timeout and the per-method ones as comma-separated list of <method>:<milliseconds>
+    explicit RequestTimeouts(std::chrono::milliseconds default_timeout = {}, const std::string& method_timeouts = "");
+
+    std::chrono::milliseconds timeout(const std::string& method) const;
+
+private:
+    std::chrono::milliseconds default_timeout_;
+    std::map<std::string, std::chrono::milliseconds> method_timeouts_;
+};
+
+} // namespace silkrpc::http
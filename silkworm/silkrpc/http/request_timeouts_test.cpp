@@ -0,0 +1,48 @@
+/*
+    Copyright 2021 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "request_timeouts.hpp"
+
+#include <stdexcept>
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc::http {
+
+using namespace std::chrono_literals;
+
+TEST_CASE("request timeouts", "[silkrpc][http][request_timeouts]") {
+    SECTION("no timeouts") {
+        const RequestTimeouts timeouts;
+        CHECK(timeouts.timeout("eth_call") == 0ms);
+    }
+
+    SECTION("default and per-method timeouts") {
+        const RequestTimeouts timeouts{5'000ms, "trace_filter:60000,eth_call:0"};
+        CHECK(timeouts.timeout("eth_getLogs") == 5'000ms);
+        CHECK(timeouts.timeout("trace_filter") == 60'000ms);
+        CHECK(timeouts.timeout("eth_call") == 0ms);
+    }
+
+    SECTION("invalid per-method timeouts") {
+        CHECK_THROWS_AS((RequestTimeouts{0ms, "trace_filter"}), std::invalid_argument);
+        CHECK_THROWS_AS((RequestTimeouts{0ms, ":100"}), std::invalid_argument);
+        CHECK_THROWS_AS((RequestTimeouts{0ms, "eth_call:"}), std::invalid_argument);
+        CHECK_THROWS_AS((RequestTimeouts{0ms, "eth_call:1s"}), std::invalid_argument);
+    }
+}
+
+} // namespace silkrpc::http
@@ -28,6 +28,7 @@
 #include <utility>
 
 #include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
 #include <boost/asio/dispatch.hpp>
 #include <boost/asio/use_awaitable.hpp>
 
@@ -50,8 +51,9 @@ std::tuple<std::string, std::string> Server::parse_endpoint(const std::string& t
     return {host, port};
 }
 
-Server::Server(const std::string& end_point, const std::string& api_spec, Context& context, boost::asio::thread_pool& workers, std::optional<std::string> jwt_secret)
-: context_(context), workers_(workers), acceptor_{*context.io_context()}, handler_table_{api_spec}, jwt_secret_(jwt_secret) {
+Server::Server(const std::string& end_point, const std::string& api_spec, Context& context, boost::asio::thread_pool& workers, std::optional<std::string> jwt_secret,
+               const RequestPolicy& policy)
+: context_(context), workers_(workers), acceptor_{*context.io_context()}, handler_table_{api_spec}, jwt_secret_(jwt_secret), policy_(policy) {
     const auto [host, port] = parse_endpoint(end_point);
 
     // Open the acceptor with the option to reuse the address (i.e. SO_REUSEADDR).
@@ -78,19 +80,31 @@ boost::asio::awaitable<void> Server::run() {
 
             SILKRPC_DEBUG << "Server::run accepting using io_context " << io_context << "...\n" << std::flush;
 
-            auto new_connection = std::make_shared<Connection>(context_, workers_, handler_table_, jwt_secret_);
+            auto new_connection = std::make_shared<Connection>(context_, workers_, handler_table_, jwt_secret_, policy_);
             co_await acceptor_.async_accept(new_connection->socket(), boost::asio::use_awaitable);
             if (!acceptor_.is_open()) {
                 SILKRPC_TRACE << "Server::run returning...\n";
                 co_return;
             }
 
+            // Connections beyond the limits are answered at once, so that clients can back off instead of waiting
+            boost::system::error_code ec;
+            const auto remote_address = new_connection->socket().remote_endpoint(ec).address();
+            if (policy_.admission_controller != nullptr && !policy_.admission_controller->try_open_connection(remote_address)) {
+                auto connection_rejecter = [=]() -> boost::asio::awaitable<void> { co_await new_connection->reject(); };
+                boost::asio::co_spawn(*io_context, connection_rejecter, boost::asio::detached);
+                continue;
+            }
+
             new_connection->socket().set_option(boost::asio::ip::tcp::socket::keep_alive(true));
 
             SILKRPC_TRACE << "Server::run starting connection for socket: " << &new_connection->socket() << "\n";
             auto new_connection_starter = [=]() -> boost::asio::awaitable<void> { co_await new_connection->start(); };
 
-            boost::asio::co_spawn(*io_context, new_connection_starter, [&](std::exception_ptr eptr) {
+            boost::asio::co_spawn(*io_context, new_connection_starter, [&, remote_address](std::exception_ptr eptr) {
+                if (policy_.admission_controller != nullptr) {
+                    policy_.admission_controller->close_connection(remote_address);
+                }
                 if (eptr) std::rethrow_exception(eptr);
             });
         }
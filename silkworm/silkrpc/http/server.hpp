@@ -46,7 +46,8 @@ public:
     Server& operator=(const Server&) = delete;
 
     // Construct the server to listen on the specified local TCP end-point
-    explicit Server(const std::string& end_point, const std::string& api_spec, Context& context, boost::asio::thread_pool& workers, std::optional<std::string> jwt_secret);
+    explicit Server(const std::string& end_point, const std::string& api_spec, Context& context, boost::asio::thread_pool& workers, std::optional<std::string> jwt_secret,
+                    const RequestPolicy& policy = {});
 
     void start();
 
@@ -68,6 +69,9 @@ private:
 
     boost::asio::thread_pool& workers_;
     std::optional<std::string> jwt_secret_;
+
+    // The policies applied to the requests, shared among servers
+    const RequestPolicy policy_;
 };
 
 } // namespace silkrpc::http
@@ -206,6 +206,25 @@ void to_json(nlohmann::json& json, const ChainTraffic& chain_traffic) {
     json["cumulativeTransactionsCount"] = to_quantity(chain_traffic.cumulative_transactions_count);
 }
 
+void to_json(nlohmann::json& json, const FeeHistory& fee_history) {
+    json["oldestBlock"] = to_quantity(fee_history.oldest_block);
+    json["baseFeePerGas"] = nlohmann::json::array();
+    for (const auto& base_fee : fee_history.base_fees) {
+        json["baseFeePerGas"].push_back(to_quantity(base_fee));
+    }
+    json["gasUsedRatio"] = fee_history.gas_used_ratio;
+    if (fee_history.rewards) {
+        json["reward"] = nlohmann::json::array();
+        for (const auto& block_rewards : *fee_history.rewards) {
+            auto rewards = nlohmann::json::array();
+            for (const auto& reward : block_rewards) {
+                rewards.push_back(to_quantity(reward));
+            }
+            json["reward"].push_back(rewards);
+        }
+    }
+}
+
 void to_json(nlohmann::json& json, const StageData& stage_data) {
     json["stage_name"] = stage_data.stage_name;
     json["block_number"] = stage_data.block_number;
@@ -298,6 +317,8 @@ void to_json(nlohmann::json& json, const Block& b) {
             json_txn["blockNumber"] = block_number;
             json_txn["gasPrice"] = silkrpc::to_quantity(b.block.transactions[i].effective_gas_price(b.block.header.base_fee_per_gas.value_or(0)));
         }
+    } else if (b.transaction_hashes) {
+        json["transactions"] = *b.transaction_hashes;
     } else {
         std::vector<evmc::bytes32> transaction_hashes;
         transaction_hashes.reserve(b.block.transactions.size());
@@ -31,6 +31,7 @@
 #include <silkworm/silkrpc/types/chain_traffic.hpp>
 #include <silkworm/silkrpc/types/error.hpp>
 #include <silkworm/silkrpc/types/execution_payload.hpp>
+#include <silkworm/silkrpc/types/fee_history.hpp>
 #include <silkworm/silkrpc/types/filter.hpp>
 #include <silkworm/silkrpc/types/issuance.hpp>
 #include <silkworm/silkrpc/types/log.hpp>
@@ -75,6 +76,8 @@ void to_json(nlohmann::json& json, const struct NodeInfoPorts& node_info_ports);
 
 void to_json(nlohmann::json& json, const struct ChainTraffic& chain_traffic);
 
+void to_json(nlohmann::json& json, const FeeHistory& fee_history);
+
 void to_json(nlohmann::json& json, const struct TxPoolStatusInfo& status_info);
 
 void to_json(nlohmann::json& json, const AccessListResult& access_list_result);
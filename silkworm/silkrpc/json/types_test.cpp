@@ -463,6 +463,18 @@ TEST_CASE("serialize EIP-2718 block", "[silkrpc][to_json]") {
     })"_json);
 }
 
+TEST_CASE("serialize block with known transaction hashes", "[silkrpc][to_json]") {
+    silkrpc::Block rpc_block;
+    rpc_block.block.transactions.resize(1);
+    rpc_block.transaction_hashes = std::make_shared<std::vector<evmc::bytes32>>(std::vector<evmc::bytes32>{
+        0x77b19baa4de67e45a7b26e4a220bccdbb6731885aa9927064e239ca232023215_bytes32});
+
+    nlohmann::json rpc_block_json = rpc_block;
+    CHECK(rpc_block_json["transactions"] == R"([
+        "0x77b19baa4de67e45a7b26e4a220bccdbb6731885aa9927064e239ca232023215"
+    ])"_json);
+}
+
 TEST_CASE("serialize block with hydrated transactions", "[silkrpc][to_json]") {
     // 1) build block https://goerli.etherscan.io/block/3529604
     // 1.1) value from table Header for key 000000000035db84
@@ -1506,6 +1518,28 @@ TEST_CASE("serialize chain_traffic", "[silkrpc::json][to_json]") {
     })"_json);
 }
 
+TEST_CASE("serialize fee_history", "[silkrpc::json][to_json]") {
+    SECTION("without rewards") {
+        silkrpc::FeeHistory fee_history{0x10, {7, 8, 9}, {0.5, 0.25}};
+        nlohmann::json j = fee_history;
+        CHECK(j == R"({
+            "oldestBlock":"0x10",
+            "baseFeePerGas":["0x7","0x8","0x9"],
+            "gasUsedRatio":[0.5,0.25]
+        })"_json);
+    }
+    SECTION("with rewards") {
+        silkrpc::FeeHistory fee_history{0x10, {7, 8}, {0.5}, std::vector<std::vector<intx::uint256>>{{1, 2}}};
+        nlohmann::json j = fee_history;
+        CHECK(j == R"({
+            "oldestBlock":"0x10",
+            "baseFeePerGas":["0x7","0x8"],
+            "gasUsedRatio":[0.5],
+            "reward":[["0x1","0x2"]]
+        })"_json);
+    }
+}
+
 TEST_CASE("serialize NodeInfoPorts", "[silkrpc::json][to_json]") {
     silkrpc::NodeInfoPorts ports{6, 7};
     nlohmann::json j = ports;
@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include <intx/intx.hpp>
 
@@ -31,6 +32,8 @@ namespace silkrpc {
 struct Block : public silkworm::BlockWithHash {
     intx::uint256 total_difficulty{0};
     bool full_tx{false};
+    //! Transaction hashes already available for the block, computed on serialization if missing
+    std::shared_ptr<const std::vector<evmc::bytes32>> transaction_hashes;
 
     [[nodiscard]] uint64_t get_block_size() const;
 };